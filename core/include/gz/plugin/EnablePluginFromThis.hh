@@ -64,6 +64,9 @@ namespace gz
       /// Factory plugins, so we keep it protected. Only use this if you know
       /// what you are doing.
       ///
+      /// Unlike PluginFromThis(), this does not need to make a PluginPtr, so
+      /// it never allocates.
+      ///
       /// \return shared_ptr to the Plugin instance.
       protected: std::shared_ptr<void> PluginInstancePtrFromThis() const;
 
@@ -18,12 +18,17 @@
 #ifndef GZ_PLUGIN_FACTORY_HH_
 #define GZ_PLUGIN_FACTORY_HH_
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <gz/plugin/EnablePluginFromThis.hh>
+#include <gz/plugin/detail/ProductRecycler.hh>
 
 namespace gz
 {
@@ -35,6 +40,12 @@ namespace gz
     /// then this just performs a normal delete.
     template <typename Interface> class ProductDeleter;
 
+    namespace detail
+    {
+      // Forward declaration
+      class FactoryCounter;
+    }
+
     /// \brief ProductPtr is a derivative of std::unique_ptr that can safely
     /// manage the products that come out of a plugin factory. It is strongly
     /// recommended that factory products use a ProductPtr to manage the
@@ -84,12 +95,65 @@ namespace gz
       /// the template parameters.
       public: ProductPtrType Construct(Args&&... _args);
 
+      /// \brief Construct several products from the same arguments. This is
+      /// cheaper than calling Construct(~) that many times, because the
+      /// reference to this factory is only looked up once.
+      /// \param[in] _count
+      ///   The number of products to construct
+      /// \param[in] _args
+      ///   The arguments as defined by the template parameters, passed the
+      ///   same way as to Construct(~). Arguments that are not lvalue
+      ///   references are copied for each product.
+      /// \return the products, in the order that they were constructed
+      public: std::vector<ProductPtrType> ConstructMany(
+          std::size_t _count, Args&&... _args);
+
+      /// \brief Keep the storage of products that get deleted by a
+      /// ProductDeleter, and construct later products in it instead of
+      /// allocating new storage. Products are not recycled by default.
+      ///
+      /// A product that was constructed while recycling was turned on may
+      /// still be released and deleted normally.
+      ///
+      /// \param[in] _capacity
+      ///   The largest number of products whose storage is kept. If this is
+      ///   zero, recycling is turned off, and the kept storage is freed.
+      public: void RecycleProducts(std::size_t _capacity);
+
+      /// \brief Get the number of products whose storage is waiting to be
+      /// reused.
+      /// \return The number of recycled products that are waiting
+      public: std::size_t RecycledProductCount() const;
+
       /// \internal \brief This function gets implemented by Producing<Product>
       /// to manufacture the product instance.
+      /// \param[out] _counter
+      ///   The part of the product which holds its factory reference
+      /// \param[in] _storage
+      ///   Storage from the recycler to construct the product in, or a nullptr
+      ///   to allocate the product
       /// \param[in] _args
       ///   The arguments as defined by the template parameters
       /// \return a raw pointer to the product
-      private: virtual Interface *ImplConstruct(Args&&... _args) = 0;
+      private: virtual Interface *ImplConstruct(
+          detail::FactoryCounter *&_counter, void *_storage,
+          Args&&... _args) = 0;
+
+      /// \brief Keeps the storage of deleted products. It is created by the
+      /// first call to RecycleProducts(~) that turns recycling on, and it is
+      /// never replaced afterwards, so that constructing a product only needs
+      /// to load this pointer. The recycled products share it, so that it
+      /// outlives this factory for as long as they need it.
+      private: std::atomic<detail::ProductRecycler*> recycler{nullptr};
+
+      /// \brief The reference of this factory to `recycler`
+      private: std::shared_ptr<detail::ProductRecycler> recyclerOwner;
+
+      /// \brief The size of the products, or zero if they cannot be recycled
+      private: std::size_t productSize = 0;
+
+      /// \brief The alignment of the products
+      private: std::size_t productAlignment = 0;
 
       /// \private This nested class is used to implement the plugin factory.
       /// It is not intended for external use.
@@ -130,8 +194,9 @@ namespace gz
     ///   destructors before we unload their libraries. If you can reliably
     ///   predict a window of time in which no products are actively being
     ///   destructed (or if you have a single-threaded application), then it is
-    ///   okay to set this waiting time to 0. Note that any threads which are
-    ///   about to destruct a product will be blocked until this wait is over.
+    ///   okay to set this waiting time to 0. Products that are lost while
+    ///   this function waits are not blocked; they will be cleaned up by the
+    ///   next call.
     void GZ_PLUGIN_VISIBLE CleanupLostProducts(
         const std::chrono::nanoseconds &_safetyWait =
             std::chrono::nanoseconds(5));
@@ -140,6 +205,63 @@ namespace gz
     /// since the last time CleanupLostProducts() was called (or since the
     /// program began, if CleanupLostProducts() has not been called yet).
     std::size_t GZ_PLUGIN_VISIBLE LostProductCount();
+
+    /// \brief Counters of the products that were lost, i.e. destructed without
+    /// a ProductDeleter, and of the cleanup of their factory references.
+    struct LostProductStats
+    {
+      /// \brief Number of lost products whose factory references are waiting
+      /// to be cleaned up. This is the same as LostProductCount().
+      std::size_t depth = 0;
+
+      /// \brief Number of products that were lost since the program began
+      std::size_t lost = 0;
+
+      /// \brief Number of factory references of lost products that were
+      /// cleaned up since the program began
+      std::size_t reclaimed = 0;
+
+      /// \brief The longest time from a product being lost until its factory
+      /// reference was cleaned up, among the products that were cleaned up by
+      /// the most recent cleanup
+      std::chrono::nanoseconds lastReclaimLatency{0};
+
+      /// \brief The longest time from a product being lost until its factory
+      /// reference was cleaned up
+      std::chrono::nanoseconds maxReclaimLatency{0};
+    };
+
+    /// \brief Get the counters of the lost products.
+    /// \return The current counters
+    LostProductStats GZ_PLUGIN_VISIBLE LostProductStatistics();
+
+    /// \brief Start a background thread which calls CleanupLostProducts()
+    /// periodically, so that the libraries of lost products get unloaded
+    /// without the application having to call it. If the thread is already
+    /// running, the new schedule takes effect right away.
+    ///
+    /// The same warnings as for CleanupLostProducts() apply: this is only
+    /// safe if products which are being destructed on other threads always
+    /// exit their destructors within _safetyWait.
+    ///
+    /// \param[in] _period
+    ///   How long the thread waits between cleanups
+    /// \param[in] _safetyWait
+    ///   The safety wait that is passed to CleanupLostProducts()
+    void GZ_PLUGIN_VISIBLE StartLostProductReaper(
+        const std::chrono::nanoseconds &_period,
+        const std::chrono::nanoseconds &_safetyWait =
+            std::chrono::nanoseconds(5));
+
+    /// \brief Stop the thread that was started by StartLostProductReaper(~).
+    /// The factory references which are still waiting are kept until the next
+    /// cleanup. This does nothing if the thread is not running.
+    ///
+    /// This may also be called by the thread itself, e.g. from a static
+    /// destructor of a library that gets unloaded by one of its cleanups. In
+    /// that case the thread stops once that cleanup is done, without this
+    /// function waiting for it.
+    void GZ_PLUGIN_VISIBLE StopLostProductReaper();
   }
 }
 
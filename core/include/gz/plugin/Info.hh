@@ -19,6 +19,7 @@
 #ifndef GZ_PLUGIN_INFO_HH_
 #define GZ_PLUGIN_INFO_HH_
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <set>
@@ -34,19 +35,106 @@ namespace gz
   namespace plugin
   {
     /// \brief sentinel value to check if a plugin was built with the same
-    /// version of the Info struct
+    /// version of the Info API
     //
-    /// This must be incremented when the Info struct changes
-    const int INFO_API_VERSION = 1;
-
-    // We use an inline namespace to assist in forward-compatibility. Eventually
-    // we may want to support a version-2 of the Info API, in which case
-    // we will remove the "inline" declaration here, and create a new inline
-    // namespace called "v2". This original Info object will continue to
-    // be accessible for backwards compatibility, and even its symbol name in
-    // the ABI should remain the same.
+    /// This must be incremented when the way that a library hands its plugins
+    /// to the Loader changes. Since version 2, a library describes its plugins
+    /// with the plain tables of gz/plugin/detail/PluginDescriptor.hh, and the
+    /// Loader builds its own Info from them.
+    const int INFO_API_VERSION = 2;
+
+    /// \brief The version of the Info API in which a library hands an InfoMap
+    /// to the Loader. The Loader still accepts libraries that were built
+    /// against it, except for their factory plugins, whose virtual functions
+    /// have changed since. Libraries still provide it to older Loaders.
+    const int INFO_MAP_API_VERSION = 1;
+
+    // We use an inline namespace to assist in forward-compatibility. If the
+    // Info struct itself ever needs to change, we will remove the "inline"
+    // declaration here, and create a new inline namespace called "v3". This
+    // original Info object will continue to be accessible for backwards
+    // compatibility, and even its symbol name in the ABI should remain the
+    // same.
     inline namespace v1
     {
+      /// \brief Casts a plugin instance to one of its interfaces by moving
+      /// the pointer by a fixed offset. The interfaces of a plugin which are
+      /// not virtual bases are always found at the same offset within its
+      /// instances, so the casting functions in Info::interfaces hold one of
+      /// these for them. The Loader recognizes it and applies the offset
+      /// directly instead of calling through the std::function.
+      struct InterfaceOffset
+      {
+        /// \brief Apply the offset to a plugin instance
+        /// \param[in] _instance Pointer to the plugin instance
+        /// \return Pointer to the interface within the plugin instance
+        void *operator()(void *_instance) const
+        {
+          return static_cast<char*>(_instance) + offset;
+        }
+
+        /// \brief Distance in bytes from the start of the plugin instance to
+        /// the interface
+        std::ptrdiff_t offset;
+      };
+
+      /// \brief Describes how the instances of a plugin class are laid out in
+      /// memory, and how to construct and destroy one in storage that the
+      /// caller provides. The Loader uses this to put a plugin instance in the
+      /// same allocation as its bookkeeping.
+      struct InstanceLayout
+      {
+        /// \brief sizeof the plugin class
+        std::size_t size;
+
+        /// \brief alignof the plugin class
+        std::size_t alignment;
+
+        /// \brief Allocate and construct a new instance, just like a factory
+        /// that is not an InstanceFactory would.
+        void *(*create)();
+
+        /// \brief Construct an instance in the given storage, which must be
+        /// at least `size` bytes and aligned to `alignment`.
+        void *(*construct)(void *_storage);
+
+        /// \brief Destroy an instance that was made by `construct` without
+        /// releasing its storage.
+        void (*destroy)(void *_instance);
+      };
+
+      /// \brief Creates new instances of a plugin. The factories in Info hold
+      /// one of these for plugins whose instances may be constructed in
+      /// storage that the Loader provides. The Loader recognizes it and uses
+      /// its layout instead of calling through the std::function.
+      struct InstanceFactory
+      {
+        /// \brief Allocate and construct a new instance
+        /// \return Pointer to the plugin instance
+        void *operator()() const
+        {
+          return describe().create();
+        }
+
+        /// \brief Get the layout of the plugin class.
+        ///
+        /// Dev note: The layout is returned by value instead of being kept in
+        /// a static object, because glibc would never unload a plugin library
+        /// that has a static data member of a template in it.
+        InstanceLayout (*describe)();
+      };
+
+      /// \brief Marks a plugin whose instance may be shared by all of its
+      /// users. It is listed among the interfaces of plugins that were
+      /// registered with GZ_ADD_PLUGIN_SHARED or GZ_ADD_STATIC_PLUGIN_SHARED,
+      /// and the Loader then hands out PluginPtrs to one instance of the
+      /// plugin instead of constructing a new instance each time. It is not
+      /// a base class of the plugin, so it is never reported or found as an
+      /// interface; use Loader::ResolvedPlugin::IsShared() to check for it.
+      struct SharedInstance
+      {
+      };
+
       /// \brief Holds info required to construct a plugin
       struct GZ_PLUGIN_VISIBLE Info
       {
@@ -67,7 +155,8 @@ namespace gz
         /// plugin provides. The values are functions that convert a void
         /// pointer (which actually points to the plugin instance) to another
         /// void pointer (which actually points to the location of the interface
-        /// within the plugin instance).
+        /// within the plugin instance). For most interfaces, the function is
+        /// an InterfaceOffset.
         GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
         using InterfaceCastingMap =
             std::unordered_map< std::string, std::function<void*(void*)> >;
@@ -83,7 +172,8 @@ namespace gz
         std::set<std::string> demangledInterfaces;
         GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
 
-        /// \brief A method that instantiates a new instance of a plugin
+        /// \brief A method that instantiates a new instance of a plugin. For
+        /// most plugins, this is an InstanceFactory.
         GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
         std::function<void*()> factory;
         GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
@@ -20,13 +20,17 @@
 #define GZ_PLUGIN_PLUGIN_HH_
 
 #include <memory>
+#include <memory_resource>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <gz/utils/SuppressWarning.hh>
 
 #include <gz/plugin/Export.hh>
 #include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/InterfaceTable.hh>
+#include <gz/plugin/utility.hh>
 
 namespace gz
 {
@@ -38,6 +42,7 @@ namespace gz
       template <class> class SelectSpecializers;
     }
     class EnablePluginFromThis;
+    class Loader;
     class WeakPluginPtr;
 
     class GZ_PLUGIN_VISIBLE Plugin
@@ -125,6 +130,7 @@ namespace gz
       template <class, class> friend class detail::ComposePlugin;
       template <class> friend class detail::SelectSpecializers;
       friend class EnablePluginFromThis;
+      friend class Loader;
       friend class WeakPluginPtr;
 
       /// \brief Default constructor. This is kept protected to discourage users
@@ -136,34 +142,81 @@ namespace gz
       private: void *PrivateQueryInterface(
                   const std::string &_interfaceName) const;
 
+      /// \brief Type-agnostic retriever for interfaces whose ID is already
+      /// known
+      /// \param[in] _interfaceName The mangled name of the interface
+      /// \param[in] _id The registered ID of the interface
+      private: void *PrivateQueryInterface(
+                  const char *_interfaceName,
+                  const InterfaceId &_id) const;
+
       /// \brief Copy the plugin instance from another Plugin object
       private: void PrivateCopyPluginInstance(const Plugin &_other) const;
 
       /// \brief Copy an existing plugin instance into this plugin
-      /// \param[in] _info
-      ///   Pointer to the Info for this plugin
+      /// \param[in] _table
+      ///   The interface table of this plugin
       /// \param[in] _instancePtr
       ///   Pointer to an already-existing abstract plugin instance pointer
       private: void PrivateCopyPluginInstance(
-                  const ConstInfoPtr &_info,
+                  const detail::ConstInterfaceTablePtr &_table,
                   const std::shared_ptr<void> &_instancePtr) const;
 
       /// \brief Create a new plugin instance based on the info provided
-      /// \param[in] _info
-      ///   Pointer to the Info for this plugin
+      /// \param[in] _table
+      ///   The interface table made from the Info of this plugin
       /// \param[in] _dlHandlePtr
       ///   Reference counter for the dl handle of this Plugin
+      /// \param[in] _resource
+      ///   The memory resource to allocate the instance from, or a nullptr to
+      ///   use operator new
       private: void PrivateCreatePluginInstance(
-                  const ConstInfoPtr &_info,
-                  const std::shared_ptr<void> &_dlHandlePtr) const;
+                  const detail::ConstInterfaceTablePtr &_table,
+                  const std::shared_ptr<void> &_dlHandlePtr,
+                  std::pmr::memory_resource *_resource) const;
 
       /// \brief Create a new plugin instance based on the info provided for a
       /// plugin from the static plugin loader registry.
-      /// \param[in] _info
-      ///   Pointer to the Info for this plugin
+      /// \param[in] _table
+      ///   The interface table made from the Info of this plugin
+      /// \param[in] _resource
+      ///   The memory resource to allocate the instance from, or a nullptr to
+      ///   use operator new
       private: void PrivateCreateStaticPluginInstance(
-                  const ConstInfoPtr &_info) const;
+                  const detail::ConstInterfaceTablePtr &_table,
+                  std::pmr::memory_resource *_resource) const;
+
 
+      /// \brief Create several instances of a plugin at once. Where the
+      /// plugin allows it, the instances are placed next to each other in a
+      /// single allocation which holds one reference to the shared library.
+      /// \param[in] _table
+      ///   The interface table made from the Info of the plugin
+      /// \param[in] _dlHandlePtr
+      ///   Reference counter for the dl handle of the plugin, or a nullptr for
+      ///   a plugin from the static plugin registry
+      /// \param[in] _count
+      ///   The number of instances to create
+      /// \return The abstract instances, which are ready to be copied into
+      /// Plugin wrappers with PrivateCopyPluginInstance(~)
+      private: static std::vector<std::shared_ptr<void>>
+      PrivateCreatePluginInstances(
+          const detail::ConstInterfaceTablePtr &_table,
+          const std::shared_ptr<void> &_dlHandlePtr,
+          std::size_t _count);
+
+      /// \brief Create a new plugin instance which is not held by any Plugin
+      /// wrapper yet.
+      /// \param[in] _table
+      ///   The interface table made from the Info of the plugin
+      /// \param[in] _dlHandlePtr
+      ///   Reference counter for the dl handle of the plugin, or a nullptr for
+      ///   a plugin from the static plugin registry
+      /// \return The abstract instance, which is ready to be copied into
+      /// Plugin wrappers with PrivateCopyPluginInstance(~)
+      private: static std::shared_ptr<void> PrivateCreateDetachedInstance(
+          const detail::ConstInterfaceTablePtr &_table,
+          const std::shared_ptr<void> &_dlHandlePtr);
 
       /// \brief Get a reference to the abstract instance being managed by this
       /// wrapper
@@ -172,17 +225,36 @@ namespace gz
       /// \brief Get a reference to the Info being used by this wrapper
       private: const ConstInfoPtr &PrivateGetInfoPtr() const;
 
-      /// \brief The InterfaceMap type needs to get used in several places, like
-      /// Plugin::Implementation and SpecializedPlugin<T>. We make the typedef
-      /// public so that those other classes can use it without needing to be
-      /// friends of Plugin. End-users should not have any need for this
-      /// typedef.
-      public: using InterfaceMap = std::map<std::string, void*>;
-
-      /// \brief Get or create an iterator to the std::map that holds pointers
-      /// to the various interfaces provided by this plugin instance.
-      private: InterfaceMap::iterator PrivateGetOrCreateIterator(
-          const std::string &_interfaceName);
+      /// \brief Get a reference to the interface table being used by this
+      /// wrapper
+      private: const detail::ConstInterfaceTablePtr &
+      PrivateGetInterfaceTable() const;
+
+      /// \brief Direct access to an interface which a SpecializedPlugin
+      /// anticipates at compile time. The slot lives inside of the
+      /// SpecializedPlugin, and this Plugin keeps it pointed at the interface
+      /// of its current instance. End-users should not have any need for
+      /// this type.
+      public: struct SpecializedSlot
+      {
+        /// \brief The mangled name of the interface
+        const char *name;
+
+        /// \brief The registered ID of the interface
+        const InterfaceId *id;
+
+        /// \brief The interface within the current instance, or a nullptr if
+        /// the plugin does not provide it
+        void *ptr;
+
+        /// \brief The next slot of this Plugin
+        SpecializedSlot *next;
+      };
+
+      /// \brief Start keeping a slot pointed at the interface that it names.
+      /// The slot must live for as long as this Plugin does.
+      /// \param[in] _slot The slot of a SpecializedPlugin
+      private: void PrivateAddSpecializedSlot(SpecializedSlot &_slot);
 
       class Implementation;
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
@@ -22,6 +22,8 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <vector>
 
 #include <gz/plugin/Plugin.hh>
 
@@ -42,6 +44,12 @@ namespace gz
     /// it are either destroyed, cleared, or begin referring to a different
     /// plugin instance.
     ///
+    /// Copies of a PluginPtr share one Plugin wrapper, so copying a PluginPtr
+    /// costs about as much as copying a std::shared_ptr, and it never
+    /// allocates. The same goes for converting to a PluginPtr type whose
+    /// Plugin wrapper is a base of this one, e.g. from a SpecializedPluginPtr
+    /// to a PluginPtr, or from a PluginPtr to a ConstPluginPtr.
+    ///
     /// A PluginPtr object can be "cast" to a SpecializedPluginPtr object by
     /// simply using the copy/move constructor or assignment operator of a
     /// SpecializedPluginPtr object. Note that this "cast" does have a small
@@ -189,28 +197,91 @@ namespace gz
       /// available any longer.
       public: void Clear();
 
+      /// \brief Make a new plugin wrapper with no plugin instance
+      /// \param[in] _resource The memory resource to allocate the wrapper
+      /// from, or a nullptr to use operator new
+      /// \return The new plugin wrapper
+      private: static std::shared_ptr<PluginType> PrivateMakeWrapper(
+          std::pmr::memory_resource *_resource = nullptr);
+
+      /// \brief Get the plugin wrapper shared by every empty PluginPtr of this
+      /// type. It never gets modified.
+      /// \return The empty plugin wrapper
+      private: static const std::shared_ptr<PluginType> &PrivateEmptyWrapper();
+
+      /// \brief Create several instances of a plugin at once, each in its own
+      /// PluginPtr. This should only be called by Loader.
+      /// \param[in] _table The interface table that the Loader made from the
+      /// Info of the plugin
+      /// \param[in] _dlHandlePtr A reference count for the DL handle, or a
+      /// nullptr for a plugin from the static registry
+      /// \param[in] _count The number of instances to create
+      /// \return The new PluginPtrs
+      private: static std::vector<TemplatePluginPtr> PrivateMakeMany(
+          const detail::ConstInterfaceTablePtr &_table,
+          const std::shared_ptr<void> &_dlHandlePtr,
+          std::size_t _count);
+
+      /// \brief Make a PluginPtr for a plugin instance that already exists.
+      /// This should only be called by Loader.
+      /// \param[in] _table The interface table that the Loader made from the
+      /// Info of the plugin
+      /// \param[in] _instancePtr The abstract plugin instance
+      /// \return The new PluginPtr
+      private: static TemplatePluginPtr PrivateMakeFromInstance(
+          const detail::ConstInterfaceTablePtr &_table,
+          const std::shared_ptr<void> &_instancePtr);
+
+      /// \brief Get a plugin wrapper of this type for the plugin instance of
+      /// another PluginPtr. If the wrapper of _other is also a PluginType,
+      /// then it gets shared instead of copied.
+      /// \param[in] _other The PluginPtr to get the plugin instance from
+      /// \return The plugin wrapper for this PluginPtr
+      private: template <typename OtherPluginType>
+      static std::shared_ptr<PluginType> PrivateShareWrapper(
+          const TemplatePluginPtr<OtherPluginType> &_other);
+
       /// \brief Pointer to the plugin wrapper that this PluginPtr is managing.
-      private: std::unique_ptr<PluginType> dataPtr;
+      /// The wrapper may be shared with other PluginPtrs, so it must not be
+      /// modified once it has been given a plugin instance.
+      private: std::shared_ptr<PluginType> dataPtr;
 
       // Declare friendship
       friend class Loader;
+      friend class WeakPluginPtr;
       template <class> friend class TemplatePluginPtr;
 
       /// \brief Private constructor. Creates a plugin instance based on the
       /// Info provided. This should only be called by Loader to ensure that
       /// the Info is well-formed, so we keep it private.
-      /// \param[in] _info An Info instance that was generated by
-      /// Loader. Alternatively, this can take a nullptr to create an
-      /// empty PluginPtr.
+      /// \param[in] _table The interface table that the Loader made from the
+      /// Info of the plugin. Alternatively, this can take a nullptr to create
+      /// an empty PluginPtr.
       /// \param[in] _dlHandlePtr A reference count for the DL handle.
+      /// \param[in] _resource The memory resource to allocate the plugin
+      /// instance and its bookkeeping from, or a nullptr to use operator new
       private: explicit TemplatePluginPtr(
-          const ConstInfoPtr &_info,
-          const std::shared_ptr<void> &_dlHandlePtr);
+          const detail::ConstInterfaceTablePtr &_table,
+          const std::shared_ptr<void> &_dlHandlePtr,
+          std::pmr::memory_resource *_resource = nullptr);
 
       /// \brief Private constructor. Used by the Loader to instantiate a
       /// plugin class from the static registry.
-      /// \param[in] _info An Info instance that was generated by Loader.
-      private: explicit TemplatePluginPtr(const ConstInfoPtr &_info);
+      /// \param[in] _table The interface table that the Loader made from the
+      /// Info of the plugin.
+      /// \param[in] _resource The memory resource to allocate the plugin
+      /// instance and its bookkeeping from, or a nullptr to use operator new
+      private: explicit TemplatePluginPtr(
+          const detail::ConstInterfaceTablePtr &_table,
+          std::pmr::memory_resource *_resource = nullptr);
+
+      /// \brief Private constructor. Takes over a plugin wrapper without
+      /// getting the empty wrapper first. That wrapper is a function-local
+      /// static, so each shared library that makes an empty PluginPtr makes
+      /// its own copy the first time.
+      /// \param[in] _wrapper The plugin wrapper
+      private: explicit TemplatePluginPtr(
+          std::shared_ptr<PluginType> &&_wrapper);
     };
 
     /// \brief Typical usage for TemplatePluginPtr is to just hold a generic
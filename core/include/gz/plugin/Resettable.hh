@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PLUGIN_RESETTABLE_HH_
+#define GZ_PLUGIN_RESETTABLE_HH_
+
+namespace gz
+{
+  namespace plugin
+  {
+    /// \brief Resettable is an optional interface for plugins whose instances
+    /// may be reused. When an instance of a plugin that provides this
+    /// interface was handed out by an instance pool of the Loader (see
+    /// Loader::WarmPool(~)), the pool calls Reset() once the last PluginPtr
+    /// of the instance is gone, and keeps the instance for the next call to
+    /// Instantiate(~) instead of deleting it. Instances of plugins that do
+    /// not provide this interface are always deleted.
+    ///
+    /// Like any other interface, it must be listed when the plugin is
+    /// registered, e.g. `GZ_ADD_PLUGIN(MyPlugin, gz::plugin::Resettable)`.
+    class Resettable
+    {
+      /// \brief Put this instance back into the state of a newly constructed
+      /// instance. This is called without any PluginPtr referring to the
+      /// instance, while the last of them is being destroyed, so it must not
+      /// throw. If it throws anyway, the exception is swallowed and the
+      /// instance gets deleted instead of being reused.
+      ///
+      /// \return True if the instance may be handed out again, or false if it
+      /// should be deleted instead.
+      public: virtual bool Reset() = 0;
+
+      /// \brief Virtual destructor
+      public: virtual ~Resettable() = default;
+    };
+  }
+}
+
+#endif
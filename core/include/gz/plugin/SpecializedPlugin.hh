@@ -146,13 +146,12 @@ namespace gz
       /// \return True if the interface is present.
       private: bool PrivateHasInterface(type<SpecInterface>) const;
 
-      // Dev note (MXG): The privateSpecializedInterfaceIterator object must be
-      // available to the user during their compile time, so it cannot be hidden
-      // using PIMPL. The iterator is const because it must always point to the
-      // same entry throughout its entire lifecycle.
-      /// \brief Iterator that points to the entry of the specialized interface
-      private:
-      const Plugin::InterfaceMap::iterator privateSpecializedInterfaceIterator;
+      // Dev note (MXG): The privateSpecializedSlot object must be available
+      // to the user during their compile time, so it cannot be hidden using
+      // PIMPL. The Plugin keeps it pointed at the specialized interface of its
+      // current instance.
+      /// \brief Slot which holds the specialized interface
+      private: Plugin::SpecializedSlot privateSpecializedSlot;
 
       /// \brief Default constructor
       protected: SpecializedPlugin();
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <gz/utils/SuppressWarning.hh>
 
@@ -43,8 +44,17 @@ namespace gz
         GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
         /// \brief A reference to the factory that created this product
         private: std::shared_ptr<void> factoryPluginInstancePtr;
+
+        /// \brief Keeps `recycler` alive if the factory is not managed by a
+        /// plugin instance, i.e. if `factoryPluginInstancePtr` cannot keep
+        /// the factory and its recycler alive.
+        private: std::shared_ptr<ProductRecycler> recyclerOwner;
         GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
 
+        /// \brief The recycler of the factory, if this product should be
+        /// recycled when it gets deleted by a ProductDeleter
+        private: ProductRecycler *recycler = nullptr;
+
         /// \brief A special destructor that ensures the shared library remains
         /// loaded throughout the destruction process of this product.
         public: virtual ~FactoryCounter();
@@ -65,11 +75,17 @@ namespace gz
       /// This is the recommended method for deleting product pointers.
       public: void operator()(Interface *_ptr)
       {
-        detail::FactoryCounter *counter =
+        // Dev note: The factory reference is always found through the
+        // product itself. A deleter that remembered it could not tell when its
+        // ProductPtr has been released and then reset to a different product
+        // at the same address.
+        detail::FactoryCounter *productCounter =
             dynamic_cast<detail::FactoryCounter*>(_ptr);
 
         std::shared_ptr<void> factoryPluginInstancePtr;
-        if (counter)
+        std::shared_ptr<detail::ProductRecycler> recyclerOwner;
+        detail::ProductRecycler *recycler = nullptr;
+        if (productCounter)
         {
           // Hold onto the factory instance pointer while the product completes
           // its destruction.
@@ -78,7 +94,21 @@ namespace gz
           // so that it knows that it's being deleted by a ProductDeleter.
           // Otherwise, it will intentionally leak its factory reference to
           // avoid causing a segmentation fault in the application.
-          factoryPluginInstancePtr.swap(counter->factoryPluginInstancePtr);
+          factoryPluginInstancePtr.swap(
+                productCounter->factoryPluginInstancePtr);
+          recyclerOwner.swap(productCounter->recyclerOwner);
+          recycler = productCounter->recycler;
+        }
+
+        if (recycler)
+        {
+          // Dev note: `recyclerOwner` is declared after the factory reference,
+          // so it gets released while the library of the factory is still
+          // loaded.
+          void *const storage = dynamic_cast<void*>(productCounter);
+          _ptr->~Interface();
+          recycler->Release(storage);
+          return;
         }
 
         delete _ptr;
@@ -89,7 +119,128 @@ namespace gz
     auto Factory<Interface, Args...>::Construct(Args&&... _args)
         -> ProductPtrType
     {
-      return ProductPtrType(this->ImplConstruct(std::forward<Args>(_args)...));
+      detail::ProductRecycler *const productRecycler =
+          this->recycler.load(std::memory_order_acquire);
+      void *const storage = productRecycler && productRecycler->Enabled() ?
+          productRecycler->Allocate() : nullptr;
+
+      detail::FactoryCounter *counter = nullptr;
+      Interface *product = nullptr;
+      try
+      {
+        product = this->ImplConstruct(
+              counter, storage, std::forward<Args>(_args)...);
+      }
+      catch (...)
+      {
+        if (storage)
+          productRecycler->Release(storage);
+        throw;
+      }
+
+      counter->factoryPluginInstancePtr = this->PluginInstancePtrFromThis();
+      if (storage)
+      {
+        // The reference to the factory keeps its recycler alive, unless the
+        // factory is not managed by a plugin instance.
+        counter->recycler = productRecycler;
+        if (!counter->factoryPluginInstancePtr)
+          counter->recyclerOwner = productRecycler->shared_from_this();
+      }
+
+      return ProductPtrType(product);
+    }
+
+    template <typename Interface, typename... Args>
+    auto Factory<Interface, Args...>::ConstructMany(
+        const std::size_t _count, Args&&... _args)
+        -> std::vector<ProductPtrType>
+    {
+      // Every product shares the same reference to this factory
+      const std::shared_ptr<void> factory = this->PluginInstancePtrFromThis();
+
+      // The storage of all the products is taken from the recycler at once
+      detail::ProductRecycler *const productRecycler =
+          this->recycler.load(std::memory_order_acquire);
+      std::shared_ptr<detail::ProductRecycler> sharedRecycler;
+      std::vector<void*> storage;
+      if (_count > 0 && productRecycler && productRecycler->Enabled())
+      {
+        if (!factory)
+          sharedRecycler = productRecycler->shared_from_this();
+        productRecycler->AllocateMany(_count, storage);
+      }
+
+      std::vector<ProductPtrType> products;
+      products.reserve(_count);
+      std::size_t i = 0;
+      try
+      {
+        for (; i < _count; ++i)
+        {
+          void *const block = storage.empty() ? nullptr : storage[i];
+
+          detail::FactoryCounter *counter = nullptr;
+          Interface *product = this->ImplConstruct(
+                counter, block,
+                static_cast<detail::CopiedArgument<Args>>(_args)...);
+
+          counter->factoryPluginInstancePtr = factory;
+          if (block)
+          {
+            counter->recycler = productRecycler;
+            counter->recyclerOwner = sharedRecycler;
+          }
+
+          products.emplace_back(product);
+        }
+      }
+      catch (...)
+      {
+        // The products that were constructed get recycled as they are
+        // deleted, and the storage of the others is given back here.
+        for (std::size_t j = i; j < storage.size(); ++j)
+          productRecycler->Release(storage[j]);
+        throw;
+      }
+
+      return products;
+    }
+
+    template <typename Interface, typename... Args>
+    void Factory<Interface, Args...>::RecycleProducts(
+        const std::size_t _capacity)
+    {
+      detail::ProductRecycler *current =
+          this->recycler.load(std::memory_order_acquire);
+      if (!current)
+      {
+        // Products which cannot be recycled never get a recycler
+        if (0 == _capacity || 0 == this->productSize)
+          return;
+
+        std::shared_ptr<detail::ProductRecycler> created =
+            std::make_shared<detail::ProductRecycler>(
+              this->productSize, this->productAlignment);
+
+        // Another thread might be turning recycling on at the same time
+        if (this->recycler.compare_exchange_strong(
+              current, created.get(), std::memory_order_acq_rel))
+        {
+          current = created.get();
+          this->recyclerOwner = std::move(created);
+        }
+      }
+
+      current->SetCapacity(_capacity);
+    }
+
+    template <typename Interface, typename... Args>
+    std::size_t Factory<Interface, Args...>::RecycledProductCount() const
+    {
+      const detail::ProductRecycler *const productRecycler =
+          this->recycler.load(std::memory_order_acquire);
+      return productRecycler ? productRecycler->Idle() : 0;
     }
 
     /// \brief Producing provides the implementation of Factory for a specific
@@ -131,14 +282,39 @@ namespace gz
         }
       };
 
+      /// \brief Default constructor. It tells the factory how to recycle the
+      /// storage of the products.
+      public: Producing()
+      {
+        if constexpr (detail::IsRecyclable<Product>::value)
+        {
+          this->productSize = sizeof(ProductWithFactoryCounter);
+          this->productAlignment = alignof(ProductWithFactoryCounter);
+        }
+      }
+
       // Documentation inherited
-      private: Interface *ImplConstruct(Args&&... _args) override
+      private: Interface *ImplConstruct(
+          detail::FactoryCounter *&_counter, void *_storage,
+          Args&&... _args) override
       {
-        auto *product =
-            new ProductWithFactoryCounter(std::forward<Args>(_args)...);
+        ProductWithFactoryCounter *product = nullptr;
+
+        // Dev note: Only products which are recyclable are ever given
+        // storage, because the factory only gets a recycler for those.
+        if constexpr (detail::IsRecyclable<Product>::value)
+        {
+          if (_storage)
+          {
+            product = ::new (_storage) ProductWithFactoryCounter(
+                  std::forward<Args>(_args)...);
+          }
+        }
 
-        product->factoryPluginInstancePtr = this->PluginInstancePtrFromThis();
+        if (!product)
+          product = new ProductWithFactoryCounter(std::forward<Args>(_args)...);
 
+        _counter = product;
         return product;
       }
     };
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PLUGIN_DETAIL_INTERFACETABLE_HH_
+#define GZ_PLUGIN_DETAIL_INTERFACETABLE_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include <gz/plugin/Export.hh>
+#include <gz/plugin/Info.hh>
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      /// \brief The interfaces of one plugin type, each with its location
+      /// relative to the start of a plugin instance. Every instance of the
+      /// plugin has its interfaces at the same locations, so one immutable
+      /// table gets shared by all of the instances, and a Plugin only needs
+      /// to hold the table and its instance. The Loader makes one table for
+      /// each Info that it registers.
+      class GZ_PLUGIN_VISIBLE InterfaceTable
+      {
+        /// \brief Constructor. This registers the IDs of all the interfaces
+        /// of the plugin.
+        /// \param[in] _info The Info of the plugin
+        public: explicit InterfaceTable(ConstInfoPtr _info);
+
+        /// \brief Get the Info that this table was made from
+        /// \return The Info of the plugin
+        public: const ConstInfoPtr &GetInfo() const;
+
+        /// \brief Get the layout of the plugin class, if its factory is an
+        /// InstanceFactory
+        /// \return The layout of the plugin class, or a nullptr if its
+        /// instances can only be made by calling the factory of its Info.
+        public: const InstanceLayout *GetLayout() const;
+
+        /// \brief Check whether the plugin was registered as shared, i.e.
+        /// whether its Info lists the SharedInstance marker
+        /// \return True if every user of this table should get the same
+        /// instance of the plugin
+        public: bool IsShared() const;
+
+        /// \brief Get the one instance of a shared plugin. The first call
+        /// creates it, and concurrent callers wait for it to be created. The
+        /// instance lives for as long as this table does.
+        /// \param[in] _create Creates the instance. It is called at most once,
+        /// unless it throws.
+        /// \return The shared instance
+        public: std::shared_ptr<void> GetSharedInstance(
+            const std::function<std::shared_ptr<void>()> &_create) const;
+
+        /// \brief Learn the locations of the interfaces that can only be
+        /// found through an instance of the plugin, i.e. the virtual bases of
+        /// the plugin class. This only does something the first time it is
+        /// called, so call it whenever a new instance has been created.
+        /// \param[in] _instance A new instance of the plugin
+        public: void Locate(void *_instance) const;
+
+        /// \brief Find an interface within an instance of the plugin
+        /// \param[in] _instance The instance of the plugin
+        /// \param[in] _interfaceName The mangled name of the interface
+        /// \param[in] _hash The result of HashInterfaceName(~) for
+        /// _interfaceName
+        /// \param[in] _ambiguous The flag of the registered ID of
+        /// _interfaceName, or a nullptr if the name might not be registered
+        /// \return The location of the interface, or a nullptr if the plugin
+        /// does not provide it.
+        public: void *Find(void *_instance,
+                           const char *_interfaceName,
+                           std::uint64_t _hash,
+                           const std::atomic<bool> *_ambiguous) const;
+
+        /// \brief Find an interface within an instance of the plugin by its
+        /// name alone
+        /// \param[in] _instance The instance of the plugin
+        /// \param[in] _interfaceName The mangled name of the interface
+        /// \return The location of the interface, or a nullptr if the plugin
+        /// does not provide it.
+        public: void *Find(void *_instance,
+                           const std::string &_interfaceName) const;
+
+        /// \brief An interface of the plugin
+        private: struct Entry
+        {
+          /// \brief Hash of the name of the interface
+          std::uint64_t hash;
+
+          /// \brief The name of the interface, owned by the Info
+          const std::string *name;
+
+          /// \brief The casting function of the interface, owned by the Info,
+          /// or a nullptr once `offset` is known.
+          const std::function<void*(void*)> *cast;
+
+          /// \brief Distance from the start of the instance to the interface
+          std::ptrdiff_t offset;
+        };
+
+        GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+        /// \brief The Info of the plugin. The entries point into it.
+        private: ConstInfoPtr info;
+
+        /// \brief The layout of the plugin class. Its functions are nullptrs
+        /// if the factory of the plugin is not an InstanceFactory.
+        private: InstanceLayout layout = {};
+
+        /// \brief The interfaces of the plugin, sorted by hash. The entries
+        /// of interfaces which are virtual bases are completed by Locate(~),
+        /// and they must not be used before that.
+        private: mutable std::vector<Entry> entries;
+
+        /// \brief Makes sure that Locate(~) only modifies the entries once
+        private: mutable std::once_flag located;
+
+        /// \brief The instance of a shared plugin, once it has been created.
+        /// It holds its own reference to the library of the plugin.
+        ///
+        /// CRUCIAL DEV NOTE: `sharedInstance` MUST come AFTER `info` so that
+        /// the instance gets destructed while its Info still exists.
+        private: mutable std::shared_ptr<void> sharedInstance;
+
+        /// \brief Makes sure that the shared instance is only created once
+        private: mutable std::once_flag sharedCreated;
+        GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+        /// \brief True if the Info of the plugin lists the SharedInstance
+        /// marker
+        private: bool shared = false;
+      };
+
+      /// \brief Shared pointer to an immutable InterfaceTable
+      using ConstInterfaceTablePtr = std::shared_ptr<const InterfaceTable>;
+
+      /// \brief Check whether an entry of Info::interfaces is the
+      /// SharedInstance marker. The marker only tells the Loader how to
+      /// instantiate the plugin, so it must not be reported as an interface.
+      /// \param[in] _interfaceName The mangled name of the entry
+      /// \return True if the entry is the marker
+      inline bool IsSharedInstanceMarker(const std::string &_interfaceName)
+      {
+        return _interfaceName == typeid(SharedInstance).name();
+      }
+    }
+  }
+}
+
+#endif
@@ -21,7 +21,9 @@
 
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <gz/plugin/Plugin.hh>
+#include <gz/plugin/utility.hh>
 
 namespace gz
 {
@@ -32,7 +34,8 @@ namespace gz
     Interface *Plugin::QueryInterface()
     {
       return static_cast<Interface*>(
-            this->PrivateQueryInterface(typeid(Interface).name()));
+            this->PrivateQueryInterface(
+              typeid(Interface).name(), InterfaceIdOf<Interface>()));
     }
 
     //////////////////////////////////////////////////
@@ -40,7 +43,8 @@ namespace gz
     const Interface *Plugin::QueryInterface() const
     {
       return static_cast<const Interface*>(
-            this->PrivateQueryInterface(typeid(Interface).name()));
+            this->PrivateQueryInterface(
+              typeid(Interface).name(), InterfaceIdOf<Interface>()));
     }
 
     //////////////////////////////////////////////////
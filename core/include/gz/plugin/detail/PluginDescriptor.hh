@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PLUGIN_DETAIL_PLUGINDESCRIPTOR_HH_
+#define GZ_PLUGIN_DETAIL_PLUGINDESCRIPTOR_HH_
+
+#include <cstddef>
+
+#include <gz/plugin/Info.hh>
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      // The structs in this header are how a library hands its plugins to the
+      // Loader since version 2 of the Info API (see INFO_API_VERSION). They
+      // only hold sizes, plain pointers and pointers to functions, so their
+      // layout does not depend on the standard library that either side was
+      // built with, and the Loader can read them in place. Everything they
+      // point to is owned by the library and stays valid for as long as the
+      // library is loaded.
+
+      /// \brief A string that is owned by the library. It is not necessarily
+      /// null-terminated.
+      struct DescriptorString
+      {
+        /// \brief The first character of the string
+        const char *data;
+
+        /// \brief The number of characters in the string
+        std::size_t size;
+      };
+
+      /// \brief Describes one interface of a plugin
+      struct InterfaceDescriptor
+      {
+        /// \brief The mangled name of the interface
+        DescriptorString name;
+
+        /// \brief Casts an instance of the plugin to the interface. This is a
+        /// nullptr if the interface is always at `offset` within the instance.
+        void *(*cast)(void *_instance);
+
+        /// \brief Distance in bytes from the start of the plugin instance to
+        /// the interface. It is only meaningful when `cast` is a nullptr.
+        std::ptrdiff_t offset;
+      };
+
+      /// \brief Describes one plugin
+      struct PluginDescriptor
+      {
+        /// \brief The mangled name of the plugin
+        DescriptorString name;
+
+        /// \brief The interfaces of the plugin
+        const InterfaceDescriptor *interfaces;
+
+        /// \brief The number of elements in `interfaces`
+        std::size_t interfaceCount;
+
+        /// \brief The aliases of the plugin
+        const DescriptorString *aliases;
+
+        /// \brief The number of elements in `aliases`
+        std::size_t aliasCount;
+
+        /// \brief Gets the layout of the plugin class, like the describe
+        /// function of an InstanceFactory. This is a nullptr if instances of
+        /// the plugin may only be made by `create`.
+        InstanceLayout (*describe)();
+
+        /// \brief Allocates and constructs a new instance. This is a nullptr
+        /// if `describe` is provided.
+        void *(*create)();
+
+        /// \brief Deletes an instance that was made by `create`
+        void (*deleter)(void *_instance);
+      };
+
+      /// \brief All of the plugins of a library
+      struct PluginDescriptorTable
+      {
+        /// \brief The plugins of the library
+        const PluginDescriptor *plugins;
+
+        /// \brief The number of elements in `plugins`
+        std::size_t count;
+      };
+    }
+  }
+}
+
+#endif
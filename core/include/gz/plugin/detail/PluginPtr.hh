@@ -20,7 +20,10 @@
 #define GZ_PLUGIN_DETAIL_PLUGINPTR_HH_
 
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <gz/plugin/PluginPtr.hh>
 #include <gz/plugin/utility.hh>
 
@@ -31,7 +34,7 @@ namespace gz
     //////////////////////////////////////////////////
     template <typename PluginType>
     TemplatePluginPtr<PluginType>::TemplatePluginPtr()
-      : dataPtr(new PluginType)
+      : dataPtr(PrivateEmptyWrapper())
     {
       // Do nothing
     }
@@ -40,9 +43,9 @@ namespace gz
     template <typename PluginType>
     TemplatePluginPtr<PluginType>::TemplatePluginPtr(
         const TemplatePluginPtr &_other)
-      : dataPtr(new PluginType)
+      : dataPtr(_other.dataPtr)
     {
-      this->dataPtr->PrivateCopyPluginInstance(*_other.dataPtr);
+      // Do nothing
     }
 
     //////////////////////////////////////////////////
@@ -52,11 +55,10 @@ namespace gz
     template <typename OtherPluginType>
     TemplatePluginPtr<PluginType>::TemplatePluginPtr(
         const TemplatePluginPtr<OtherPluginType> &_other)
-      : dataPtr(new PluginType)
+      : dataPtr(PrivateShareWrapper(_other))
     {
       static_assert(ConstCompatible<PluginType, OtherPluginType>::value,
                 "The requested PluginPtr cast would discard const qualifiers");
-      this->dataPtr->PrivateCopyPluginInstance(*_other.dataPtr);
     }
 
     //////////////////////////////////////////////////
@@ -64,7 +66,7 @@ namespace gz
     TemplatePluginPtr<PluginType>& TemplatePluginPtr<PluginType>::operator =(
         const TemplatePluginPtr &_other)
     {
-      this->dataPtr->PrivateCopyPluginInstance(*_other.dataPtr);
+      this->dataPtr = _other.dataPtr;
       return *this;
     }
 
@@ -76,7 +78,7 @@ namespace gz
     {
       static_assert(ConstCompatible<PluginType, OtherPluginType>::value,
                 "The requested PluginPtr cast would discard const qualifiers");
-      this->dataPtr->PrivateCopyPluginInstance(*_other.dataPtr);
+      this->dataPtr = PrivateShareWrapper(_other);
       return *this;
     }
 
@@ -164,26 +166,118 @@ namespace gz
     template <typename PluginType>
     void TemplatePluginPtr<PluginType>::Clear()
     {
-      this->dataPtr->PrivateCreatePluginInstance(nullptr, nullptr);
+      this->dataPtr = PrivateEmptyWrapper();
     }
 
     //////////////////////////////////////////////////
     template <typename PluginType>
     TemplatePluginPtr<PluginType>::TemplatePluginPtr(
-        const ConstInfoPtr &_info,
-        const std::shared_ptr<void> &_dlHandlePtr)
-      : dataPtr(new PluginType)
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        std::pmr::memory_resource *_resource)
+      : dataPtr(PrivateMakeWrapper(_resource))
     {
-      dataPtr->PrivateCreatePluginInstance(_info, _dlHandlePtr);
+      dataPtr->PrivateCreatePluginInstance(_table, _dlHandlePtr, _resource);
     }
 
     //////////////////////////////////////////////////
     template <typename PluginType>
     TemplatePluginPtr<PluginType>::TemplatePluginPtr(
-        const ConstInfoPtr &_info)
-      : dataPtr(new PluginType)
+        const detail::ConstInterfaceTablePtr &_table,
+        std::pmr::memory_resource *_resource)
+      : dataPtr(PrivateMakeWrapper(_resource))
+    {
+      dataPtr->PrivateCreateStaticPluginInstance(_table, _resource);
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    TemplatePluginPtr<PluginType>::TemplatePluginPtr(
+        std::shared_ptr<PluginType> &&_wrapper)
+      : dataPtr(std::move(_wrapper))
+    {
+      // Do nothing
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    std::shared_ptr<PluginType>
+    TemplatePluginPtr<PluginType>::PrivateMakeWrapper(
+        std::pmr::memory_resource *_resource)
+    {
+      // The constructors of the plugin wrappers are protected, so
+      // std::make_shared needs this subclass to reach them. It lets the
+      // wrapper share one allocation with its reference counts.
+      struct Wrapper : public std::remove_const_t<PluginType> { };
+      if (_resource)
+      {
+        return std::allocate_shared<Wrapper>(
+              std::pmr::polymorphic_allocator<Wrapper>(_resource));
+      }
+
+      return std::make_shared<Wrapper>();
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    const std::shared_ptr<PluginType> &
+    TemplatePluginPtr<PluginType>::PrivateEmptyWrapper()
+    {
+      static const std::shared_ptr<PluginType> empty = PrivateMakeWrapper();
+      return empty;
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    std::vector<TemplatePluginPtr<PluginType>>
+    TemplatePluginPtr<PluginType>::PrivateMakeMany(
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        const std::size_t _count)
+    {
+      const std::vector<std::shared_ptr<void>> instances =
+          Plugin::PrivateCreatePluginInstances(_table, _dlHandlePtr, _count);
+
+      std::vector<TemplatePluginPtr> plugins;
+      plugins.reserve(instances.size());
+      for (const std::shared_ptr<void> &instance : instances)
+        plugins.push_back(PrivateMakeFromInstance(_table, instance));
+
+      return plugins;
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    TemplatePluginPtr<PluginType>
+    TemplatePluginPtr<PluginType>::PrivateMakeFromInstance(
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_instancePtr)
     {
-      dataPtr->PrivateCreateStaticPluginInstance(_info);
+      TemplatePluginPtr plugin(PrivateMakeWrapper());
+      plugin.dataPtr->PrivateCopyPluginInstance(_table, _instancePtr);
+      return plugin;
+    }
+
+    //////////////////////////////////////////////////
+    template <typename PluginType>
+    template <typename OtherPluginType>
+    std::shared_ptr<PluginType>
+    TemplatePluginPtr<PluginType>::PrivateShareWrapper(
+        const TemplatePluginPtr<OtherPluginType> &_other)
+    {
+      if constexpr (std::is_convertible_v<OtherPluginType*, PluginType*>)
+      {
+        return _other.dataPtr;
+      }
+      else
+      {
+        if (_other.IsEmpty())
+          return PrivateEmptyWrapper();
+
+        std::shared_ptr<PluginType> wrapper = PrivateMakeWrapper();
+        wrapper->PrivateCopyPluginInstance(*_other.dataPtr);
+        return wrapper;
+      }
     }
   }
 }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PLUGIN_DETAIL_PRODUCTRECYCLER_HH_
+#define GZ_PLUGIN_DETAIL_PRODUCTRECYCLER_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      /// \brief Keeps the storage of deleted factory products, so that a
+      /// factory can construct its next products in it instead of allocating.
+      /// Every block of storage has the size and alignment of the products of
+      /// the one factory that owns the recycler.
+      ///
+      /// The storage is allocated the same way as by a new-expression for the
+      /// product, so a recycled product may still be deleted normally.
+      class ProductRecycler
+        : public std::enable_shared_from_this<ProductRecycler>
+      {
+        /// \brief Constructor
+        /// \param[in] _size The size of every product
+        /// \param[in] _align The alignment of every product
+        public: ProductRecycler(const std::size_t _size,
+                                const std::size_t _align)
+          : size(_size),
+            alignment(_align)
+        {
+          // Do nothing
+        }
+
+        /// \brief Destructor. Frees the storage that is waiting to be reused.
+        public: ~ProductRecycler()
+        {
+          for (void *storage : this->idle)
+            this->Deallocate(storage);
+        }
+
+        /// \brief Set the largest number of blocks of storage to keep. If it
+        /// is zero, the factory does not recycle its products.
+        /// \param[in] _capacity The largest number of blocks to keep
+        public: void SetCapacity(const std::size_t _capacity)
+        {
+          std::vector<void*> excess;
+          {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->capacity.store(_capacity, std::memory_order_relaxed);
+            while (this->idle.size() > _capacity)
+            {
+              excess.push_back(this->idle.back());
+              this->idle.pop_back();
+            }
+          }
+
+          for (void *storage : excess)
+            this->Deallocate(storage);
+        }
+
+        /// \brief Check whether new products should use this recycler
+        /// \return True if the capacity is not zero
+        public: bool Enabled() const
+        {
+          return this->capacity.load(std::memory_order_relaxed) > 0;
+        }
+
+        /// \brief Get the number of blocks that are waiting to be reused
+        /// \return The number of blocks
+        public: std::size_t Idle() const
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          return this->idle.size();
+        }
+
+        /// \brief Take a block of storage for a product, allocating it if no
+        /// block is waiting.
+        /// \return Uninitialized storage for the product
+        public: void *Allocate()
+        {
+          {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (!this->idle.empty())
+            {
+              void *storage = this->idle.back();
+              this->idle.pop_back();
+              return storage;
+            }
+          }
+
+          return this->New();
+        }
+
+        /// \brief Take blocks of storage for several products at once. The
+        /// waiting blocks are taken under a single lock, and the rest get
+        /// allocated.
+        /// \param[in] _count The number of blocks to take
+        /// \param[out] _storage Receives the blocks, in the order in which
+        /// Allocate() would have handed them out
+        public: void AllocateMany(const std::size_t _count,
+                                  std::vector<void*> &_storage)
+        {
+          _storage.reserve(_storage.size() + _count);
+          const std::size_t end = _storage.size() + _count;
+          {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            while (_storage.size() < end && !this->idle.empty())
+            {
+              _storage.push_back(this->idle.back());
+              this->idle.pop_back();
+            }
+          }
+
+          while (_storage.size() < end)
+            _storage.push_back(this->New());
+        }
+
+        /// \brief Give back the storage of a product that has been destroyed
+        /// \param[in] _storage The storage, which must have come from
+        /// Allocate() or AllocateMany(~)
+        public: void Release(void *_storage)
+        {
+          {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (this->idle.size() < this->capacity.load(
+                  std::memory_order_relaxed))
+            {
+              this->idle.push_back(_storage);
+              return;
+            }
+          }
+
+          this->Deallocate(_storage);
+        }
+
+        /// \brief Allocate a new block of storage
+        /// \return The storage
+        private: void *New() const
+        {
+          if (this->alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+          {
+            return ::operator new(
+                  this->size, std::align_val_t(this->alignment));
+          }
+
+          return ::operator new(this->size);
+        }
+
+        /// \brief Free a block of storage
+        /// \param[in] _storage The storage
+        private: void Deallocate(void *_storage) const
+        {
+          if (this->alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+          {
+            ::operator delete(
+                  _storage, this->size, std::align_val_t(this->alignment));
+          }
+          else
+          {
+            ::operator delete(_storage, this->size);
+          }
+        }
+
+        /// \brief Protects `idle`
+        private: mutable std::mutex mutex;
+
+        /// \brief Storage that is waiting to be reused
+        private: std::vector<void*> idle;
+
+        /// \brief The largest number of blocks to keep in `idle`
+        private: std::atomic<std::size_t> capacity{0};
+
+        /// \brief The size of every block
+        private: const std::size_t size;
+
+        /// \brief The alignment of every block
+        private: const std::size_t alignment;
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief Products with their own operator new are never recycled,
+      /// because their storage must come from that operator.
+      template <typename Product, typename = void>
+      struct IsRecyclable : std::true_type { };
+
+      //////////////////////////////////////////////////
+      template <typename Product>
+      struct IsRecyclable<Product, std::void_t<
+          decltype(Product::operator new(std::declval<std::size_t>()))>>
+        : std::false_type { };
+
+      //////////////////////////////////////////////////
+      /// \brief The type in which ConstructMany passes an argument of type Arg
+      /// to each product. Lvalue references are passed on, and everything
+      /// else is copied for each product.
+      template <typename Arg>
+      using CopiedArgument = std::conditional_t<
+          std::is_lvalue_reference<Arg>::value, Arg, std::decay_t<Arg>>;
+    }
+  }
+}
+
+#endif
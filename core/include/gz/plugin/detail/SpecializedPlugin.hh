@@ -108,8 +108,7 @@ namespace gz
       #ifdef GZ_UNITTEST_SPECIALIZED_PLUGIN_ACCESS
       usedSpecializedInterfaceAccess = true;
       #endif
-      return static_cast<SpecInterface*>(
-            this->privateSpecializedInterfaceIterator->second);
+      return static_cast<SpecInterface*>(this->privateSpecializedSlot.ptr);
     }
 
     /////////////////////////////////////////////////
@@ -129,8 +128,7 @@ namespace gz
       #ifdef GZ_UNITTEST_SPECIALIZED_PLUGIN_ACCESS
       usedSpecializedInterfaceAccess = true;
       #endif
-      return static_cast<SpecInterface*>(
-            this->privateSpecializedInterfaceIterator->second);
+      return static_cast<SpecInterface*>(this->privateSpecializedSlot.ptr);
     }
 
     /////////////////////////////////////////////////
@@ -150,17 +148,16 @@ namespace gz
       #ifdef GZ_UNITTEST_SPECIALIZED_PLUGIN_ACCESS
       usedSpecializedInterfaceAccess = true;
       #endif
-      return (nullptr != this->privateSpecializedInterfaceIterator->second);
+      return (nullptr != this->privateSpecializedSlot.ptr);
     }
 
     /////////////////////////////////////////////////
     template <class SpecInterface>
     SpecializedPlugin<SpecInterface>::SpecializedPlugin()
-      : privateSpecializedInterfaceIterator(
-          this->PrivateGetOrCreateIterator(
-            typeid(SpecInterface).name()))
+      : privateSpecializedSlot{typeid(SpecInterface).name(),
+          &InterfaceIdOf<SpecInterface>(), nullptr, nullptr}
     {
-      // Do nothing
+      this->PrivateAddSpecializedSlot(this->privateSpecializedSlot);
     }
 
     namespace detail
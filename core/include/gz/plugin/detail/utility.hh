@@ -20,6 +20,8 @@
 #define GZ_PLUGIN_DETAIL_UTILITY_HH_
 
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace gz
@@ -40,6 +42,23 @@ namespace gz
           : std::integral_constant<bool, std::is_const<To>::value>
       {
       };
+
+      //////////////////////////////////////////////////
+      /// \brief Hash the name of an interface, as given by typeid(T).name(),
+      /// using 64-bit FNV-1a. Plugin instances index their interfaces by this
+      /// hash, so it must give the same result in every library.
+      /// \param[in] _name The name of the interface
+      /// \return The hash of the name
+      constexpr std::uint64_t HashInterfaceName(const char *_name)
+      {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (; *_name != '\0'; ++_name)
+        {
+          hash ^= static_cast<unsigned char>(*_name);
+          hash *= 1099511628211ull;
+        }
+        return hash;
+      }
     }
   }
 }
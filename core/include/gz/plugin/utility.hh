@@ -19,7 +19,10 @@
 #ifndef GZ_PLUGIN_UTILITY_HH_
 #define GZ_PLUGIN_UTILITY_HH_
 
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <typeinfo>
 
 #include <gz/plugin/detail/utility.hh>
 #include <gz/plugin/Export.hh>
@@ -58,6 +61,45 @@ namespace gz
     /// \return The demangled (human-readable) version of the symbol name
     std::string GZ_PLUGIN_VISIBLE DemangleSymbol(
         const std::string &_symbol);
+
+    /////////////////////////////////////////////////
+    /// \brief Identifies an interface by the hash of its mangled name. The
+    /// hash only depends on the name, so every library agrees on the ID of an
+    /// interface no matter where the ID was computed.
+    struct InterfaceId
+    {
+      /// \brief The result of detail::HashInterfaceName(~) for the mangled
+      /// name of the interface
+      std::uint64_t hash;
+
+      /// \brief Raised if some other registered interface name has the same
+      /// hash. As long as it stays false, comparing hashes is enough to
+      /// identify the interface. This flag lives for the rest of the process.
+      const std::atomic<bool> *ambiguous;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Register the mangled name of an interface and get its ID. If
+    /// another name with the same hash has been registered before, both
+    /// names get flagged as ambiguous, and lookups for them will go back to
+    /// comparing names. Registering the same name twice is harmless.
+    /// \param[in] _interfaceName
+    ///   Pass in the result of typeid(T).name()
+    /// \return The ID of the interface
+    InterfaceId GZ_PLUGIN_VISIBLE RegisterInterfaceId(
+        const char *_interfaceName);
+
+    /////////////////////////////////////////////////
+    /// \brief Get the ID of an interface type. It is registered the first
+    /// time this gets called for the type, and every later call only returns
+    /// the cached ID.
+    template <typename Interface>
+    const InterfaceId &InterfaceIdOf()
+    {
+      static const InterfaceId id =
+          RegisterInterfaceId(typeid(Interface).name());
+      return id;
+    }
   }
 }
 
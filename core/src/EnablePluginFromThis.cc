@@ -25,6 +25,10 @@ namespace gz
     class EnablePluginFromThis::Implementation
     {
       public: WeakPluginPtr weak;
+
+      /// \brief The instance of the plugin, which PluginInstancePtrFromThis()
+      /// can lock without making a PluginPtr
+      public: std::weak_ptr<void> instance;
     };
 
     EnablePluginFromThis::EnablePluginFromThis()
@@ -51,12 +55,13 @@ namespace gz
     std::shared_ptr<void>
     EnablePluginFromThis::PluginInstancePtrFromThis() const
     {
-      return this->pimpl->weak.Lock()->PrivateGetInstancePtr();
+      return this->pimpl->instance.lock();
     }
 
     void EnablePluginFromThis::PrivateSetPluginFromThis(const PluginPtr &_ptr)
     {
       this->pimpl->weak = _ptr;
+      this->pimpl->instance = _ptr->PrivateGetInstancePtr();
     }
   }
 }
@@ -15,35 +15,257 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
-#include <vector>
+#include <utility>
 
 #include <gz/plugin/Factory.hh>
 
 namespace
 {
+  using Clock = std::chrono::steady_clock;
+
+  /// \brief The factory reference of a product that did not get properly
+  /// deleted by a ProductDeleter.
+  struct LostProduct
+  {
+    /// \brief The reference which keeps the library of the product loaded
+    public: std::shared_ptr<void> factory;
+
+    /// \brief When the product was destructed
+    public: Clock::time_point lostAt;
+
+    /// \brief The product that was lost before this one
+    public: LostProduct *next;
+  };
+
   struct LostProductManager
   {
-    /// \brief This class is designed to handle situations where users have lost
-    /// control of their plugin lifecycle management, so we should assume that
-    /// it's possible for plugin objects to be getting destructed and/or cleaned
-    /// up across different threads at the same time.
+    /// \brief Destructor. Stops the reaper and releases the factory
+    /// references that are still waiting.
+    public: ~LostProductManager()
+    {
+      this->StopReaper();
+
+      LostProduct *product = this->head.exchange(nullptr);
+      while (product)
+      {
+        LostProduct *const next = product->next;
+        delete product;
+        product = next;
+      }
+    }
+
+    /// \brief Hand off the factory reference of a lost product.
     ///
-    /// To guard against race conditions, we should use a mutex when modifying
-    /// this object with a static lifetime.
-    public: std::mutex mutex;
+    /// This class is designed to handle situations where users have lost
+    /// control of their plugin lifecycle management, so we should assume that
+    /// it's possible for plugin objects to be getting destructed and/or
+    /// cleaned up across different threads at the same time. Products that
+    /// are being destructed never wait for each other or for a cleanup, so
+    /// they are pushed onto a lock-free stack.
+    /// \param[in] _factory The factory reference of the product
+    public: void Push(std::shared_ptr<void> _factory)
+    {
+      // The depth is counted before the product can be taken, so that it
+      // never drops below zero.
+      this->depth.fetch_add(1, std::memory_order_relaxed);
+      this->lost.fetch_add(1, std::memory_order_relaxed);
+
+      LostProduct *const product = new LostProduct{
+          std::move(_factory), Clock::now(),
+          this->head.load(std::memory_order_relaxed)};
+
+      // Dev note: Products are only ever taken off the stack all at once by
+      // TakeAll(), so this cannot suffer from the ABA problem.
+      while (!this->head.compare_exchange_weak(
+               product->next, product,
+               std::memory_order_release, std::memory_order_relaxed))
+      {
+        // product->next has been updated to the current head, so try again
+      }
+    }
+
+    /// \brief Take every lost product that is waiting
+    /// \return The most recently lost product, which links to the others
+    public: LostProduct *TakeAll()
+    {
+      return this->head.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    /// \brief Start the reaper thread, or change its schedule
+    /// \param[in] _period Time between cleanups
+    /// \param[in] _safetyWait Safety wait of each cleanup
+    public: void StartReaper(const std::chrono::nanoseconds &_period,
+                             const std::chrono::nanoseconds &_safetyWait)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->reaperMutex);
+        if (this->reaperId == std::this_thread::get_id())
+        {
+          // Dev note: This is the reaper thread itself, e.g. a library that
+          // got unloaded by a cleanup started the reaper from one of its
+          // static destructors. It must not wait for reaperControlMutex,
+          // because StopReaper() might be holding it while it joins this
+          // thread, so only the schedule gets changed.
+          this->SetSchedule(_period, _safetyWait);
+          return;
+        }
+      }
+
+      std::lock_guard<std::mutex> control(this->reaperControlMutex);
+      bool running = false;
+      {
+        std::lock_guard<std::mutex> lock(this->reaperMutex);
+        this->SetSchedule(_period, _safetyWait);
+        running = this->reaper.joinable() && !this->stopReaper;
+      }
+
+      if (running)
+      {
+        // Wake up the reaper so that it starts waiting for the new period
+        this->reaperWakeUp.notify_all();
+        return;
+      }
+
+      // The reaper might have stopped itself
+      if (this->reaper.joinable())
+        this->reaper.join();
+
+      std::lock_guard<std::mutex> lock(this->reaperMutex);
+      this->stopReaper = false;
+      this->reaper = std::thread(&LostProductManager::RunReaper, this);
+      this->reaperId = this->reaper.get_id();
+    }
+
+    /// \brief Stop the reaper thread if it is running
+    public: void StopReaper()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->reaperMutex);
+        if (this->reaperId == std::this_thread::get_id())
+        {
+          // Dev note: This is the reaper thread itself, e.g. a library that
+          // got unloaded by a cleanup stopped the reaper from one of its
+          // static destructors. A thread cannot join itself, so the reaper
+          // stops once the cleanup is done, and it gets joined by the next
+          // call from a different thread.
+          this->stopReaper = true;
+          return;
+        }
+      }
+
+      std::lock_guard<std::mutex> control(this->reaperControlMutex);
+      {
+        std::lock_guard<std::mutex> lock(this->reaperMutex);
+        this->stopReaper = true;
+      }
+      this->reaperWakeUp.notify_all();
+
+      if (this->reaper.joinable())
+        this->reaper.join();
+
+      std::lock_guard<std::mutex> lock(this->reaperMutex);
+      this->reaperId = std::thread::id();
+    }
+
+    /// \brief Change the schedule of the reaper. `reaperMutex` must be
+    /// locked.
+    /// \param[in] _period Time between cleanups
+    /// \param[in] _safetyWait Safety wait of each cleanup
+    private: void SetSchedule(const std::chrono::nanoseconds &_period,
+                              const std::chrono::nanoseconds &_safetyWait)
+    {
+      this->reaperPeriod = _period;
+      this->reaperSafetyWait = _safetyWait;
+      ++this->reaperSchedule;
+    }
+
+    /// \brief The loop of the reaper thread
+    private: void RunReaper()
+    {
+      std::unique_lock<std::mutex> lock(this->reaperMutex);
+      while (!this->stopReaper)
+      {
+        // A new schedule restarts the wait with the new period
+        const std::size_t schedule = this->reaperSchedule;
+        if (this->reaperWakeUp.wait_for(lock, this->reaperPeriod, [&]()
+              {
+                return this->stopReaper || this->reaperSchedule != schedule;
+              }))
+        {
+          continue;
+        }
 
-    /// \brief This is a collection of references to the factories of products
+        const std::chrono::nanoseconds safetyWait = this->reaperSafetyWait;
+        lock.unlock();
+        gz::plugin::CleanupLostProducts(safetyWait);
+        lock.lock();
+      }
+    }
+
+    /// \brief This is a stack of references to the factories of products
     /// that did not get properly deleted by a ProductDeleter. We will store
     /// their factory references here to ensure that their libraries remain
     /// loaded so the products can be deleted safely.
     ///
     /// If a user knows that they are losing control of their products, they can
-    /// call CleanupLostProducts() to clear out this vector and clean up any
+    /// call CleanupLostProducts() to clear out this stack and clean up any
     /// potential memory leaks.
-    public: std::vector<std::shared_ptr<void>> lostProducts;
+    public: std::atomic<LostProduct*> head{nullptr};
+
+    /// \brief Number of lost products that have not been cleaned up yet
+    public: std::atomic<std::size_t> depth{0};
+
+    /// \brief Number of products that were lost since the program began
+    public: std::atomic<std::size_t> lost{0};
+
+    /// \brief Protects the counters of the cleanups. Only the threads which
+    /// clean up lock it, never the products that are being destructed.
+    public: std::mutex reclaimMutex;
+
+    /// \brief Number of factory references that were cleaned up
+    public: std::size_t reclaimed = 0;
+
+    /// \brief See LostProductStats::lastReclaimLatency
+    public: std::chrono::nanoseconds lastReclaimLatency{0};
+
+    /// \brief See LostProductStats::maxReclaimLatency
+    public: std::chrono::nanoseconds maxReclaimLatency{0};
+
+    /// \brief Makes StartReaper() and StopReaper() take turns
+    public: std::mutex reaperControlMutex;
+
+    /// \brief Protects the schedule of the reaper and `stopReaper`
+    public: std::mutex reaperMutex;
+
+    /// \brief Wakes up the reaper when it should stop or when its schedule
+    /// has changed
+    public: std::condition_variable reaperWakeUp;
+
+    /// \brief The reaper thread, if it has been started. This is only
+    /// touched while `reaperControlMutex` is locked.
+    public: std::thread reaper;
+
+    /// \brief ID of the reaper thread, which is read while `reaperMutex`
+    /// is locked
+    public: std::thread::id reaperId;
+
+    /// \brief Counts the changes to the schedule of the reaper
+    public: std::size_t reaperSchedule = 0;
+
+    /// \brief Time between the cleanups of the reaper
+    public: std::chrono::nanoseconds reaperPeriod{0};
+
+    /// \brief Safety wait of the cleanups of the reaper
+    public: std::chrono::nanoseconds reaperSafetyWait{0};
+
+    /// \brief True when the reaper should stop
+    public: bool stopReaper = false;
   };
 
   /// static instance of the lost product manager that will be used to store the
@@ -74,29 +296,76 @@ namespace gz
           // will hand off a copy of the factory reference to the
           // lostProductManager which will keep it alive until the user
           // explicitly calls CleanupLostProducts().
-          std::unique_lock<std::mutex> lock(lostProductManager.mutex);
-          lostProductManager.lostProducts.push_back(
-                this->factoryPluginInstancePtr);
+          lostProductManager.Push(this->factoryPluginInstancePtr);
         }
       }
     }
 
     void CleanupLostProducts(const std::chrono::nanoseconds &_safetyWait)
     {
-      std::unique_lock<std::mutex> lock(lostProductManager.mutex);
+      LostProduct *product = lostProductManager.TakeAll();
+      if (!product)
+        return;
 
       // In case any products are in-between handing off their factory reference
       // and exiting their destructor, wait for a short while so that the call
       // stack can fully exit the destructor before we unload its library.
+      // Products that get lost in the meantime are not held up by this.
       std::this_thread::sleep_for(_safetyWait);
 
-      lostProductManager.lostProducts.clear();
+      std::size_t count = 0;
+      Clock::time_point oldest = product->lostAt;
+      while (product)
+      {
+        LostProduct *const next = product->next;
+        oldest = std::min(oldest, product->lostAt);
+        delete product;
+        product = next;
+        ++count;
+      }
+
+      const std::chrono::nanoseconds latency =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - oldest);
+
+      lostProductManager.depth.fetch_sub(count, std::memory_order_relaxed);
+
+      std::lock_guard<std::mutex> lock(lostProductManager.reclaimMutex);
+      lostProductManager.reclaimed += count;
+      lostProductManager.lastReclaimLatency = latency;
+      lostProductManager.maxReclaimLatency =
+          std::max(lostProductManager.maxReclaimLatency, latency);
     }
 
     std::size_t LostProductCount()
     {
-      std::unique_lock<std::mutex> lock(lostProductManager.mutex);
-      return lostProductManager.lostProducts.size();
+      return lostProductManager.depth.load(std::memory_order_relaxed);
+    }
+
+    LostProductStats LostProductStatistics()
+    {
+      LostProductStats stats;
+      stats.depth = lostProductManager.depth.load(std::memory_order_relaxed);
+      stats.lost = lostProductManager.lost.load(std::memory_order_relaxed);
+
+      std::lock_guard<std::mutex> lock(lostProductManager.reclaimMutex);
+      stats.reclaimed = lostProductManager.reclaimed;
+      stats.lastReclaimLatency = lostProductManager.lastReclaimLatency;
+      stats.maxReclaimLatency = lostProductManager.maxReclaimLatency;
+
+      return stats;
+    }
+
+    void StartLostProductReaper(
+        const std::chrono::nanoseconds &_period,
+        const std::chrono::nanoseconds &_safetyWait)
+    {
+      lostProductManager.StartReaper(_period, _safetyWait);
+    }
+
+    void StopLostProductReaper()
+    {
+      lostProductManager.StopReaper();
     }
   }
 }
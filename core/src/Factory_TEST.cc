@@ -49,6 +49,11 @@ struct SomeDerived : public SomeBase
   {
     // Do nothing
   }
+
+  explicit SomeDerived(int &_constructed)
+  {
+    ++_constructed;
+  }
 };
 
 using NoArgFactory = gz::plugin::Factory<SomeBase>;
@@ -61,6 +66,9 @@ using VectorFactory = gz::plugin::Factory<
     SomeBase, const std::vector<double>&>;
 using VectorProducer = VectorFactory::Producing<SomeDerived>;
 
+using CounterFactory = gz::plugin::Factory<SomeBase, int&>;
+using CounterProducer = CounterFactory::Producing<SomeDerived>;
+
 /////////////////////////////////////////////////
 TEST(Factory, ProducerNoArgs)
 {
@@ -81,3 +89,105 @@ TEST(Factory, ProducerWithVector)
   VectorProducer producer;
   EXPECT_NE(nullptr, producer.Construct(std::vector<double>()));
 }
+
+/////////////////////////////////////////////////
+TEST(Factory, ConstructMany)
+{
+  VectorProducer producer;
+  const std::vector<double> values = {1.0, 2.0};
+  std::vector<VectorFactory::ProductPtrType> products =
+      producer.ConstructMany(3, values);
+
+  ASSERT_EQ(3u, products.size());
+  for (const auto &product : products)
+    EXPECT_NE(nullptr, product);
+
+  EXPECT_TRUE(producer.ConstructMany(0, values).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, ConstructManyWithReference)
+{
+  CounterProducer producer;
+  int constructed = 0;
+  std::vector<CounterFactory::ProductPtrType> products =
+      producer.ConstructMany(3, constructed);
+
+  // Every product was given the same variable
+  ASSERT_EQ(3u, products.size());
+  EXPECT_EQ(3, constructed);
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, RecycleProducts)
+{
+  DoubleIntProducer producer;
+  EXPECT_EQ(0u, producer.RecycledProductCount());
+
+  // Without recycling, nothing is kept
+  producer.Construct(0.0, 1).reset();
+  EXPECT_EQ(0u, producer.RecycledProductCount());
+
+  producer.RecycleProducts(2);
+
+  std::vector<DoubleIntFactory::ProductPtrType> products =
+      producer.ConstructMany(3, 0.0, 1);
+  ASSERT_EQ(3u, products.size());
+
+  SomeBase *const second = products[1].get();
+  for (auto &product : products)
+    product.reset();
+
+  // Only as many as the capacity are kept
+  EXPECT_EQ(2u, producer.RecycledProductCount());
+
+  // The storage of the most recently recycled product is used first
+  auto product = producer.Construct(0.0, 1);
+  EXPECT_EQ(second, product.get());
+  EXPECT_EQ(1u, producer.RecycledProductCount());
+
+  // A recycled product may still be released and deleted normally
+  delete product.release();
+  EXPECT_EQ(1u, producer.RecycledProductCount());
+
+  producer.RecycleProducts(0);
+  EXPECT_EQ(0u, producer.RecycledProductCount());
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, ConstructManyTakesRecycledProducts)
+{
+  DoubleIntProducer producer;
+  producer.RecycleProducts(2);
+
+  std::vector<DoubleIntFactory::ProductPtrType> products =
+      producer.ConstructMany(2, 0.0, 1);
+  SomeBase *const first = products[0].get();
+  SomeBase *const second = products[1].get();
+  products.clear();
+  EXPECT_EQ(2u, producer.RecycledProductCount());
+
+  // Both waiting blocks are taken, in the same order as by Construct(~), and
+  // the third product gets new storage.
+  products = producer.ConstructMany(3, 0.0, 1);
+  ASSERT_EQ(3u, products.size());
+  EXPECT_EQ(0u, producer.RecycledProductCount());
+  EXPECT_EQ(second, products[0].get());
+  EXPECT_EQ(first, products[1].get());
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, RecycledProductOutlivesFactory)
+{
+  DoubleIntFactory::ProductPtrType product;
+  {
+    DoubleIntProducer producer;
+    producer.RecycleProducts(1);
+    product = producer.Construct(0.0, 1);
+    ASSERT_NE(nullptr, product);
+  }
+
+  // This factory was not made by a Loader, so nothing keeps it alive, but
+  // the product still shares its recycler.
+  product.reset();
+}
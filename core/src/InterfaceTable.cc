@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
+#include <utility>
+
+#include "gz/plugin/detail/InterfaceTable.hh"
+#include "gz/plugin/utility.hh"
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      InterfaceTable::InterfaceTable(ConstInfoPtr _info)
+        : info(std::move(_info))
+      {
+        if (!this->info)
+          return;
+
+        if (const InstanceFactory *factory =
+              this->info->factory.target<InstanceFactory>())
+        {
+          this->layout = factory->describe();
+        }
+
+        this->entries.reserve(this->info->interfaces.size());
+        for (const auto &interface : this->info->interfaces)
+        {
+          // The marker is not a base of the plugin, so it cannot be queried
+          if (IsSharedInstanceMarker(interface.first))
+          {
+            this->shared = true;
+            continue;
+          }
+
+          // Plugin::QueryInterface relies on every interface of a plugin being
+          // registered before the plugin can be instantiated. This is also
+          // where a clash between two interface IDs gets detected.
+          const InterfaceId id = RegisterInterfaceId(interface.first.c_str());
+
+          Entry entry{id.hash, &interface.first, &interface.second, 0};
+
+          // Most interfaces are at a fixed offset which is known without an
+          // instance. The others get located by the first instance.
+          if (const InterfaceOffset *offset =
+                interface.second.target<InterfaceOffset>())
+          {
+            entry.cast = nullptr;
+            entry.offset = offset->offset;
+          }
+
+          this->entries.push_back(entry);
+        }
+
+        std::sort(this->entries.begin(), this->entries.end(),
+                  [](const Entry &_a, const Entry &_b)
+                  { return _a.hash < _b.hash; });
+      }
+
+      //////////////////////////////////////////////////
+      const ConstInfoPtr &InterfaceTable::GetInfo() const
+      {
+        return this->info;
+      }
+
+      //////////////////////////////////////////////////
+      const InstanceLayout *InterfaceTable::GetLayout() const
+      {
+        if (!this->layout.construct)
+          return nullptr;
+
+        return &this->layout;
+      }
+
+      //////////////////////////////////////////////////
+      bool InterfaceTable::IsShared() const
+      {
+        return this->shared;
+      }
+
+      //////////////////////////////////////////////////
+      std::shared_ptr<void> InterfaceTable::GetSharedInstance(
+          const std::function<std::shared_ptr<void>()> &_create) const
+      {
+        std::call_once(this->sharedCreated, [&]()
+        {
+          this->sharedInstance = _create();
+        });
+
+        return this->sharedInstance;
+      }
+
+      //////////////////////////////////////////////////
+      void InterfaceTable::Locate(void *_instance) const
+      {
+        std::call_once(this->located, [&]()
+        {
+          for (Entry &entry : this->entries)
+          {
+            // An Info which only describes a plugin (e.g. one that was read
+            // from a manifest) has no casting functions, so there is nothing
+            // to locate.
+            if (!entry.cast || !*entry.cast)
+              continue;
+
+            // Dev note: Even a virtual base is at the same offset in every
+            // instance, because the factory of an Info always creates the
+            // same class.
+            entry.offset =
+                static_cast<char*>((*entry.cast)(_instance))
+                - static_cast<char*>(_instance);
+            entry.cast = nullptr;
+          }
+        });
+      }
+
+      //////////////////////////////////////////////////
+      void *InterfaceTable::Find(
+          void *_instance,
+          const char *_interfaceName,
+          const std::uint64_t _hash,
+          const std::atomic<bool> *_ambiguous) const
+      {
+        if (!_instance)
+          return nullptr;
+
+        auto it = std::lower_bound(
+              this->entries.begin(), this->entries.end(), _hash,
+              [](const Entry &_entry, const std::uint64_t _value)
+              { return _entry.hash < _value; });
+
+        // Every interface in the table has been registered. So if the queried
+        // name is registered and no other registered name shares its hash, a
+        // matching hash is already a match.
+        if (_ambiguous && !_ambiguous->load(std::memory_order_acquire))
+        {
+          if (it == this->entries.end() || it->hash != _hash || it->cast)
+            return nullptr;
+
+          return static_cast<char*>(_instance) + it->offset;
+        }
+
+        // Otherwise the hash only narrows the search down, and the name still
+        // has to be compared to confirm the match.
+        for (; it != this->entries.end() && it->hash == _hash; ++it)
+        {
+          if (std::strcmp(it->name->c_str(), _interfaceName) == 0)
+          {
+            if (it->cast)
+              return nullptr;
+
+            return static_cast<char*>(_instance) + it->offset;
+          }
+        }
+
+        return nullptr;
+      }
+
+      //////////////////////////////////////////////////
+      void *InterfaceTable::Find(
+          void *_instance,
+          const std::string &_interfaceName) const
+      {
+        return this->Find(_instance, _interfaceName.c_str(),
+                          HashInterfaceName(_interfaceName.c_str()), nullptr);
+      }
+    }
+  }
+}
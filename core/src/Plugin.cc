@@ -16,11 +16,19 @@
  */
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <iostream>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include "gz/plugin/Plugin.hh"
 #include "gz/plugin/Info.hh"
+#include "gz/plugin/detail/InterfaceTable.hh"
 
 namespace gz
 {
@@ -104,49 +112,450 @@ namespace gz
       public: std::function<void(void*)> deleter;
     };
 
+    /// \brief Struct which wraps a plugin instance that was constructed in
+    /// place together with a std::shared_ptr to its shared library handle. It
+    /// shares one allocation with the instance and with the control block of
+    /// the std::shared_ptr that manages it. See InstanceAllocator.
+    struct PluginInPlace
+    {
+      /// \brief Constructor
+      public: PluginInPlace(
+        const InstanceLayout &_layout,
+        const std::shared_ptr<void> &_dlHandlePtr)
+        : dlHandlePtr(_dlHandlePtr),
+          destroy(_layout.destroy)
+      {
+        // Do nothing
+      }
+
+      /// \brief Destructor. This destroys the instance while dlHandlePtr is
+      /// still keeping the library of its destructor loaded. The storage of
+      /// the instance gets released along with this struct.
+      public: ~PluginInPlace()
+      {
+        // The instance is missing if its constructor threw an exception
+        if (loadedInstance)
+          destroy(loadedInstance);
+      }
+
+      /// \brief A reference counting handle for the shared library that this
+      /// plugin depends on.
+      public: std::shared_ptr<void> dlHandlePtr;
+
+      /// \brief The function which destroys the instance. It lives in the
+      /// shared library.
+      ///
+      /// Dev note: This is copied out of the InstanceLayout because the
+      /// instance may outlive the interface table that holds the layout.
+      public: void (*destroy)(void*);
+
+      /// \brief Pointer to the plugin instance
+      public: void *loadedInstance = nullptr;
+    };
+
+    /// \brief Allocator for std::allocate_shared which leaves room for a
+    /// plugin instance at the end of each block that it allocates, so that
+    /// the instance, its PluginInPlace and the reference counts all share a
+    /// single allocation. The blocks come from a memory resource if one is
+    /// given, or else from operator new.
+    template <typename T>
+    struct InstanceAllocator
+    {
+      using value_type = T;
+
+      /// \brief Constructor
+      /// \param[in] _layout The layout of the plugin class
+      /// \param[out] _storage Receives the location of the room for the
+      /// instance once the block has been allocated.
+      /// \param[in] _resource The memory resource to allocate from, or a
+      /// nullptr to use operator new
+      public: InstanceAllocator(const InstanceLayout &_layout, void **_storage,
+                                std::pmr::memory_resource *_resource)
+        : size(_layout.size),
+          alignment(_layout.alignment),
+          storage(_storage),
+          resource(_resource)
+      {
+        // Do nothing
+      }
+
+      /// \brief Rebinding constructor
+      public: template <typename U>
+      InstanceAllocator(const InstanceAllocator<U> &_other)
+        : size(_other.size),
+          alignment(_other.alignment),
+          storage(_other.storage),
+          resource(_other.resource)
+      {
+        // Do nothing
+      }
+
+      /// \brief Allocate a block for _n objects of type T, followed by the
+      /// room for the instance.
+      public: T *allocate(const std::size_t _n)
+      {
+        const std::size_t offset = this->Offset(_n);
+        const std::size_t blockSize = offset + this->size;
+        const std::size_t blockAlign = this->Alignment();
+
+        void *block;
+        if (this->resource)
+          block = this->resource->allocate(blockSize, blockAlign);
+        else if (blockAlign > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+          block = ::operator new(blockSize, std::align_val_t(blockAlign));
+        else
+          block = ::operator new(blockSize);
+
+        *this->storage = static_cast<char*>(block) + offset;
+        return static_cast<T*>(block);
+      }
+
+      /// \brief Release a block that was made by allocate(_n)
+      public: void deallocate(T *_block, const std::size_t _n)
+      {
+        const std::size_t blockSize = this->Offset(_n) + this->size;
+        const std::size_t blockAlign = this->Alignment();
+
+        if (this->resource)
+          this->resource->deallocate(_block, blockSize, blockAlign);
+        else if (blockAlign > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+          ::operator delete(_block, blockSize, std::align_val_t(blockAlign));
+        else
+          ::operator delete(_block, blockSize);
+      }
+
+      /// \brief Distance from the start of a block for _n objects of type T
+      /// to the room for the instance
+      private: std::size_t Offset(const std::size_t _n) const
+      {
+        return (_n * sizeof(T) + this->alignment - 1)
+            / this->alignment * this->alignment;
+      }
+
+      /// \brief Alignment of the blocks
+      private: std::size_t Alignment() const
+      {
+        return std::max(alignof(T), this->alignment);
+      }
+
+      /// \brief sizeof the plugin class
+      public: std::size_t size;
+
+      /// \brief alignof the plugin class
+      public: std::size_t alignment;
+
+      /// \brief Where to put the location of the room for the instance
+      public: void **storage;
+
+      /// \brief The memory resource to allocate from, or a nullptr
+      public: std::pmr::memory_resource *resource;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const InstanceAllocator<T> &_a,
+                    const InstanceAllocator<U> &_b)
+    {
+      return _a.size == _b.size && _a.alignment == _b.alignment
+          && _a.resource == _b.resource;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const InstanceAllocator<T> &_a,
+                    const InstanceAllocator<U> &_b)
+    {
+      return !(_a == _b);
+    }
+
+    /// \brief A single block of memory which holds several plugin instances
+    /// next to each other. Each instance shares a slot of the block with its
+    /// PluginInPlace and reference counts, so the instances can still be
+    /// destroyed one by one. The block itself is released once every slot
+    /// has been released. See GroupAllocator.
+    class InstanceGroup
+    {
+      /// \brief Constructor
+      /// \param[in] _layout The layout of the plugin class
+      /// \param[in] _dlHandlePtr The one reference to the shared library that
+      /// all of the instances share
+      /// \param[in] _count The number of slots
+      public: InstanceGroup(
+        const InstanceLayout &_layout,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        const std::size_t _count)
+        : dlHandlePtr(_dlHandlePtr),
+          layout(_layout),
+          count(_count)
+      {
+        // Do nothing
+      }
+
+      /// \brief Destructor. This runs after every instance has been
+      /// destroyed, so the shared library may be released now.
+      public: ~InstanceGroup()
+      {
+        if (!this->block)
+          return;
+
+        if (this->alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+          ::operator delete(this->block, this->stride * this->count,
+                            std::align_val_t(this->alignment));
+        }
+        else
+        {
+          ::operator delete(this->block, this->stride * this->count);
+        }
+      }
+
+      /// \brief Get the next slot. The block gets allocated by the first
+      /// call, because only then is the size of the bookkeeping known.
+      /// \param[in] _headerSize Size of the bookkeeping at the start of the
+      /// slot
+      /// \param[in] _headerAlign Alignment of the bookkeeping
+      /// \param[out] _storage Receives the location of the room for the
+      /// instance
+      /// \return The start of the slot
+      public: void *Allocate(const std::size_t _headerSize,
+                             const std::size_t _headerAlign,
+                             void **_storage)
+      {
+        if (!this->block)
+        {
+          const std::size_t instanceAlign = this->layout.alignment;
+          this->headerSize = _headerSize;
+          this->offset = RoundUp(_headerSize, instanceAlign);
+          this->alignment = std::max(_headerAlign, instanceAlign);
+          this->stride =
+              RoundUp(this->offset + this->layout.size, this->alignment);
+
+          const std::size_t size = this->stride * this->count;
+          this->block = static_cast<char*>(
+                this->alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ?
+                  ::operator new(size, std::align_val_t(this->alignment)) :
+                  ::operator new(size));
+        }
+
+        // The slots are all handed out by the thread which creates the
+        // instances, one for each instance.
+        assert(_headerSize == this->headerSize);
+        assert(this->next < this->count);
+
+        this->references.fetch_add(1, std::memory_order_relaxed);
+        char *slot = this->block + this->stride * this->next++;
+        *_storage = slot + this->offset;
+        return slot;
+      }
+
+      /// \brief Drop a reference to this group. It gets deleted along with
+      /// the reference of its last slot. The thread that creates the
+      /// instances holds one more reference until it is done.
+      public: void Release()
+      {
+        if (this->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          delete this;
+      }
+
+      /// \brief Round _value up to a multiple of _alignment
+      private: static std::size_t RoundUp(
+          const std::size_t _value, const std::size_t _alignment)
+      {
+        return (_value + _alignment - 1) / _alignment * _alignment;
+      }
+
+      /// \brief The reference to the shared library which keeps the
+      /// destructors of the instances available.
+      private: std::shared_ptr<void> dlHandlePtr;
+
+      /// \brief The layout of the plugin class
+      private: InstanceLayout layout;
+
+      /// \brief The number of slots
+      private: std::size_t count;
+
+      /// \brief The number of slots that have been handed out
+      private: std::size_t next = 0;
+
+      /// \brief Size of the bookkeeping at the start of each slot
+      private: std::size_t headerSize = 0;
+
+      /// \brief Distance from the start of a slot to its instance
+      private: std::size_t offset = 0;
+
+      /// \brief Distance from the start of one slot to the next
+      private: std::size_t stride = 0;
+
+      /// \brief Alignment of the block
+      private: std::size_t alignment = 0;
+
+      /// \brief The slots
+      private: char *block = nullptr;
+
+      /// \brief The slots that have not been released yet, plus one for the
+      /// thread that creates the instances
+      private: std::atomic<std::size_t> references{1};
+    };
+
+    /// \brief Allocator for std::allocate_shared which takes the next slot of
+    /// an InstanceGroup.
+    template <typename T>
+    struct GroupAllocator
+    {
+      using value_type = T;
+
+      /// \brief Constructor
+      /// \param[in] _group The group to take slots from
+      /// \param[out] _storage Receives the location of the room for the
+      /// instance once a slot has been taken.
+      public: GroupAllocator(InstanceGroup *_group, void **_storage)
+        : group(_group),
+          storage(_storage)
+      {
+        // Do nothing
+      }
+
+      /// \brief Rebinding constructor
+      public: template <typename U>
+      GroupAllocator(const GroupAllocator<U> &_other)
+        : group(_other.group),
+          storage(_other.storage)
+      {
+        // Do nothing
+      }
+
+      /// \brief Take the next slot of the group
+      public: T *allocate(const std::size_t _n)
+      {
+        return static_cast<T*>(this->group->Allocate(
+              _n * sizeof(T), alignof(T), this->storage));
+      }
+
+      /// \brief Release a slot of the group
+      public: void deallocate(T *, std::size_t)
+      {
+        this->group->Release();
+      }
+
+      /// \brief The group to take slots from
+      public: InstanceGroup *group;
+
+      /// \brief Where to put the location of the room for the instance
+      public: void **storage;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const GroupAllocator<T> &_a, const GroupAllocator<U> &_b)
+    {
+      return _a.group == _b.group;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const GroupAllocator<T> &_a, const GroupAllocator<U> &_b)
+    {
+      return !(_a == _b);
+    }
+
+    //////////////////////////////////////////////////
+    /// \brief Create a new instance of a plugin, together with everything
+    /// that keeps its shared library loaded.
+    /// \param[in] _table The interface table of the plugin
+    /// \param[in] _dlHandlePtr A reference to the dl handle that manages the
+    /// lifecycle of the plugin library, or a nullptr for a static plugin.
+    /// \param[in] _resource The memory resource to allocate the instance and
+    /// its bookkeeping from, or a nullptr to use operator new.
+    /// \return A std::shared_ptr which points at the plugin instance and
+    /// manages its lifecycle
+    std::shared_ptr<void> CreateInstance(
+        const detail::InterfaceTable &_table,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        std::pmr::memory_resource *_resource)
+    {
+      if (const InstanceLayout *layout = _table.GetLayout())
+      {
+        // Construct the instance in the same block as everything that
+        // manages it.
+        void *storage = nullptr;
+        std::shared_ptr<PluginInPlace> pluginInPlace =
+            std::allocate_shared<PluginInPlace>(
+              InstanceAllocator<PluginInPlace>(
+                *layout, &storage, _resource),
+              *layout, _dlHandlePtr);
+
+        pluginInPlace->loadedInstance = layout->construct(storage);
+
+        return std::shared_ptr<void>(
+              pluginInPlace,
+              pluginInPlace->loadedInstance);
+      }
+
+      // Create a std::shared_ptr to a struct which ensures that the
+      // _dlHandlePtr will remain alive for as long as this plugin instance
+      // exists. Only this struct can come from _resource, because the factory
+      // allocates the instance on its own.
+      const Info &info = *_table.GetInfo();
+      std::shared_ptr<PluginWithDlHandle> pluginWithDlHandle =
+          _resource ?
+            std::allocate_shared<PluginWithDlHandle>(
+              std::pmr::polymorphic_allocator<PluginWithDlHandle>(
+                _resource),
+              info.factory(), info.deleter, _dlHandlePtr) :
+            std::make_shared<PluginWithDlHandle>(
+              info.factory(), info.deleter, _dlHandlePtr);
+
+      // Use the aliasing constructor of std::shared_ptr to disguise
+      // pluginWithDlHandle as just a simple std::shared_ptr<void> which
+      // points at the plugin instance, so we have the benefit of
+      // automatically managing the lifecycle of the dlHandlePtr without
+      // needing to actually keep track of it.
+      return std::shared_ptr<void>(
+            pluginWithDlHandle,
+            pluginWithDlHandle->loadedInstance);
+    }
+
     class Plugin::Implementation
     {
       /// \brief Clear this object without invaliding any map entry
       /// iterators.
       public: void Clear()
       {
+        // Dev note: The table must be reset first, because the destructor of
+        // its Info may depend on the shared library that loadedInstancePtr is
+        // keeping loaded. See the CRUCIAL DEV NOTE on loadedInstancePtr.
+        this->table.reset();
         this->loadedInstancePtr.reset();
-        this->info.reset();
-
-        // Dev note (MXG): We must NOT call clear() on the InterfaceMap or
-        // remove ANY of the map entries, because that would potentially
-        // invalidate all of the iterators that are pointing to map entries.
-        // This would break any specialized plugins that provide instant access
-        // to specialized interfaces. Instead, we simply overwrite the map
-        // entries with a nullptr.
-        for (auto &entry : this->interfaces)
-          entry.second = nullptr;
+
+        for (SpecializedSlot *slot = this->slots; slot; slot = slot->next)
+          slot->ptr = nullptr;
       }
 
       /// \brief Initialize this object by creating a new plugin instance from
       /// the info provided.
-      /// \param[in] _info Information describing the plugin to initialize
+      /// \param[in] _table The interface table of the plugin to initialize
       /// \param[in] _dlHandlePtr A reference to the dl handle that manages the
       ///            lifecycle of the plugin library.
       /// \param[in] _allowNullDlHandlePtr Allow _dlHandlePtr to be null. Only
       ///            set true for plugin instances created from the static
       ///            registry.
+      /// \param[in] _resource The memory resource to allocate the instance
+      ///            and its bookkeeping from, or a nullptr to use operator
+      ///            new.
       public: void Create(
-          const ConstInfoPtr &_info,
+          const detail::ConstInterfaceTablePtr &_table,
           const std::shared_ptr<void> &_dlHandlePtr,
-          bool _allowNullDlHandlePtr = false)
+          bool _allowNullDlHandlePtr,
+          std::pmr::memory_resource *_resource)
       {
         this->Clear();
 
-        if (!_info)
+        if (!_table || !_table->GetInfo())
           return;
 
-        this->info = _info;
+        const ConstInfoPtr &info = _table->GetInfo();
+        this->table = _table;
 
         if (!_dlHandlePtr && !_allowNullDlHandlePtr)
         {
           // LCOV_EXCL_START
-          std::cerr << "Received Info for [" << _info->name << "], "
+          std::cerr << "Received Info for [" << info->name << "], "
                     << "but we were not provided a shared library handle. "
                     << "This should never happen! Please report this bug!\n";
           assert(false);
@@ -159,40 +568,17 @@ namespace gz
           assert(false);
         }
 
-        // Create a std::shared_ptr to a struct which ensures that the
-        // _dlHandlePtr will remain alive for as long as this plugin instance
-        // exists.
-        std::shared_ptr<PluginWithDlHandle> pluginWithDlHandle =
-            std::make_shared<PluginWithDlHandle>(
-              _info->factory(), _info->deleter, _dlHandlePtr);
-
-        // Use the aliasing constructor of std::shared_ptr to disguise
-        // pluginWithDlHandle as just a simple std::shared_ptr<void> which
-        // points at the plugin instance, so we have the benefit of
-        // automatically managing the lifecycle of the dlHandlePtr without
-        // needing to actually keep track of it.
         this->loadedInstancePtr =
-            std::shared_ptr<void>(
-              pluginWithDlHandle,
-              pluginWithDlHandle->loadedInstance);
+            CreateInstance(*_table, _dlHandlePtr, _resource);
 
-        for (const auto &entry : _info->interfaces)
-        {
-          // entry.first:  name of the interface
-          // entry.second: function which casts the loadedInstance pointer to
-          //               the correct location of the interface within the
-          //               plugin
-          this->interfaces[entry.first] =
-              entry.second(this->loadedInstancePtr.get());
-        }
+        this->table->Locate(this->loadedInstancePtr.get());
+        this->UpdateSlots();
       }
 
       /// \brief Initialize this object using another instance
       /// \param[in] _other Another instance of a Plugin::Implementation object
       public: void Copy(const Implementation *_other)
       {
-        this->Clear();
-
         if (!_other)
         {
           // LCOV_EXCL_START
@@ -205,40 +591,27 @@ namespace gz
           // LCOV_EXCL_STOP
         }
 
-        this->loadedInstancePtr = _other->loadedInstancePtr;
-        this->info = _other->info;
-
-        if (this->loadedInstancePtr)
-        {
-          for (const auto &entry : _other->interfaces)
-          {
-            // entry.first:  name of the interface
-            // entry.second: pointer to the location of that interface within
-            //               the plugin instance
-            this->interfaces[entry.first] = entry.second;
-          }
-        }
+        this->Copy(_other->table, _other->loadedInstancePtr);
       }
 
       /// \brief Initialize this object using another instance
-      /// \param[in] _info
-      ///   A reference to the plugin's Info
+      /// \param[in] _table
+      ///   The interface table of the plugin
       /// \param[in] _instance
       ///   A reference to the plugin's abstract instance
-      public: void Copy(const ConstInfoPtr &_info,
+      public: void Copy(const detail::ConstInterfaceTablePtr &_table,
                         const std::shared_ptr<void> &_instance)
       {
-        this->loadedInstancePtr = _instance;
-        this->info = _info;
+        this->Clear();
 
-        if (this->loadedInstancePtr)
+        if (_instance)
         {
-          if (!this->info)
+          if (!_table)
           {
             // LCOV_EXCL_START
-            std::cerr << "[Plugin::Implementation::Copy(_info, _instance)] A "
-                      << "Plugin has been copied from its info and instance, "
-                      << "but the info was null even though the instance was "
+            std::cerr << "[Plugin::Implementation::Copy(_table, _instance)] A "
+                      << "Plugin has been copied from its table and instance, "
+                      << "but the table was null even though the instance was "
                       << "valid. This should never happen! Please report this "
                       << "bug!" << std::endl;
             assert(false);
@@ -246,60 +619,63 @@ namespace gz
             // LCOV_EXCL_STOP
           }
 
-          // We need to construct the interface map for this Plugin
-          for (const auto &entry : this->info->interfaces)
-          {
-            // entry.first:  name of the interface
-            // entry.second: function which casts the loadedInstance pointer to
-            //               the correct location of the interface within the
-            //               plugin
-            this->interfaces[entry.first] =
-                entry.second(this->loadedInstancePtr.get());
-          }
+          this->loadedInstancePtr = _instance;
+          this->table = _table;
+          this->table->Locate(this->loadedInstancePtr.get());
+          this->UpdateSlots();
         }
       }
 
-      /// \brief Map from interface names to their locations within the plugin
-      /// instance
-      //
-      // Dev Note (MXG): We use std::map here instead of std::unordered_map
-      // because iterators to a std::map are not invalidated by the insertion
-      // operation (whereas all iterators to a std::unordered_map are
-      // potentially invalidated each time an insertion is performed on the
-      // std::unordered_map). Holding onto valid iterators allows us to do
-      // optimizations with template magic to provide direct access to
-      // interfaces whose availability we can anticipate at run time.
-      //
-      // It is also worth noting that ordered vs unordered lookup time is very
-      // similar on sets where the strings have relatively small lengths (5-20
-      // characters) and a relatively small number of entries in the set (5-20
-      // entries). Those conditions match our expected use case here. In fact,
-      // ordered lookup can sometimes outperform unordered in these conditions.
-      public: Plugin::InterfaceMap interfaces;
+      /// \brief Point the slots of the specialized interfaces at the current
+      /// instance. Only specialized plugins have slots, so this is usually
+      /// nothing at all.
+      public: void UpdateSlots()
+      {
+        for (SpecializedSlot *slot = this->slots; slot; slot = slot->next)
+          this->UpdateSlot(*slot);
+      }
+
+      /// \brief Point one slot at the current instance
+      /// \param[in,out] _slot The slot of a specialized interface
+      public: void UpdateSlot(SpecializedSlot &_slot) const
+      {
+        _slot.ptr = this->table ? this->table->Find(
+              this->loadedInstancePtr.get(), _slot.name,
+              _slot.id->hash, _slot.id->ambiguous) : nullptr;
+      }
+
+      /// \brief The first of the slots of the specialized interfaces. Each
+      /// slot lives inside of the SpecializedPlugin that added it, so the
+      /// specialized interfaces do not need any allocations of their own.
+      /// Interfaces which are not specialized are looked up in `table`
+      /// instead.
+      public: SpecializedSlot *slots = nullptr;
 
       /// \brief shared_ptr which manages the lifecycle of the plugin instance.
       ///
-      /// CRUCIAL DEV NOTE (MXG): `loadedInstancePtr` must come BEFORE `info` in
-      /// this class definition to ensure that `info` gets deleted first (member
-      /// variables get destructed in the reverse order of their appearance in
-      /// the class definition). The destructor of `info` depends on the shared
-      /// library still being available, so this reference counting handle must
-      /// be destroyed after `info` to ensure that the library is still loaded
-      /// when `info` needs it.
+      /// CRUCIAL DEV NOTE (MXG): `loadedInstancePtr` must come BEFORE `table`
+      /// in this class definition to ensure that `table` gets deleted first
+      /// (member variables get destructed in the reverse order of their
+      /// appearance in the class definition). The table holds the Info, whose
+      /// destructor depends on the shared library still being available, so
+      /// this reference counting handle must be destroyed after `table` to
+      /// ensure that the library is still loaded when the Info needs it.
       ///
       /// If you change this class definition for ANY reason, be sure to
       /// maintain the ordering of these member variables.
       public: std::shared_ptr<void> loadedInstancePtr;
 
-      /// \brief A copy of the Info that was used to create the Plugin
+      /// \brief The interface table of the plugin, which is shared by all of
+      /// its instances. It also holds the Info that was used to create the
+      /// Plugin.
       ///
-      /// CRUCIAL DEV NOTE (MXG): `info` must come AFTER `loadedInstancePtr` in
-      /// this class definition. See the comment on `loadedInstancePtr` for an
-      /// explanation.
+      /// CRUCIAL DEV NOTE (MXG): `table` must come AFTER `loadedInstancePtr`
+      /// in this class definition. See the comment on `loadedInstancePtr` for
+      /// an explanation.
       ///
       /// If you change this class definition for ANY reason, be sure to
       /// maintain the ordering of these member variables.
-      public: ConstInfoPtr info;
+      public: detail::ConstInterfaceTablePtr table;
     };
 
     //////////////////////////////////////////////////
@@ -307,7 +683,7 @@ namespace gz
         const std::string &_interfaceName,
         const bool _demangled) const
     {
-      const ConstInfoPtr &info = this->dataPtr->info;
+      const ConstInfoPtr &info = this->PrivateGetInfoPtr();
       if (!info)
         return false;
 
@@ -316,16 +692,18 @@ namespace gz
         return (info->demangledInterfaces.count(_interfaceName) != 0);
       }
 
-      return (this->dataPtr->interfaces.count(_interfaceName) != 0);
+      return (nullptr != this->dataPtr->table->Find(
+                this->dataPtr->loadedInstancePtr.get(), _interfaceName));
     }
 
     //////////////////////////////////////////////////
     const std::string *Plugin::Name() const
     {
-      if (!this->dataPtr->info)
+      const ConstInfoPtr &info = this->PrivateGetInfoPtr();
+      if (!info)
         return nullptr;
 
-      return &this->dataPtr->info->name;
+      return &info->name;
     }
 
     //////////////////////////////////////////////////
@@ -339,11 +717,24 @@ namespace gz
     void *Plugin::PrivateQueryInterface(
         const std::string &_interfaceName) const
     {
-      const auto &it = this->dataPtr->interfaces.find(_interfaceName);
-      if (this->dataPtr->interfaces.end() == it)
+      if (!this->dataPtr->table)
         return nullptr;
 
-      return it->second;
+      return this->dataPtr->table->Find(
+            this->dataPtr->loadedInstancePtr.get(), _interfaceName);
+    }
+
+    //////////////////////////////////////////////////
+    void *Plugin::PrivateQueryInterface(
+        const char *_interfaceName,
+        const InterfaceId &_id) const
+    {
+      if (!this->dataPtr->table)
+        return nullptr;
+
+      return this->dataPtr->table->Find(
+            this->dataPtr->loadedInstancePtr.get(),
+            _interfaceName, _id.hash, _id.ambiguous);
     }
 
     //////////////////////////////////////////////////
@@ -354,26 +745,99 @@ namespace gz
 
     //////////////////////////////////////////////////
     void Plugin::PrivateCopyPluginInstance(
-        const ConstInfoPtr &_info,
+        const detail::ConstInterfaceTablePtr &_table,
         const std::shared_ptr<void> &_instancePtr) const
     {
-      this->dataPtr->Copy(_info, _instancePtr);
+      this->dataPtr->Copy(_table, _instancePtr);
     }
 
     //////////////////////////////////////////////////
     void Plugin::PrivateCreatePluginInstance(
-        const ConstInfoPtr &_info,
-        const std::shared_ptr<void> &_dlHandlePtr) const
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        std::pmr::memory_resource *_resource) const
     {
-      this->dataPtr->Create(_info, _dlHandlePtr);
+      this->dataPtr->Create(_table, _dlHandlePtr,
+          /*_allowNullDlHandlePtr=*/false, _resource);
     }
 
     //////////////////////////////////////////////////
     void Plugin::PrivateCreateStaticPluginInstance(
-        const ConstInfoPtr &_info) const
+        const detail::ConstInterfaceTablePtr &_table,
+        std::pmr::memory_resource *_resource) const
     {
-      this->dataPtr->Create(_info, /*_dlHandlePtr=*/nullptr,
-          /*_allowNullDlHandlePtr=*/true);
+      this->dataPtr->Create(_table, /*_dlHandlePtr=*/nullptr,
+          /*_allowNullDlHandlePtr=*/true, _resource);
+    }
+
+    //////////////////////////////////////////////////
+    std::vector<std::shared_ptr<void>> Plugin::PrivateCreatePluginInstances(
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_dlHandlePtr,
+        const std::size_t _count)
+    {
+      std::vector<std::shared_ptr<void>> instances;
+      if (!_table || !_table->GetInfo() || 0 == _count)
+        return instances;
+
+      instances.reserve(_count);
+
+      const InstanceLayout *layout = _table->GetLayout();
+      if (!layout)
+      {
+        // The instances can only come from the factory of the plugin, so they
+        // cannot be placed next to each other.
+        const Info &info = *_table->GetInfo();
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          std::shared_ptr<PluginWithDlHandle> pluginWithDlHandle =
+              std::make_shared<PluginWithDlHandle>(
+                info.factory(), info.deleter, _dlHandlePtr);
+
+          instances.emplace_back(
+                pluginWithDlHandle, pluginWithDlHandle->loadedInstance);
+        }
+
+        return instances;
+      }
+
+      // Make sure that the reference of this thread gets dropped, even if a
+      // constructor throws.
+      struct GroupReleaser
+      {
+        public: ~GroupReleaser() { group->Release(); }
+        public: InstanceGroup *group;
+      };
+      const GroupReleaser releaser{
+        new InstanceGroup(*layout, _dlHandlePtr, _count)};
+
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        // Each instance only needs the one library reference of the group.
+        void *storage = nullptr;
+        std::shared_ptr<PluginInPlace> pluginInPlace =
+            std::allocate_shared<PluginInPlace>(
+              GroupAllocator<PluginInPlace>(releaser.group, &storage),
+              *layout, nullptr);
+
+        pluginInPlace->loadedInstance = layout->construct(storage);
+
+        instances.emplace_back(
+              pluginInPlace, pluginInPlace->loadedInstance);
+      }
+
+      return instances;
+    }
+
+    //////////////////////////////////////////////////
+    std::shared_ptr<void> Plugin::PrivateCreateDetachedInstance(
+        const detail::ConstInterfaceTablePtr &_table,
+        const std::shared_ptr<void> &_dlHandlePtr)
+    {
+      if (!_table || !_table->GetInfo())
+        return nullptr;
+
+      return CreateInstance(*_table, _dlHandlePtr, nullptr);
     }
 
     //////////////////////////////////////////////////
@@ -385,17 +849,26 @@ namespace gz
     //////////////////////////////////////////////////
     const ConstInfoPtr &Plugin::PrivateGetInfoPtr() const
     {
-      return this->dataPtr->info;
+      static const ConstInfoPtr noInfo;
+      if (!this->dataPtr->table)
+        return noInfo;
+
+      return this->dataPtr->table->GetInfo();
+    }
+
+    //////////////////////////////////////////////////
+    const detail::ConstInterfaceTablePtr &
+    Plugin::PrivateGetInterfaceTable() const
+    {
+      return this->dataPtr->table;
     }
 
     //////////////////////////////////////////////////
-    Plugin::InterfaceMap::iterator Plugin::PrivateGetOrCreateIterator(
-        const std::string &_interfaceName)
+    void Plugin::PrivateAddSpecializedSlot(SpecializedSlot &_slot)
     {
-      // We want to use the insert function here to avoid accidentally
-      // overwriting a value which might exist at the desired map key.
-      return this->dataPtr->interfaces.insert(
-            std::make_pair(_interfaceName, nullptr)).first;
+      this->dataPtr->UpdateSlot(_slot);
+      _slot.next = this->dataPtr->slots;
+      this->dataPtr->slots = &_slot;
     }
 
     //////////////////////////////////////////////////
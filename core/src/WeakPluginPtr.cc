@@ -15,6 +15,8 @@
  *
  */
 
+#include <utility>
+
 #include <gz/plugin/WeakPluginPtr.hh>
 
 namespace gz
@@ -24,8 +26,12 @@ namespace gz
     /////////////////////////////////////////////////
     class WeakPluginPtr::Implementation
     {
+      /// \brief The plugin wrapper of the PluginPtr. Lock() can share it
+      /// instead of making a new one as long as some PluginPtr still holds it.
+      public: std::weak_ptr<Plugin> plugin;
+
       public: std::weak_ptr<void> instance;
-      public: std::weak_ptr<const Info> info;
+      public: std::weak_ptr<const detail::InterfaceTable> table;
     };
 
     /////////////////////////////////////////////////
@@ -73,28 +79,38 @@ namespace gz
     /////////////////////////////////////////////////
     WeakPluginPtr &WeakPluginPtr::operator=(const PluginPtr &_ptr)
     {
+      this->pimpl->plugin = _ptr.dataPtr;
       this->pimpl->instance = _ptr->PrivateGetInstancePtr();
-      this->pimpl->info = _ptr->PrivateGetInfoPtr();
+      this->pimpl->table = _ptr->PrivateGetInterfaceTable();
       return *this;
     }
 
     /////////////////////////////////////////////////
     PluginPtr WeakPluginPtr::Lock() const
     {
+      // As long as some PluginPtr still holds the plugin wrapper, we can simply
+      // share it.
+      std::shared_ptr<Plugin> plugin = this->pimpl->plugin.lock();
+      if (plugin)
+        return PluginPtr(std::move(plugin));
+
       // CRUCIAL DEV NOTE (MXG): We must lock the instance before the info.
       // We must never allow info to get deleted before the plugin instance,
       // because otherwise the library might get unloaded before the info is
       // destructed, but the Info's destructor depends on the library.
       // TODO(MXG): Consider ways to make this less fragile.
       std::shared_ptr<void> instance = this->pimpl->instance.lock();
-      ConstInfoPtr info = this->pimpl->info.lock();
+      detail::ConstInterfaceTablePtr table = this->pimpl->table.lock();
+
+      if (!instance || !table)
+        return PluginPtr();
 
-      PluginPtr ptr;
       // NOTE(MXG): We do not want to make a PluginPtr constructor overload for
       // this, because its signature would be too easily confused with the
       // constructor that takes a ConstInfoPtr and a std::shared_ptr<void> to a
       // dl handle. Using an explicitly named function avoids any ambiguity.
-      ptr->PrivateCopyPluginInstance(info, instance);
+      PluginPtr ptr(PluginPtr::PrivateMakeWrapper());
+      ptr->PrivateCopyPluginInstance(table, instance);
 
       return ptr;
     }
@@ -108,9 +124,9 @@ namespace gz
       // destructed, but the Info's destructor depends on the library.
       // TODO(MXG): Consider ways to make this less fragile.
       std::shared_ptr<void> instance = this->pimpl->instance.lock();
-      ConstInfoPtr info = this->pimpl->info.lock();
+      detail::ConstInterfaceTablePtr table = this->pimpl->table.lock();
 
-      return !(instance && info);
+      return !(instance && table);
     }
 
     /////////////////////////////////////////////////
@@ -17,8 +17,11 @@
 
 #include <cassert>
 #include <iostream>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 #if defined(__GNUC__) || defined(__clang__)
 // This header is used for name demangling on GCC and Clang
@@ -31,6 +34,68 @@ namespace gz
 {
   namespace plugin
   {
+    namespace
+    {
+      /////////////////////////////////////////////////
+      /// \brief The first interface name that was registered with a given
+      /// hash
+      struct InterfaceIdRecord
+      {
+        std::string name;
+        std::atomic<bool> ambiguous{false};
+      };
+
+      /////////////////////////////////////////////////
+      struct InterfaceIdTable
+      {
+        std::mutex mutex;
+
+        // The nodes of a std::unordered_map never move, so the ambiguous
+        // flags that we hand out stay valid.
+        std::unordered_map<std::uint64_t, InterfaceIdRecord> records;
+      };
+
+      /////////////////////////////////////////////////
+      InterfaceIdTable &GetInterfaceIdTable()
+      {
+        // Dev note: This is intentionally never destroyed. Plugins may be
+        // used during static destruction, and their IDs must still be valid.
+        static InterfaceIdTable *table = new InterfaceIdTable;
+        return *table;
+      }
+    }
+
+    /////////////////////////////////////////////////
+    InterfaceId RegisterInterfaceId(const char *_interfaceName)
+    {
+      const std::uint64_t hash = detail::HashInterfaceName(_interfaceName);
+
+      InterfaceIdTable &table = GetInterfaceIdTable();
+      std::lock_guard<std::mutex> lock(table.mutex);
+
+      auto inserted = table.records.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(hash),
+            std::forward_as_tuple());
+
+      InterfaceIdRecord &record = inserted.first->second;
+      if (inserted.second)
+      {
+        record.name = _interfaceName;
+      }
+      else if (record.name != _interfaceName
+               && !record.ambiguous.load(std::memory_order_relaxed))
+      {
+        std::cerr << "[gz::plugin::RegisterInterfaceId] The interfaces ["
+                  << record.name << "] and [" << _interfaceName << "] have "
+                  << "the same ID [" << hash << "]. Their names will be "
+                  << "compared whenever one of them is queried.\n";
+        record.ambiguous.store(true, std::memory_order_release);
+      }
+
+      return InterfaceId{hash, &record.ambiguous};
+    }
+
     /////////////////////////////////////////////////
     std::string DemangleSymbol(const std::string &_symbol)
     {
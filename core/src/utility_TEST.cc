@@ -80,3 +80,28 @@ TEST(Demangle, FakeSymbol)
   // will skip this test.
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST(InterfaceId, Consistent)
+{
+  // The IDs must not depend on where they are computed, so the hash is pinned
+  // to the reference values of 64-bit FNV-1a.
+  static_assert(detail::HashInterfaceName("") == 0xcbf29ce484222325ull,
+                "Unexpected hash of an empty name");
+  static_assert(detail::HashInterfaceName("a") == 0xaf63dc4c8601ec8cull,
+                "Unexpected hash of a one-character name");
+
+  const InterfaceId &id = InterfaceIdOf<SomeSymbol>();
+  EXPECT_EQ(detail::HashInterfaceName(typeid(SomeSymbol).name()), id.hash);
+  EXPECT_EQ(&id, &InterfaceIdOf<SomeSymbol>());
+  ASSERT_NE(nullptr, id.ambiguous);
+  EXPECT_FALSE(id.ambiguous->load());
+
+  // Registering the same name again must not be mistaken for a clash
+  const InterfaceId again = RegisterInterfaceId(typeid(SomeSymbol).name());
+  EXPECT_EQ(id.hash, again.hash);
+  EXPECT_EQ(id.ambiguous, again.ambiguous);
+  EXPECT_FALSE(id.ambiguous->load());
+
+  EXPECT_NE(id.hash, InterfaceIdOf<SomeTemplate<SomeSymbol>>().hash);
+}
@@ -19,11 +19,14 @@
 #ifndef GZ_PLUGIN_LOADER_HH_
 #define GZ_PLUGIN_LOADER_HH_
 
+#include <future>
 #include <memory>
+#include <memory_resource>
 #include <set>
 #include <string>
 #include <typeinfo>
 #include <unordered_set>
+#include <vector>
 
 #include <gz/utils/SuppressWarning.hh>
 
@@ -34,7 +37,18 @@ namespace gz
 {
   namespace plugin
   {
+    // Forward declaration
+    class ManifestCache;
+
     /// \brief Class for loading plugins
+    ///
+    /// A Loader may be used by several threads at once. The functions which
+    /// only query the Loader, including Instantiate(~), never wait for the
+    /// functions that change it. They work on an immutable snapshot of the
+    /// loaded plugins, which LoadLib(~), DiscoverLib(~) and ForgetLibrary(~)
+    /// replace atomically, so a query sees the plugins of a library either
+    /// completely or not at all. Taking a snapshot uses std::atomic_load,
+    /// which may briefly lock a mutex internal to the standard library.
     class GZ_PLUGIN_LOADER_VISIBLE Loader
     {
       /// \brief Constructor
@@ -144,8 +158,100 @@ namespace gz
       public: std::unordered_set<std::string> LoadLib(
                   const std::string &_pathToLibrary, bool _noDelete);
 
+      /// \brief Load a batch of libraries.
+      ///
+      /// The file readahead, dlopen, plugin hook query and symbol demangling
+      /// of the libraries are spread across a pool of worker threads. Once
+      /// they are done, the results get registered with this Loader all at
+      /// once, in the order that the paths were given. The resulting state of
+      /// the Loader is the same as calling LoadLib(~) on each path in
+      /// sequence.
+      ///
+      /// If an exception is thrown while a library is being opened or
+      /// registered, the libraries before it stay loaded, while the ones
+      /// after it are closed again without being registered. The exception
+      /// is passed on once every worker thread has stopped.
+      ///
+      /// \param[in] _pathsToLibraries
+      ///   The paths to the libraries
+      /// \param[in] _noDelete
+      ///   If true, RTLD_NODELETE will be used when loading the libraries.
+      ///
+      /// \returns The set of plugins that have been loaded from each library.
+      /// The sets are in the same order as _pathsToLibraries, and the set of a
+      /// library that could not be loaded will be empty.
+      public: std::vector<std::unordered_set<std::string>> LoadLibs(
+                  const std::vector<std::string> &_pathsToLibraries,
+                  bool _noDelete = false);
+
+      /// \brief Load a batch of libraries in the background.
+      ///
+      /// This runs LoadLibs(~) on a separate thread. The Loader may be used
+      /// in the meantime, and the libraries become visible once the batch has
+      /// been registered. The Loader must not be destroyed until the returned
+      /// future is ready.
+      ///
+      /// \param[in] _pathsToLibraries
+      ///   The paths to the libraries
+      /// \param[in] _noDelete
+      ///   If true, RTLD_NODELETE will be used when loading the libraries.
+      ///
+      /// \returns A future for the result of LoadLibs(~)
+      public: std::future<std::vector<std::unordered_set<std::string>>>
+      LoadLibsAsync(
+          const std::vector<std::string> &_pathsToLibraries,
+          bool _noDelete = false);
+
+      /// \brief Attach a manifest cache to this Loader. While a cache is
+      /// attached, the plugin metadata of every library that gets loaded will
+      /// be stored in it, and DiscoverLib(~) will use it to avoid loading
+      /// libraries.
+      ///
+      /// \param[in] _cache
+      ///   The cache to use, or a nullptr to stop using a cache.
+      public: void SetManifestCache(
+                  const std::shared_ptr<ManifestCache> &_cache);
+
+      /// \brief Learn about the plugins of the library at the given path.
+      ///
+      /// If the attached manifest cache has an up-to-date entry for the
+      /// library, the plugins will be registered lazily from that entry
+      /// without opening the library. Their names, aliases and interfaces can
+      /// be queried as usual, and the library will only be loaded the first
+      /// time that one of its plugins gets instantiated. That first
+      /// instantiation may safely happen on several threads at once.
+      ///
+      /// Otherwise, if the library carries the metadata that the plugin
+      /// registration macros embed into it, the plugins will be registered
+      /// lazily from that metadata, which is read from the file without
+      /// loading it. The metadata is only used when all of it can be
+      /// understood, e.g. every alias is a string literal and every type name
+      /// is a plain (non-template) class name. The result is also stored in
+      /// the attached manifest cache, if there is one.
+      ///
+      /// Otherwise this is the same as calling LoadLib(~).
+      ///
+      /// \param[in] _pathToLibrary
+      ///   The path to a library
+      /// \param[in] _noDelete
+      ///   If true, RTLD_NODELETE will be used when the library gets loaded.
+      ///
+      /// \returns The set of plugins that the library provides
+      public: std::unordered_set<std::string> DiscoverLib(
+                  const std::string &_pathToLibrary,
+                  bool _noDelete = false);
+
       /// \brief Instantiates a plugin for the given plugin name
       ///
+      /// If the plugin has an instance pool (see WarmPool(~)), the instance
+      /// is taken from the pool when it has one ready, and otherwise a new
+      /// instance is constructed which will be offered back to the pool.
+      ///
+      /// If the plugin was registered with GZ_ADD_PLUGIN_SHARED, then it is
+      /// only constructed the first time, and every PluginPtr refers to that
+      /// one instance. Shared plugins never use an instance pool or a memory
+      /// resource.
+      ///
       /// \param[in] _pluginNameOrAlias
       ///   Name or alias of the plugin to instantiate.
       ///
@@ -153,6 +259,30 @@ namespace gz
       public: PluginPtr Instantiate(
           const std::string &_pluginNameOrAlias) const;
 
+      /// \brief Instantiates a plugin for the given plugin name, allocating
+      /// the plugin instance and its bookkeeping from a memory resource. This
+      /// makes it possible to create many short-lived instances from an arena,
+      /// such as a std::pmr::monotonic_buffer_resource, and release them all
+      /// at once.
+      ///
+      /// Every PluginPtr, WeakPluginPtr and shared_ptr to an interface of the
+      /// instance must be gone before the resource releases its memory. If the
+      /// plugin class has its own operator new, or its library was built
+      /// against older headers, then the instance itself still comes from its
+      /// factory and only the bookkeeping comes from the resource.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin to instantiate.
+      ///
+      /// \param[in] _resource
+      ///   The memory resource to allocate from. If this is a nullptr, then
+      ///   operator new is used like in Instantiate(_pluginNameOrAlias).
+      ///
+      /// \returns Pointer to instantiated plugin
+      public: PluginPtr Instantiate(
+          const std::string &_pluginNameOrAlias,
+          std::pmr::memory_resource *_resource) const;
+
       /// \brief Instantiates a plugin of PluginType for the given plugin name.
       /// This can be used to create a specialized PluginPtr.
       ///
@@ -167,14 +297,73 @@ namespace gz
       public: template <typename PluginPtrType>
       PluginPtrType Instantiate(const std::string &_pluginNameOrAlias) const;
 
-      /// \brief Instantiates a plugin for the given plugin name, and then
+      /// \brief Instantiates a plugin many times at once. The plugin is only
+      /// looked up once, and the instances are allocated next to each other
+      /// where the plugin allows it. All of the instances share one reference
+      /// to the library of the plugin.
+      ///
+      /// Each instance is still destroyed as soon as nothing refers to it
+      /// anymore, but the memory of the instances is only released once all
+      /// of them have been destroyed.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin to instantiate.
+      ///
+      /// \param[in] _count
+      ///   The number of instances to create.
+      ///
+      /// \returns Pointers to the new instances, or an empty vector if the
+      /// plugin could not be found. If the plugin is shared, they all point to
+      /// its one instance.
+      public: std::vector<PluginPtr> InstantiateMany(
+          const std::string &_pluginNameOrAlias,
+          std::size_t _count) const;
+
+      /// \brief Instantiates a plugin many times at once as specialized
+      /// PluginPtrs.
+      ///
+      /// \tparam PluginPtrType
+      ///   The specialized type of PluginPtr that you want to construct.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin to instantiate.
+      ///
+      /// \param[in] _count
+      ///   The number of instances to create.
+      ///
+      /// \returns Pointers to the new instances, or an empty vector if the
+      /// plugin could not be found.
+      ///
+      /// \sa InstantiateMany(const std::string&, std::size_t) const
+      public: template <typename PluginPtrType>
+      std::vector<PluginPtrType> InstantiateMany(
+          const std::string &_pluginNameOrAlias,
+          std::size_t _count) const;
+
+      /// \brief Gets an instance of the plugin with the given name, and then
       /// returns a reference-counting interface corresponding to InterfaceType.
       ///
       /// If you use this function to retrieve a Factory, you can call
       /// Construct(...) on the returned interface, as long as the returned
       /// interface is not a nullptr.
       ///
-      /// \remark This function is identical to:
+      /// The plugin is only instantiated the first time. This Loader keeps
+      /// that instance, and every later call for the same plugin (by its name
+      /// or by any of its aliases) returns an interface of it, so that
+      /// `loader.Factory<F>(name)->Construct(...)` does not create a new
+      /// factory for every product. The instance is dropped by this Loader
+      /// when the library of the plugin is forgotten. When another library is
+      /// loaded or discovered, only the names and aliases that its plugins
+      /// take over stop referring to the instance. Use Instantiate(~) to get
+      /// a separate instance.
+      ///
+      /// The plugin is resolved (which may load the library of a discovered
+      /// plugin) and instantiated without blocking the other users of this
+      /// Loader, so its constructor may use this Loader. If several threads
+      /// ask for a plugin which is not cached yet, each of them might
+      /// instantiate it, but they all get the same instance.
+      ///
+      /// \remark The first call for a plugin is identical to:
       ///
       /// \code
       /// loader->Instantiate(_pluginNameOrAlias)
@@ -194,6 +383,220 @@ namespace gz
       std::shared_ptr<InterfaceType> Factory(
           const std::string &_pluginNameOrAlias) const;
 
+      /// \brief Keeps instances of a plugin ready to be handed out
+      private: class InstancePool;
+
+      /// \brief A plugin that has been looked up by Resolve(~). It can be
+      /// instantiated any number of times without looking up the plugin
+      /// again.
+      ///
+      /// Just like a PluginPtr, a ResolvedPlugin keeps the library of its
+      /// plugin loaded. It stays valid even after the Loader that produced it
+      /// forgets the library, or after that Loader is destroyed.
+      public: class GZ_PLUGIN_LOADER_VISIBLE ResolvedPlugin
+      {
+        /// \brief Default constructor. Creates a ResolvedPlugin which does
+        /// not refer to any plugin.
+        public: ResolvedPlugin() = default;
+
+        /// \brief Instantiate the plugin. If the plugin had an instance pool
+        /// when it was resolved, the instance comes from that pool.
+        ///
+        /// \return Pointer to the new instance of the plugin, or an empty
+        /// PluginPtr if this does not refer to any plugin.
+        public: PluginPtr Instantiate() const;
+
+        /// \brief Instantiate the plugin, allocating the instance and its
+        /// bookkeeping from a memory resource.
+        ///
+        /// \param[in] _resource The memory resource to allocate from, or a
+        /// nullptr to use operator new
+        ///
+        /// \return Pointer to the new instance of the plugin, or an empty
+        /// PluginPtr if this does not refer to any plugin.
+        ///
+        /// \sa Loader::Instantiate(const std::string&,
+        /// std::pmr::memory_resource*) const
+        public: PluginPtr Instantiate(
+            std::pmr::memory_resource *_resource) const;
+
+        /// \brief Instantiate the plugin many times at once.
+        ///
+        /// \param[in] _count The number of instances to create
+        ///
+        /// \return Pointers to the new instances, or an empty vector if this
+        /// does not refer to any plugin.
+        ///
+        /// \sa Loader::InstantiateMany(const std::string&, std::size_t) const
+        public: std::vector<PluginPtr> InstantiateMany(
+            std::size_t _count) const;
+
+        /// \brief Instantiate the plugin many times at once as specialized
+        /// PluginPtrs.
+        ///
+        /// \tparam PluginPtrType
+        ///   The specialized type of PluginPtr that you want to construct.
+        ///
+        /// \param[in] _count The number of instances to create
+        ///
+        /// \return Pointers to the new instances, or an empty vector if this
+        /// does not refer to any plugin.
+        public: template <typename PluginPtrType>
+        std::vector<PluginPtrType> InstantiateMany(std::size_t _count) const;
+
+        /// \brief Instantiate the plugin as a specialized PluginPtr.
+        ///
+        /// \tparam PluginPtrType
+        ///   The specialized type of PluginPtr that you want to construct.
+        ///
+        /// \return Pointer to the new instance of the plugin
+        public: template <typename PluginPtrType>
+        PluginPtrType Instantiate() const;
+
+        /// \brief Get the name of the plugin
+        ///
+        /// \return The name of the plugin, or an empty string if this does
+        /// not refer to any plugin.
+        public: std::string Name() const;
+
+        /// \brief Check whether this refers to a plugin.
+        ///
+        /// \return True if this refers to a plugin.
+        public: explicit operator bool() const;
+
+        /// \brief Check whether the plugin was registered with
+        /// GZ_ADD_PLUGIN_SHARED or GZ_ADD_STATIC_PLUGIN_SHARED, so that all
+        /// of its users get the same instance.
+        ///
+        /// \return True if the plugin is shared
+        public: bool IsShared() const;
+
+        /// \brief Get the one instance of a shared plugin, creating it if
+        /// this is the first time.
+        ///
+        /// \return The shared instance
+        private: std::shared_ptr<void> PrivateGetSharedInstance() const;
+
+        // Declare friendship
+        friend class Loader;
+
+        GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+        /// \brief Object that keeps the library of the plugin loaded. This is
+        /// a nullptr for static plugins.
+        ///
+        /// CRUCIAL DEV NOTE: `library` MUST come BEFORE `table` so that the
+        /// Info gets destructed while the library is still loaded.
+        private: std::shared_ptr<void> library;
+
+        /// \brief The interface table of the plugin, which holds its Info
+        private: detail::ConstInterfaceTablePtr table;
+
+        /// \brief The instance pool of the plugin, if it has one
+        private: std::shared_ptr<InstancePool> pool;
+        GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+        /// \brief True if the plugin implements EnablePluginFromThis
+        private: bool enablePluginFromThis = false;
+
+        /// \brief True if the plugin was registered as shared
+        private: bool shared = false;
+      };
+
+      /// \brief Counters of the instance pool of a plugin
+      public: struct PoolStats
+      {
+        /// \brief Number of instances that were handed out by the pool
+        /// without constructing them
+        std::size_t hits = 0;
+
+        /// \brief Number of instances that had to be constructed because
+        /// the pool had none ready
+        std::size_t misses = 0;
+
+        /// \brief Number of instances that were taken back by the pool after
+        /// they were reset
+        std::size_t recycled = 0;
+
+        /// \brief Number of instances that are ready to be handed out
+        std::size_t idle = 0;
+
+        /// \brief The largest number of instances that the pool keeps ready
+        std::size_t capacity = 0;
+      };
+
+      /// \brief Keep up to _capacity instances of a plugin constructed and
+      /// ready to be handed out by Instantiate(~), and construct them now.
+      ///
+      /// Once the last PluginPtr of an instance from the pool is gone, the
+      /// instance is reset and taken back by the pool if the plugin provides
+      /// the Resettable interface and the pool is not full. Otherwise the
+      /// instance gets deleted as usual.
+      ///
+      /// The pool is only used by Instantiate(~) without a memory resource,
+      /// and by the ResolvedPlugins that are resolved after it was created.
+      /// It is removed when the library of the plugin is forgotten. Shared
+      /// plugins (see GZ_ADD_PLUGIN_SHARED) cannot have a pool.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin.
+      ///
+      /// \param[in] _capacity
+      ///   The largest number of instances to keep ready. If this is zero, the
+      ///   pool of the plugin is removed.
+      ///
+      /// \return The number of instances that are ready in the pool, which is
+      /// zero if the plugin could not be found.
+      public: std::size_t WarmPool(
+          const std::string &_pluginNameOrAlias,
+          std::size_t _capacity);
+
+      /// \brief Delete the instances that are ready in the pool of a plugin,
+      /// except for the first _keep of them. The capacity of the pool does
+      /// not change, so instances that are released later may fill it up
+      /// again.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin.
+      ///
+      /// \param[in] _keep
+      ///   The number of ready instances to keep.
+      ///
+      /// \return The number of instances that were deleted
+      public: std::size_t TrimPool(
+          const std::string &_pluginNameOrAlias,
+          std::size_t _keep = 0);
+
+      /// \brief Delete the instances that are ready in the pools of all
+      /// plugins, except for the first _keep of each pool.
+      ///
+      /// \param[in] _keep
+      ///   The number of ready instances to keep in each pool.
+      ///
+      /// \return The number of instances that were deleted
+      public: std::size_t TrimPools(std::size_t _keep = 0);
+
+      /// \brief Get the counters of the instance pool of a plugin.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin.
+      ///
+      /// \return The counters of the pool. They are all zero if the plugin
+      /// has no pool.
+      public: PoolStats PoolStatsOf(
+          const std::string &_pluginNameOrAlias) const;
+
+      /// \brief Look up a plugin once, so that it can be instantiated many
+      /// times without looking up its name again. If the plugin was
+      /// discovered from a manifest, its library gets loaded now.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin.
+      ///
+      /// \return The resolved plugin. It will not refer to any plugin if the
+      /// name or alias could not be resolved.
+      public: ResolvedPlugin Resolve(
+          const std::string &_pluginNameOrAlias) const;
+
       /// \brief This loader will forget about the library at the given path
       /// location. If you want to instantiate a plugin from this library using
       /// this loader, you will first need to call LoadLib again.
@@ -212,12 +615,15 @@ namespace gz
       /// that library will be unloaded. In some cases, the operating system
       /// might not choose to unload it until the program exits completely.
       ///
+      /// A library that was registered lazily by DiscoverLib(~) can be
+      /// forgotten with the same path, whether or not it has been loaded yet.
+      ///
       /// \param[in] _pathToLibrary
       ///   Path to the library that you want to forget
       ///
-      /// \return True if the library was actively loaded and is now
-      /// successfully forgotten. If the library was not actively loaded, this
-      /// returns false.
+      /// \return True if the library was actively loaded (or lazily
+      /// registered) and is now successfully forgotten. If the library was not
+      /// actively loaded, this returns false.
       public: bool ForgetLibrary(const std::string &_pathToLibrary);
 
       /// \brief Forget the library that provides the plugin with the given
@@ -230,6 +636,17 @@ namespace gz
       /// \sa bool ForgetLibrary(const std::string &_pathToLibrary)
       public: bool ForgetLibraryOfPlugin(const std::string &_pluginNameOrAlias);
 
+      /// \brief Get the instance of a plugin that Factory<InterfaceType>(~)
+      /// hands out, instantiating it if it is not cached yet.
+      ///
+      /// \param[in] _pluginNameOrAlias
+      ///   Name or alias of the plugin.
+      ///
+      /// \return The cached instance, or an empty PluginPtr if the plugin
+      /// could not be found.
+      private: PluginPtr PrivateGetFactoryPlugin(
+          const std::string &_pluginNameOrAlias) const;
+
       /// \brief Specifically look up a plugin loaded from file.
       ///
       /// \param[in] _nameOrAlias
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef GZ_PLUGIN_MANIFESTCACHE_HH_
+#define GZ_PLUGIN_MANIFESTCACHE_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include <gz/plugin/Info.hh>
+#include <gz/plugin/loader/Export.hh>
+
+namespace gz
+{
+  namespace plugin
+  {
+    /// \brief An on-disk cache of the plugin metadata that libraries provide.
+    ///
+    /// For each library, the cache stores the names, aliases, and the mangled
+    /// and demangled interface names of its plugins. The entry of a library is
+    /// keyed by its path, and it is only used while the size, modification
+    /// time and build-id of the file at that path are unchanged.
+    ///
+    /// Attach a cache to a Loader with Loader::SetManifestCache(~). The Loader
+    /// will record every library that it loads, and Loader::DiscoverLib(~)
+    /// will then be able to learn about the plugins of those libraries without
+    /// opening them.
+    ///
+    /// A ManifestCache may be shared by several Loaders, including Loaders
+    /// that are used by different threads.
+    class GZ_PLUGIN_LOADER_VISIBLE ManifestCache
+    {
+      /// \brief Constructor. If a cache file exists at _cacheFile, its entries
+      /// will be read. Otherwise the cache starts out empty.
+      ///
+      /// \param[in] _cacheFile
+      ///   Path of the file that the cache is stored in
+      public: explicit ManifestCache(const std::string &_cacheFile);
+
+      /// \brief Destructor. Any changes that have not been saved yet will be
+      /// written to the cache file.
+      public: ~ManifestCache();
+
+      /// \brief Get the path of the file that the cache is stored in.
+      ///
+      /// \return The path that was given to the constructor
+      public: const std::string &CacheFile() const;
+
+      /// \brief Get the plugin metadata of a library, if the cache has an
+      /// up-to-date entry for it.
+      ///
+      /// \param[in] _pathToLibrary
+      ///   The path to a library
+      ///
+      /// \param[out] _plugins
+      ///   The metadata of the plugins provided by the library. The factory,
+      ///   deleter and interface casting functions of these Info objects are
+      ///   empty.
+      ///
+      /// \return True if the cache has an entry for the library and the file
+      /// has not changed since the entry was stored, otherwise false.
+      public: bool Lookup(const std::string &_pathToLibrary,
+                          std::vector<Info> &_plugins) const;
+
+      /// \brief Store the plugin metadata of a library. Only the names,
+      /// aliases and interface names of the Info objects are kept.
+      ///
+      /// \param[in] _pathToLibrary
+      ///   The path to a library
+      ///
+      /// \param[in] _plugins
+      ///   The Info of the plugins provided by the library, with their names
+      ///   demangled as the Loader does.
+      ///
+      /// \return True if the library could be inspected and was stored,
+      /// otherwise false.
+      public: bool Store(const std::string &_pathToLibrary,
+                         const std::vector<Info> &_plugins);
+
+      /// \brief Remove the entry of a library from the cache.
+      ///
+      /// \param[in] _pathToLibrary
+      ///   The path to a library
+      public: void Remove(const std::string &_pathToLibrary);
+
+      /// \brief Write the cache to its file.
+      ///
+      /// \return True if the cache file was written successfully
+      public: bool Save() const;
+
+      /// \brief Deleted copy constructor
+      public: ManifestCache(const ManifestCache&) = delete;
+
+      /// \brief Deleted copy assignment operator
+      public: ManifestCache& operator=(const ManifestCache&) = delete;
+
+      class Implementation;
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief PIMPL pointer to class implementation
+      private: std::unique_ptr<Implementation> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 #include <gz/plugin/EnablePluginFromThis.hh>
 #include <gz/plugin/Loader.hh>
 
@@ -39,43 +40,58 @@ namespace gz
     PluginPtrType Loader::Instantiate(
         const std::string &_pluginNameOrAlias) const
     {
-      // Higher priority for plugins loaded from file than from the static
-      // registry.
-      const std::string &resolvedNameForFilePlugin =
-          this->PrivateLookupFilePlugin(_pluginNameOrAlias);
+      return this->Instantiate(_pluginNameOrAlias);
+    }
 
-      const std::string &resolvedNameForStaticPlugin =
-            this->PrivateLookupStaticPlugin(_pluginNameOrAlias);
+    template <typename PluginPtrType>
+    PluginPtrType Loader::ResolvedPlugin::Instantiate() const
+    {
+      return this->Instantiate();
+    }
 
-      PluginPtr ptr;
+    template <typename PluginPtrType>
+    std::vector<PluginPtrType> Loader::InstantiateMany(
+        const std::string &_pluginNameOrAlias,
+        const std::size_t _count) const
+    {
+      return this->Resolve(_pluginNameOrAlias)
+          .template InstantiateMany<PluginPtrType>(_count);
+    }
 
-      if (!resolvedNameForFilePlugin.empty())
-      {
-        ptr = PluginPtr(
-            this->PrivateGetInfoForFilePlugin(resolvedNameForFilePlugin),
-            this->PrivateGetPluginDlHandlePtr(resolvedNameForFilePlugin));
-      }
-      else if (!resolvedNameForStaticPlugin.empty())
+    template <typename PluginPtrType>
+    std::vector<PluginPtrType> Loader::ResolvedPlugin::InstantiateMany(
+        const std::size_t _count) const
+    {
+      if (!this->table)
+        return {};
+
+      if (this->shared)
       {
-        ptr = PluginPtr(
-            this->PrivateGetInfoForStaticPlugin(resolvedNameForStaticPlugin));
+        return std::vector<PluginPtrType>(
+            _count, PluginPtrType::PrivateMakeFromInstance(
+              this->table, this->PrivateGetSharedInstance()));
       }
-      else
+
+      std::vector<PluginPtrType> plugins =
+          PluginPtrType::PrivateMakeMany(this->table, this->library, _count);
+
+      if (this->enablePluginFromThis)
       {
-        return PluginPtr();
+        for (const PluginPtrType &plugin : plugins)
+        {
+          plugin->template QueryInterface<EnablePluginFromThis>()
+              ->PrivateSetPluginFromThis(plugin);
+        }
       }
 
-      if (auto *enableFromThis = ptr->QueryInterface<EnablePluginFromThis>())
-        enableFromThis->PrivateSetPluginFromThis(ptr);
-
-      return ptr;
+      return plugins;
     }
 
     template <typename InterfaceType>
     std::shared_ptr<InterfaceType> Loader::Factory(
         const std::string &_pluginNameOrAlias) const
     {
-      return this->Instantiate(_pluginNameOrAlias)
+      return this->PrivateGetFactoryPlugin(_pluginNameOrAlias)
           ->template QueryInterfaceSharedPtr<InterfaceType>();
     }
   }
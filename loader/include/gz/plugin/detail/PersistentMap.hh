@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_PLUGIN_DETAIL_PERSISTENTMAP_HH_
+#define GZ_PLUGIN_DETAIL_PERSISTENTMAP_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      /// \brief A map from strings to values whose copies share their
+      /// contents. Copying the map is O(1), and changing a copy only copies
+      /// the few nodes on the path to the changed entry, so the copy and the
+      /// original never affect each other.
+      ///
+      /// The map is a hash trie: each branch node picks one of 32 children
+      /// with the next 5 bits of the hash of the key, and the entries are
+      /// kept in leaf nodes. Nodes are never modified once they have been
+      /// shared, so a map may be read by several threads at once, as long as
+      /// no thread modifies that same copy of the map.
+      template <typename Value>
+      class PersistentMap
+      {
+        /// \brief Find the value of a key
+        /// \param[in] _key The key
+        /// \return The value, or a nullptr if the map does not have the key.
+        /// The value stays valid until this copy of the map gets modified.
+        public: const Value *Find(const std::string &_key) const
+        {
+          const std::size_t hash = std::hash<std::string>()(_key);
+
+          const Node *node = this->root.get();
+          for (unsigned int shift = 0; node; shift += kBits)
+          {
+            if (node->IsLeaf())
+            {
+              if (node->hash != hash)
+                return nullptr;
+
+              for (const Entry &entry : node->entries)
+              {
+                if (entry.first == _key)
+                  return &entry.second;
+              }
+              return nullptr;
+            }
+
+            const std::uint32_t bit = Bit(hash, shift);
+            if (0 == (node->bitmap & bit))
+              return nullptr;
+
+            node = node->children[Position(node->bitmap, bit)].get();
+          }
+
+          return nullptr;
+        }
+
+        /// \brief Add a key, unless the map already has it
+        /// \param[in] _key The key
+        /// \param[in] _value The value of the key
+        /// \return True if the key was added
+        public: bool Insert(const std::string &_key, Value _value)
+        {
+          bool added = false;
+          this->root = Assign(this->root, 0, std::hash<std::string>()(_key),
+                              _key, std::move(_value), false, added);
+          if (added)
+            ++this->size;
+          return added;
+        }
+
+        /// \brief Add a key, or replace its value if the map already has it
+        /// \param[in] _key The key
+        /// \param[in] _value The value of the key
+        public: void Set(const std::string &_key, Value _value)
+        {
+          bool added = false;
+          this->root = Assign(this->root, 0, std::hash<std::string>()(_key),
+                              _key, std::move(_value), true, added);
+          if (added)
+            ++this->size;
+        }
+
+        /// \brief Remove a key
+        /// \param[in] _key The key
+        /// \return True if the map had the key
+        public: bool Erase(const std::string &_key)
+        {
+          bool removed = false;
+          this->root = Remove(this->root, 0, std::hash<std::string>()(_key),
+                              _key, removed);
+          if (removed)
+            --this->size;
+          return removed;
+        }
+
+        /// \brief Get the number of keys
+        /// \return The number of keys
+        public: std::size_t Size() const
+        {
+          return this->size;
+        }
+
+        /// \brief Check whether the map has no keys
+        /// \return True if the map has no keys
+        public: bool Empty() const
+        {
+          return 0 == this->size;
+        }
+
+        /// \brief Call a function on every entry, in no particular order
+        /// \param[in] _function Called with the key and the value of each
+        /// entry
+        public: template <typename Function>
+        void ForEach(const Function &_function) const
+        {
+          Visit(this->root.get(), _function);
+        }
+
+        /// \brief An entry of the map
+        private: using Entry = std::pair<std::string, Value>;
+
+        /// \brief A node of the trie. A leaf has entries, which all have
+        /// the same hash, and a branch has children.
+        private: struct Node
+        {
+          /// \brief Which of the 32 children of a branch exist
+          std::uint32_t bitmap = 0;
+
+          /// \brief The children of a branch which exist, in the order of
+          /// their bits in `bitmap`
+          std::vector<std::shared_ptr<const Node>> children;
+
+          /// \brief The hash of the keys of a leaf
+          std::size_t hash = 0;
+
+          /// \brief The entries of a leaf
+          std::vector<Entry> entries;
+
+          /// \brief Check whether this node is a leaf
+          bool IsLeaf() const
+          {
+            return !this->entries.empty();
+          }
+        };
+
+        private: using NodePtr = std::shared_ptr<const Node>;
+
+        /// \brief Number of bits of the hash that each level consumes
+        private: static constexpr unsigned int kBits = 5;
+
+        /// \brief Get the bit of the child that a hash belongs to
+        /// \param[in] _hash The hash
+        /// \param[in] _shift The bits of the hash that the levels above have
+        /// consumed
+        /// \return The bit of the child in the bitmap of the branch
+        private: static std::uint32_t Bit(
+            const std::size_t _hash, const unsigned int _shift)
+        {
+          return std::uint32_t(1) << ((_hash >> _shift) & 0x1f);
+        }
+
+        /// \brief Get the position of a child in the children of a branch
+        /// \param[in] _bitmap The bitmap of the branch
+        /// \param[in] _bit The bit of the child
+        /// \return The number of children that come before the child
+        private: static std::size_t Position(
+            const std::uint32_t _bitmap, const std::uint32_t _bit)
+        {
+          std::uint32_t bits = _bitmap & (_bit - 1);
+          bits = bits - ((bits >> 1) & 0x55555555u);
+          bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+          bits = (bits + (bits >> 4)) & 0x0f0f0f0fu;
+          return (bits * 0x01010101u) >> 24;
+        }
+
+        /// \brief Make a copy of a trie with a key added or replaced
+        /// \param[in] _node The trie
+        /// \param[in] _shift The bits of the hash that the levels above
+        /// `_node` have consumed
+        /// \param[in] _hash The hash of the key
+        /// \param[in] _key The key
+        /// \param[in] _value The value of the key
+        /// \param[in] _replace Whether to replace the value of a key that
+        /// the trie already has
+        /// \param[out] _added Set to true if the key was added
+        /// \return The new trie, which is `_node` itself if nothing changed
+        private: static NodePtr Assign(
+            const NodePtr &_node, const unsigned int _shift,
+            const std::size_t _hash, const std::string &_key, Value &&_value,
+            const bool _replace, bool &_added)
+        {
+          if (!_node)
+          {
+            auto leaf = std::make_shared<Node>();
+            leaf->hash = _hash;
+            leaf->entries.emplace_back(_key, std::move(_value));
+            _added = true;
+            return leaf;
+          }
+
+          if (_node->IsLeaf())
+          {
+            if (_node->hash == _hash)
+            {
+              for (std::size_t i = 0; i < _node->entries.size(); ++i)
+              {
+                if (_node->entries[i].first != _key)
+                  continue;
+
+                if (!_replace)
+                  return _node;
+
+                auto leaf = std::make_shared<Node>(*_node);
+                leaf->entries[i].second = std::move(_value);
+                return leaf;
+              }
+
+              auto leaf = std::make_shared<Node>(*_node);
+              leaf->entries.emplace_back(_key, std::move(_value));
+              _added = true;
+              return leaf;
+            }
+
+            // The keys have different hashes, so they get separated by a
+            // branch. Their hashes must differ somewhere in the bits that
+            // the levels below have not consumed yet.
+            auto branch = std::make_shared<Node>();
+            branch->bitmap = Bit(_node->hash, _shift);
+            branch->children.push_back(_node);
+            return Assign(branch, _shift, _hash, _key, std::move(_value),
+                          _replace, _added);
+          }
+
+          const std::uint32_t bit = Bit(_hash, _shift);
+          const std::size_t position = Position(_node->bitmap, bit);
+
+          if (_node->bitmap & bit)
+          {
+            const NodePtr &child = _node->children[position];
+            NodePtr newChild = Assign(child, _shift + kBits, _hash, _key,
+                                      std::move(_value), _replace, _added);
+            if (newChild == child)
+              return _node;
+
+            auto branch = std::make_shared<Node>(*_node);
+            branch->children[position] = std::move(newChild);
+            return branch;
+          }
+
+          auto branch = std::make_shared<Node>(*_node);
+          branch->bitmap |= bit;
+          branch->children.insert(
+                branch->children.begin() + position,
+                Assign(nullptr, _shift + kBits, _hash, _key,
+                       std::move(_value), _replace, _added));
+          return branch;
+        }
+
+        /// \brief Make a copy of a trie with a key removed
+        /// \param[in] _node The trie
+        /// \param[in] _shift The bits of the hash that the levels above
+        /// `_node` have consumed
+        /// \param[in] _hash The hash of the key
+        /// \param[in] _key The key
+        /// \param[out] _removed Set to true if the key was removed
+        /// \return The new trie, which is `_node` itself if nothing changed
+        private: static NodePtr Remove(
+            const NodePtr &_node, const unsigned int _shift,
+            const std::size_t _hash, const std::string &_key, bool &_removed)
+        {
+          if (!_node)
+            return _node;
+
+          if (_node->IsLeaf())
+          {
+            if (_node->hash != _hash)
+              return _node;
+
+            for (std::size_t i = 0; i < _node->entries.size(); ++i)
+            {
+              if (_node->entries[i].first != _key)
+                continue;
+
+              _removed = true;
+              if (_node->entries.size() == 1)
+                return nullptr;
+
+              auto leaf = std::make_shared<Node>(*_node);
+              leaf->entries.erase(leaf->entries.begin() + i);
+              return leaf;
+            }
+
+            return _node;
+          }
+
+          const std::uint32_t bit = Bit(_hash, _shift);
+          if (0 == (_node->bitmap & bit))
+            return _node;
+
+          const std::size_t position = Position(_node->bitmap, bit);
+          const NodePtr &child = _node->children[position];
+          NodePtr newChild = Remove(child, _shift + kBits, _hash, _key,
+                                    _removed);
+          if (newChild == child)
+            return _node;
+
+          auto branch = std::make_shared<Node>(*_node);
+          if (newChild)
+          {
+            branch->children[position] = std::move(newChild);
+          }
+          else
+          {
+            branch->bitmap &= ~bit;
+            branch->children.erase(branch->children.begin() + position);
+          }
+
+          if (branch->children.empty())
+            return nullptr;
+
+          // A branch that only leads to one leaf is replaced by the leaf, so
+          // that removing keys also shortens the paths to the others.
+          if (branch->children.size() == 1 && branch->children[0]->IsLeaf())
+            return branch->children[0];
+
+          return branch;
+        }
+
+        /// \brief Call a function on every entry of a trie
+        /// \param[in] _node The trie
+        /// \param[in] _function Called with the key and the value of each
+        /// entry
+        private: template <typename Function>
+        static void Visit(const Node *_node, const Function &_function)
+        {
+          if (!_node)
+            return;
+
+          for (const Entry &entry : _node->entries)
+            _function(entry.first, entry.second);
+
+          for (const NodePtr &child : _node->children)
+            Visit(child.get(), _function);
+        }
+
+        /// \brief The root of the trie, or a nullptr if the map is empty
+        private: NodePtr root;
+
+        /// \brief The number of keys
+        private: std::size_t size = 0;
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief A set of strings whose copies share their contents, in the
+      /// same way as the copies of a PersistentMap.
+      class PersistentSet
+      {
+        /// \brief Add a key, unless the set already has it
+        /// \param[in] _key The key
+        /// \return True if the key was added
+        public: bool Insert(const std::string &_key)
+        {
+          return this->keys.Insert(_key, Present());
+        }
+
+        /// \brief Remove a key
+        /// \param[in] _key The key
+        /// \return True if the set had the key
+        public: bool Erase(const std::string &_key)
+        {
+          return this->keys.Erase(_key);
+        }
+
+        /// \brief Check whether the set has a key
+        /// \param[in] _key The key
+        /// \return True if the set has the key
+        public: bool Contains(const std::string &_key) const
+        {
+          return nullptr != this->keys.Find(_key);
+        }
+
+        /// \brief Get the number of keys
+        /// \return The number of keys
+        public: std::size_t Size() const
+        {
+          return this->keys.Size();
+        }
+
+        /// \brief Check whether the set has no keys
+        /// \return True if the set has no keys
+        public: bool Empty() const
+        {
+          return this->keys.Empty();
+        }
+
+        /// \brief Call a function on every key, in no particular order
+        /// \param[in] _function Called with each key
+        public: template <typename Function>
+        void ForEach(const Function &_function) const
+        {
+          this->keys.ForEach(
+                [&](const std::string &_key, const Present &)
+          {
+            _function(_key);
+          });
+        }
+
+        /// \brief The value of every key of `keys`
+        private: struct Present { };
+
+        /// \brief The keys of this set
+        private: PersistentMap<Present> keys;
+      };
+    }
+  }
+}
+
+#endif
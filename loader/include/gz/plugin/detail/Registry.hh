@@ -19,7 +19,10 @@
 #ifndef GZ_PLUGIN_DETAIL_REGISTRY_HH_
 #define GZ_PLUGIN_DETAIL_REGISTRY_HH_
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -27,6 +30,8 @@
 #include <unordered_set>
 
 #include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/InterfaceTable.hh>
+#include <gz/plugin/detail/PersistentMap.hh>
 #include <gz/plugin/loader/Export.hh>
 #include <gz/utils/SuppressWarning.hh>
 
@@ -36,13 +41,179 @@ namespace gz
   {
     /// \brief Manages a set of plugin Infos and allows querying by name or
     /// by alias.
+    ///
+    /// The plugins of a registry are kept in an immutable Snapshot. Changing
+    /// the registry makes a modified copy of the current snapshot and then
+    /// publishes that copy atomically, so the query functions never wait for
+    /// a change of the registry, and they can never observe a change that is
+    /// only partially done. Use GetSnapshot() to run several queries against
+    /// one consistent state of the registry.
+    ///
+    /// A copy of a snapshot shares all of its plugins and indexes with the
+    /// original, so the cost of a change only depends on what it changes, not
+    /// on how many plugins the registry has.
     class GZ_PLUGIN_LOADER_VISIBLE Registry {
+      /// \brief An immutable view of the plugins of a Registry at one point
+      /// in time. A snapshot stays valid, and keeps the libraries of its
+      /// plugins loaded, for as long as it is being held, even if the
+      /// registry has changed since it was taken.
+      public: class GZ_PLUGIN_LOADER_VISIBLE Snapshot
+      {
+        /// \brief A plugin of the registry.
+        ///
+        /// CRUCIAL DEV NOTE: `library` MUST come BEFORE `info` and `table` so
+        /// that the Info gets destructed while the library that its `deleter`
+        /// lives in is still loaded.
+        public: struct Entry
+        {
+          /// \brief Object that keeps the plugin available for as long as
+          /// this entry exists, e.g. the handle of the library that provides
+          /// it. This may be a nullptr.
+          std::shared_ptr<void> library;
+
+          /// \brief The Info of the plugin
+          ConstInfoPtr info;
+
+          /// \brief The interface table made from `info`, which every
+          /// instance of the plugin shares
+          detail::ConstInterfaceTablePtr table;
+        };
+
+        /// \brief Makes a printable string with info about plugins
+        ///
+        /// \returns A pretty string
+        public: std::string PrettyStr() const;
+
+        /// \sa Registry::InterfacesImplemented()
+        public: std::unordered_set<std::string> InterfacesImplemented() const;
+
+        /// \sa Registry::PluginsImplementing()
+        public: template <typename Interface>
+        std::unordered_set<std::string> PluginsImplementing() const
+        {
+          return this->PluginsImplementing(typeid(Interface).name(), false);
+        }
+
+        /// \sa Registry::PluginsImplementing(const std::string&, bool)
+        public: std::unordered_set<std::string> PluginsImplementing(
+            const std::string &_interface,
+            const bool _demangled = true) const;
+
+        /// \sa Registry::PluginsWithAlias()
+        public: std::set<std::string> PluginsWithAlias(
+            const std::string &_alias) const;
+
+        /// \sa Registry::AliasesOfPlugin()
+        public: std::set<std::string> AliasesOfPlugin(
+            const std::string &_pluginName) const;
+
+        /// \sa Registry::LookupPlugin()
+        public: std::string LookupPlugin(
+            const std::string &_nameOrAlias) const;
+
+        /// \sa Registry::AllPlugins()
+        public: std::set<std::string> AllPlugins() const;
+
+        /// \sa Registry::GetInfo()
+        public: ConstInfoPtr GetInfo(const std::string &_pluginName) const;
+
+        /// \brief Find the entry of a plugin.
+        ///
+        /// \param[in] _pluginName
+        ///   Name of the plugin as returned by LookupPlugin(~).
+        ///
+        /// \return The entry of the plugin, or a nullptr if this snapshot
+        /// does not have a plugin with that name. The entry is owned by this
+        /// snapshot, and it stays valid until this snapshot gets modified.
+        public: const Entry *FindPlugin(const std::string &_pluginName) const;
+
+        /// \brief Add a new plugin info. This can only be used on the
+        /// snapshot that is handed out by Registry::Update(~).
+        ///
+        /// \param[in] _info
+        ///   Plugin info to add.
+        ///
+        /// \param[in] _library
+        ///   Object that needs to outlive the info, e.g. the handle of the
+        ///   library that provides the plugin.
+        ///
+        /// \return True if the info was added, false if a plugin with this
+        ///   name already exists in the snapshot.
+        public: bool AddInfo(ConstInfoPtr _info,
+                             std::shared_ptr<void> _library = nullptr);
+
+        /// \brief Forget a plugin info. This can only be used on the
+        /// snapshot that is handed out by Registry::Update(~).
+        ///
+        /// \param[in] _pluginName
+        ///   Name of the plugin as returned by LookupPlugin(~).
+        public: void ForgetInfo(const std::string &_pluginName);
+
+        GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+        /// \brief A map from keys to the names of plugins. A key only has an
+        /// entry while it refers to at least one plugin.
+        private: using NameIndex =
+            detail::PersistentMap<detail::PersistentSet>;
+
+        /// \brief A map from known alias names to the plugin names that they
+        /// correspond to. Since an alias might refer to more than one plugin,
+        /// the value of this map is a set.
+        private: NameIndex aliases;
+
+        private: using PluginMap = detail::PersistentMap<Entry>;
+        /// \brief A map from known plugin names to their entry.
+        private: PluginMap plugins;
+
+        private: using InterfaceMap = NameIndex;
+        /// \brief A map from the mangled names of interfaces to the names of
+        /// the plugins that implement them.
+        private: InterfaceMap pluginsByInterface;
+
+        /// \brief A map from the demangled names of interfaces to the names
+        /// of the plugins that implement them. An interface only has an entry
+        /// while at least one plugin implements it.
+        private: InterfaceMap pluginsByDemangledInterface;
+        GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+      };
+
+      /// \brief A pointer to a snapshot that cannot be modified anymore
+      public: using ConstSnapshotPtr = std::shared_ptr<const Snapshot>;
+
       /// \brief Constructor
-      public: Registry() = default;
+      public: Registry();
 
       /// \brief Destructor
       public: virtual ~Registry() = default;
 
+      /// \brief Get the current state of this registry. This never waits
+      /// for an Update(~), and the snapshot will not be affected by any later
+      /// changes to the registry.
+      ///
+      /// \note The snapshot is read with std::atomic_load, which standard
+      /// libraries may implement with a short internal lock, so this is not
+      /// guaranteed to be lock-free.
+      ///
+      /// \return The current snapshot of this registry.
+      public: ConstSnapshotPtr GetSnapshot() const;
+
+      /// \brief Change the plugins of this registry. The callback receives
+      /// a copy of the current snapshot to modify, and that copy replaces the
+      /// current snapshot once the callback returns. Readers see either none
+      /// or all of the changes that the callback makes.
+      ///
+      /// Only one update runs at a time. The callback must not use the
+      /// registry that it is updating.
+      ///
+      /// \param[in] _update
+      ///   Function that modifies the plugins of the registry.
+      ///
+      /// \returns The snapshot that was replaced. Releasing the last
+      /// reference to it might unload the libraries of the plugins that the
+      /// update removed, so a caller that holds a lock of its own should keep
+      /// it until that lock has been released.
+      public: ConstSnapshotPtr Update(
+        const std::function<void(Snapshot&)> &_update);
+
       /// \brief Makes a printable string with info about plugins
       ///
       /// \returns A pretty string
@@ -51,6 +222,10 @@ namespace gz
       /// \brief Get demangled names of interfaces that the registry has plugins
       /// for.
       ///
+      /// This is answered from the interface index of the registry, so it
+      /// takes time proportional to the number of interfaces, no matter how
+      /// many plugins implement them.
+      ///
       /// \returns Demangled names of the interfaces that are implemented
       public: std::unordered_set<std::string> InterfacesImplemented() const;
 
@@ -77,6 +252,9 @@ namespace gz
       /// \param[in] _interface
       ///   Name of an interface
       ///
+      /// The registry keeps an index of the plugins of each interface, so this
+      /// takes time proportional to the number of plugins that are returned.
+      ///
       /// \param[in] _demangled
       ///   Specify whether the _interface string is demangled (default, true)
       ///   or mangled (false).
@@ -160,6 +338,21 @@ namespace gz
       ///   Name of the plugin as returned by LookupPlugin(~).
       public: virtual void ForgetInfo(const std::string &_pluginName);
 
+      /// \brief Add a new plugin info together with an object that needs to
+      /// outlive it.
+      ///
+      /// \param[in] _info
+      ///   Plugin info to add.
+      ///
+      /// \param[in] _library
+      ///   Object that needs to outlive the info, e.g. the handle of the
+      ///   library that provides the plugin.
+      ///
+      /// \return True if the info was added, false if a plugin with this name
+      ///   already exists in the registry.
+      public: bool AddInfo(const Info &_info,
+                           const std::shared_ptr<void> &_library);
+
       /// \brief Deleted copy constructor
       public: Registry(const Registry&) = delete;
 
@@ -167,16 +360,13 @@ namespace gz
       public: Registry& operator=(Registry&) = delete;
 
       GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
-      protected: using AliasMap = std::map<std::string, std::set<std::string>>;
-      /// \brief A map from known alias names to the plugin names that they
-      /// correspond to. Since an alias might refer to more than one plugin,
-      /// the key of this map is a set.
-      protected: AliasMap aliases;
-
-      protected: using PluginMap =
-          std::unordered_map<std::string, ConstInfoPtr>;
-      /// \brief A map from known plugin names to their Info.
-      protected: PluginMap plugins;
+      /// \brief The current snapshot. It must only be accessed through the
+      /// std::atomic_load and std::atomic_store family of functions.
+      private: ConstSnapshotPtr current;
+
+      /// \brief Makes sure that only one Update(~) runs at a time, so that
+      /// no update can be lost.
+      private: std::mutex updateMutex;
       GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
     };
   }
@@ -20,13 +20,11 @@
 #define GZ_PLUGIN_DETAIL_STATICREGISTRY_HH_
 
 #include <memory>
-#include <set>
 #include <string>
 
 #include <gz/plugin/Info.hh>
 #include <gz/plugin/detail/Registry.hh>
 #include <gz/plugin/loader/Export.hh>
-#include <gz/utils/SuppressWarning.hh>
 
 namespace gz
 {
@@ -38,21 +36,11 @@ namespace gz
       /// \brief Get a reference to the StaticRegistry instance.
       public: static StaticRegistry& GetInstance();
 
-      /// \brief Get a set of the names of all plugins that are in this
-      /// registry.
-      ///
-      /// \return A set of all plugin names in this registry.
-      public: virtual std::set<std::string> AllPlugins() const override;
-
-      /// \brief Get info as ConstInfoPtr.
-      ///
-      /// \param[in] _pluginName
-      ///   Name of the plugin as returned by LookupPlugin(~).
-      public: virtual ConstInfoPtr GetInfo(
-          const std::string &_pluginName) const override;
-
       /// \brief Register Info for a new plugin.
       ///
+      /// The registry keeps one shared Info for each plugin, so GetInfo(~)
+      /// does not copy it, and every instance of a plugin shares its Info.
+      ///
       /// This happens automatically when the macros defined in
       /// gz/plugin/RegisterStatic.hh are called in a plugin library. So this
       /// method is assumed to be called only during program start.
@@ -74,11 +62,6 @@ namespace gz
 
       /// \brief Constructor
       protected: StaticRegistry() = default;
-
-      /// \brief Holds info required to construct a plugin
-      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
-      private: InfoMap infos;
-      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
     };
   }
 }
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#if __has_include(<elf.h>) && __has_include(<sys/mman.h>)
+#define GZ_PLUGIN_HAVE_ELF
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "ElfReader.hh"
+
+namespace gz
+{
+  namespace plugin
+  {
+#ifdef GZ_PLUGIN_HAVE_ELF
+    namespace
+    {
+      // We only need to understand libraries that could be loaded into this
+      // process, so we only accept the native word size and byte order.
+#if UINTPTR_MAX > 0xffffffffu
+      using ElfEhdr = Elf64_Ehdr;
+      using ElfShdr = Elf64_Shdr;
+      using ElfNhdr = Elf64_Nhdr;
+      constexpr unsigned char kNativeClass = ELFCLASS64;
+#else
+      using ElfEhdr = Elf32_Ehdr;
+      using ElfShdr = Elf32_Shdr;
+      using ElfNhdr = Elf32_Nhdr;
+      constexpr unsigned char kNativeClass = ELFCLASS32;
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      constexpr unsigned char kNativeData = ELFDATA2MSB;
+#else
+      constexpr unsigned char kNativeData = ELFDATA2LSB;
+#endif
+
+      /////////////////////////////////////////////////
+      /// \brief Check that [_offset, _offset + _length) fits inside of a
+      /// buffer of _size bytes, without overflowing.
+      bool InBounds(const std::size_t _size,
+                    const std::uint64_t _offset,
+                    const std::uint64_t _length)
+      {
+        return _offset <= _size && _length <= _size - _offset;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Round a note field size up to the 4-byte alignment of notes.
+      std::size_t NoteAlign(const std::size_t _size)
+      {
+        return (_size + 3u) & ~static_cast<std::size_t>(3u);
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Section callback which searches a note section for the GNU
+      /// build-id note.
+      bool FindBuildId(
+          const char */*_name*/, const unsigned int _type,
+          const unsigned char *_data, const std::size_t _size,
+          void *_userData)
+      {
+        if (SHT_NOTE != _type)
+          return true;
+
+        std::string &buildId = *static_cast<std::string*>(_userData);
+
+        std::size_t offset = 0;
+        while (InBounds(_size, offset, sizeof(ElfNhdr)))
+        {
+          ElfNhdr note;
+          std::memcpy(&note, _data + offset, sizeof(note));
+          offset += sizeof(ElfNhdr);
+
+          const std::size_t nameOffset = offset;
+          const std::size_t descOffset = offset + NoteAlign(note.n_namesz);
+          if (!InBounds(_size, nameOffset, note.n_namesz)
+              || !InBounds(_size, descOffset, note.n_descsz))
+          {
+            return true;
+          }
+
+          if (NT_GNU_BUILD_ID == note.n_type && 4u == note.n_namesz
+              && 0 == std::memcmp(_data + nameOffset, "GNU", 4))
+          {
+            static const char hex[] = "0123456789abcdef";
+            buildId.reserve(2u * note.n_descsz);
+            for (std::size_t i = 0; i < note.n_descsz; ++i)
+            {
+              const unsigned char byte = _data[descOffset + i];
+              buildId.push_back(hex[byte >> 4]);
+              buildId.push_back(hex[byte & 0x0Fu]);
+            }
+            return false;
+          }
+
+          offset = descOffset + NoteAlign(note.n_descsz);
+        }
+
+        return true;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Name and output of a FindSection search
+      struct SectionSearch
+      {
+        const std::string *name;
+        std::string *contents;
+        bool found;
+      };
+
+      /////////////////////////////////////////////////
+      /// \brief Section callback which copies the contents of the section
+      /// that has the requested name.
+      bool FindSection(
+          const char *_name, const unsigned int /*_type*/,
+          const unsigned char *_data, const std::size_t _size,
+          void *_userData)
+      {
+        SectionSearch &search = *static_cast<SectionSearch*>(_userData);
+        if (*search.name != _name)
+          return true;
+
+        search.contents->assign(reinterpret_cast<const char*>(_data), _size);
+        search.found = true;
+        return false;
+      }
+    }
+#endif
+
+    /////////////////////////////////////////////////
+    ElfFile::ElfFile(const std::string &_path)
+    {
+#ifdef GZ_PLUGIN_HAVE_ELF
+      const int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0)
+        return;
+
+      struct stat status;
+      if (0 != fstat(fd, &status) || status.st_size <= 0
+          || static_cast<std::uint64_t>(status.st_size) < sizeof(ElfEhdr))
+      {
+        close(fd);
+        return;
+      }
+
+      void *mapped = mmap(nullptr, static_cast<std::size_t>(status.st_size),
+                          PROT_READ, MAP_PRIVATE, fd, 0);
+
+      // The mapping stays valid after the file descriptor is closed.
+      close(fd);
+
+      if (MAP_FAILED == mapped)
+        return;
+
+      this->data = static_cast<const unsigned char*>(mapped);
+      this->size = static_cast<std::size_t>(status.st_size);
+
+      ElfEhdr header;
+      std::memcpy(&header, this->data, sizeof(header));
+
+      if (0 != std::memcmp(header.e_ident, ELFMAG, SELFMAG)
+          || kNativeClass != header.e_ident[EI_CLASS]
+          || kNativeData != header.e_ident[EI_DATA]
+          || sizeof(ElfShdr) != header.e_shentsize
+          || 0 == header.e_shnum
+          || header.e_shstrndx >= header.e_shnum
+          || !InBounds(this->size, header.e_shoff,
+                       static_cast<std::uint64_t>(header.e_shnum)
+                       * sizeof(ElfShdr)))
+      {
+        return;
+      }
+
+      ElfShdr names;
+      std::memcpy(&names, this->data + header.e_shoff
+                  + header.e_shstrndx * sizeof(ElfShdr), sizeof(names));
+
+      this->valid = SHT_NOBITS != names.sh_type
+          && InBounds(this->size, names.sh_offset, names.sh_size);
+#else
+      (void) _path;
+#endif
+    }
+
+    /////////////////////////////////////////////////
+    ElfFile::~ElfFile()
+    {
+#ifdef GZ_PLUGIN_HAVE_ELF
+      if (this->data)
+      {
+        munmap(const_cast<unsigned char*>(this->data), this->size);
+      }
+#endif
+    }
+
+    /////////////////////////////////////////////////
+    bool ElfFile::Valid() const
+    {
+      return this->valid;
+    }
+
+    /////////////////////////////////////////////////
+    std::string ElfFile::BuildId() const
+    {
+      std::string buildId;
+#ifdef GZ_PLUGIN_HAVE_ELF
+      this->ForEachSection(&FindBuildId, &buildId);
+#endif
+      return buildId;
+    }
+
+    /////////////////////////////////////////////////
+    bool ElfFile::SectionContents(const std::string &_name,
+                                  std::string &_contents) const
+    {
+#ifdef GZ_PLUGIN_HAVE_ELF
+      SectionSearch search{&_name, &_contents, false};
+      this->ForEachSection(&FindSection, &search);
+      return search.found;
+#else
+      (void) _name;
+      (void) _contents;
+      return false;
+#endif
+    }
+
+    /////////////////////////////////////////////////
+    void ElfFile::ForEachSection(
+        SectionCallback _callback, void *_userData) const
+    {
+#ifdef GZ_PLUGIN_HAVE_ELF
+      if (!this->valid)
+        return;
+
+      ElfEhdr header;
+      std::memcpy(&header, this->data, sizeof(header));
+
+      ElfShdr names;
+      std::memcpy(&names, this->data + header.e_shoff
+                  + header.e_shstrndx * sizeof(ElfShdr), sizeof(names));
+
+      const char *nameTable =
+          reinterpret_cast<const char*>(this->data + names.sh_offset);
+
+      for (std::size_t i = 0; i < header.e_shnum; ++i)
+      {
+        ElfShdr section;
+        std::memcpy(&section, this->data + header.e_shoff
+                    + i * sizeof(ElfShdr), sizeof(section));
+
+        if (SHT_NULL == section.sh_type || SHT_NOBITS == section.sh_type
+            || !InBounds(this->size, section.sh_offset, section.sh_size))
+        {
+          continue;
+        }
+
+        // Make sure the name is terminated inside of the name table
+        if (section.sh_name >= names.sh_size
+            || nullptr == std::memchr(nameTable + section.sh_name, '\0',
+                                      names.sh_size - section.sh_name))
+        {
+          continue;
+        }
+
+        if (!_callback(nameTable + section.sh_name, section.sh_type,
+                       this->data + section.sh_offset,
+                       static_cast<std::size_t>(section.sh_size), _userData))
+        {
+          return;
+        }
+      }
+#else
+      (void) _callback;
+      (void) _userData;
+#endif
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_PLUGIN_SRC_ELFREADER_HH_
+#define GZ_PLUGIN_SRC_ELFREADER_HH_
+
+#include <cstddef>
+#include <string>
+
+namespace gz
+{
+  namespace plugin
+  {
+    /// \brief Read-only view of an ELF shared library which has been mapped
+    /// into memory with mmap. Nothing in the file gets executed or relocated,
+    /// so inspecting a library this way costs little more than the page
+    /// faults for the parts of the file that get read.
+    ///
+    /// On platforms that do not use ELF, every file is reported as invalid.
+    class ElfFile
+    {
+      /// \brief Map the file at the given path.
+      /// \param[in] _path Path to the file
+      public: explicit ElfFile(const std::string &_path);
+
+      /// \brief Destructor. Unmaps the file.
+      public: ~ElfFile();
+
+      /// \brief Check whether the file could be mapped and has a well-formed
+      /// ELF header and section header table for the native architecture.
+      /// \return True if the file is a usable ELF file
+      public: bool Valid() const;
+
+      /// \brief Get the build-id that the linker recorded in the
+      /// .note.gnu.build-id section of the file.
+      /// \return The build-id as a lowercase hexadecimal string, or an empty
+      /// string if the file has no build-id.
+      public: std::string BuildId() const;
+
+      /// \brief Get the contents of the section with the given name.
+      /// \param[in] _name Name of the section
+      /// \param[out] _contents The contents of the section
+      /// \return True if the file has a section with that name whose contents
+      /// are stored in the file.
+      public: bool SectionContents(const std::string &_name,
+                                   std::string &_contents) const;
+
+      /// \brief Deleted copy constructor
+      public: ElfFile(const ElfFile &) = delete;
+
+      /// \brief Deleted copy assignment operator
+      public: ElfFile &operator=(const ElfFile &) = delete;
+
+      /// \brief Callback for each section of the file.
+      /// \param[in] _name Name of the section
+      /// \param[in] _type ELF type of the section (e.g. SHT_NOTE)
+      /// \param[in] _data Pointer to the contents of the section
+      /// \param[in] _size Size of the contents of the section
+      /// \param[in] _userData The pointer that was passed to ForEachSection
+      /// \return False to stop iterating
+      private: using SectionCallback = bool(*)(
+          const char *_name, unsigned int _type,
+          const unsigned char *_data, std::size_t _size, void *_userData);
+
+      /// \brief Visit each section that has its contents stored in the file.
+      /// \param[in] _callback Function to call for each section
+      /// \param[in] _userData Pointer to pass along to _callback
+      private: void ForEachSection(
+          SectionCallback _callback, void *_userData) const;
+
+      /// \brief Start of the mapped file, or nullptr if it is not mapped
+      private: const unsigned char *data = nullptr;
+
+      /// \brief Size of the mapped file
+      private: std::size_t size = 0;
+
+      /// \brief True if the header of the file has been validated
+      private: bool valid = false;
+    };
+  }
+}
+
+#endif
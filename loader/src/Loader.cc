@@ -17,22 +17,37 @@
 
 #include <dlfcn.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include <gz/plugin/Info.hh>
 #include <gz/plugin/Loader.hh>
+#include <gz/plugin/ManifestCache.hh>
 #include <gz/plugin/Plugin.hh>
+#include <gz/plugin/Resettable.hh>
+#include <gz/plugin/detail/PluginDescriptor.hh>
 #include <gz/plugin/detail/Registry.hh>
 #include <gz/plugin/detail/StaticRegistry.hh>
 #include <gz/plugin/utility.hh>
 
+#include "PluginMetadata.hh"
+
 namespace gz
 {
   namespace plugin
@@ -41,49 +56,263 @@ namespace gz
     /// \brief PIMPL Implementation of the Loader class
     class Loader::Implementation
     {
-      /// \brief Attempt to load a library at the given path.
+      /// \brief Serializes the functions that modify the Loader, and protects
+      /// every member below except for `filePlugins`. Functions that only
+      /// read the plugins of the Loader never lock it, because they use a
+      /// snapshot of `filePlugins` instead. None of the member functions of
+      /// this class lock it themselves.
+      public: std::mutex mutex;
+
+      /// \brief A library which has been opened and queried for its plugins,
+      /// but which has not been registered with the Loader yet.
+      public: struct OpenedLib
+      {
+        /// \brief The path that the library was opened from
+        std::string path;
+
+        /// \brief The raw handle produced by dlopen, or a nullptr if the
+        /// library could not be loaded.
+        void *dlHandle = nullptr;
+
+        /// \brief The Info provided by the library, with the plugin names
+        /// already demangled and the demangled interfaces filled in.
+        std::vector<Info> plugins;
+      };
+
+      /// \brief Ask the operating system to begin reading the file at the
+      /// given path into its page cache. This does not block, and it does
+      /// nothing if the file cannot be opened.
+      /// \param[in] _pathToLibrary The path to a library
+      public: static void Readahead(const std::string &_pathToLibrary);
+
+      /// \brief Open the library at the given path and extract its Info. This
+      /// does not touch any member variables of the Loader, so it is safe to
+      /// call it from several threads at once.
       /// \param[in] _pathToLibrary The full path to the desired library
-      /// \return If a library exists at the given path, get a point to its dl
-      /// handle. If the library does not exist, get a nullptr.
-      public: std::shared_ptr<void> LoadLib(
-        const std::string &_pathToLibrary, bool _noDelete);
-
-      /// \brief Using a dl handle produced by LoadLib, extract the
+      /// \param[in] _noDelete If true, RTLD_NODELETE will be used.
+      /// \return The opened library. Its dlHandle will be a nullptr if the
+      /// library could not be loaded.
+      public: OpenedLib OpenLib(
+        const std::string &_pathToLibrary, bool _noDelete) const;
+
+      /// \brief Close a library that was opened by OpenLib(~) but never
+      /// registered. This undoes the dlopen of OpenLib(~), so the library
+      /// is unloaded unless something else still holds it.
+      /// \param[in,out] _lib The library. Its dlHandle is set to a nullptr.
+      public: static void CloseLib(OpenedLib &_lib);
+
+      /// \brief Get the reference-counting pointer that this Loader uses for
+      /// a raw dl handle, creating it if necessary.
+      /// \param[in] _dlHandle A raw handle produced by dlopen
+      /// \return The reference-counting pointer for the dl handle.
+      public: std::shared_ptr<void> AcquireDlHandle(void *_dlHandle);
+
+      /// \brief Things that were taken out of this Loader while `mutex` was
+      /// locked. Releasing them might run plugin destructors or unload
+      /// libraries, which may use the Loader themselves, so they must only be
+      /// released once `mutex` has been unlocked. Declaring the Garbage
+      /// before the lock guard makes it outlive the lock.
+      public: using Garbage = std::vector<std::shared_ptr<const void>>;
+
+      /// \brief Put the Info of an opened library into the manifest cache of
+      /// this Loader, if it has one. This locks `mutex` only briefly, so it
+      /// must not be locked already.
+      /// \param[in] _lib A library produced by OpenLib
+      public: void StoreManifest(const OpenedLib &_lib);
+
+      /// \brief Register the plugins of opened libraries with this Loader.
+      /// The plugins of all the libraries are published at once, and the
+      /// result is the same as registering the libraries one at a time, in
+      /// order.
+      /// \param[in,out] _libs Libraries produced by OpenLib. Their handles
+      /// and plugins will be moved out of them.
+      /// \param[in] _count The number of libraries at the front of `_libs`
+      /// to register
+      /// \param[out] _garbage Receives what must be released after unlocking
+      /// \return The set of plugins that have been loaded from each library
+      public: std::vector<std::unordered_set<std::string>> RegisterLibs(
+        std::vector<OpenedLib> &_libs, std::size_t _count, Garbage &_garbage);
+
+      /// \brief Using a dl handle produced by dlopen, extract the
       /// Info from the loaded library.
-      /// \param[in] _dlHandle A handle produced by LoadLib
+      /// \param[in] _dlHandle A handle produced by dlopen
       /// \param[in] _pathToLibrary The path that the library was loaded from
       /// (used for debug purposes)
       /// \return All the Info provided by the loaded library.
       public: std::vector<Info> LoadPlugins(
-        const std::shared_ptr<void> &_dlHandle,
+        void *_dlHandle,
         const std::string &_pathToLibrary) const;
 
       /// \sa Loader::ForgetLibrary()
-      public: bool ForgetLibrary(void *_dlHandle);
-
-      public: using PluginToDlHandleMap =
-          std::unordered_map< std::string, std::shared_ptr<void> >;
-      /// \brief A map from known plugin names to the handle of the library that
-      /// provides it.
-      ///
-      /// CRUCIAL DEV NOTE (MXG): `pluginToDlHandlePtrs` MUST come BEFORE
-      /// `plugins` in this class definition to ensure that `plugins` gets
-      /// deleted first (member variables get destructed in the reverse order of
-      /// their appearance in the class definition). The destructors of the
-      /// `deleter` members of the Info class depend on the shared library
-      /// still being available, so this map of std::shared_ptrs to the library
-      /// handles must be destroyed after the Info.
-      ///
-      /// If you change this class definition for ANY reason, be sure to
-      /// maintain the ordering of these member variables.
-      public: PluginToDlHandleMap pluginToDlHandlePtrs;
-
-      /// CRUCIAL DEV NOTE (MXG): `filePlugins` MUST come AFTER
-      /// `pluginToDlHandlePtrs` in this class definition. See the comment on
-      /// pluginToDlHandlePtrs for an explanation.
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: bool ForgetLibrary(void *_dlHandle, Garbage &_garbage);
+
+      /// \sa Loader::LookupPlugin()
+      public: std::string LookupPlugin(const std::string &_nameOrAlias) const;
+
+      /// \brief Check whether an Info was registered from a manifest, so
+      /// that its library has not been loaded.
+      /// \param[in] _info The Info to check
+      /// \return True if the Info is only a placeholder for the metadata of
+      /// a plugin.
+      public: static bool IsPlaceholder(const Info &_info);
+
+      /// \brief Find the names and aliases that would resolve differently
+      /// once a plugin has been added to a snapshot. This must be called
+      /// before the plugin gets added.
+      /// \param[in] _plugins The snapshot that the plugin will be added to
+      /// \param[in] _info The Info of the plugin
+      /// \param[out] _claims Receives the names and aliases
+      public: static void CollectClaims(
+        const Registry::Snapshot &_plugins,
+        const Info &_info,
+        std::unordered_set<std::string> &_claims);
+
+      /// \brief Make the Info of a plugin from its descriptor. Only plain
+      /// functions of the library get copied into the Info.
+      /// \param[in] _plugin The descriptor provided by a library
+      /// \return The Info of the plugin
+      public: static Info InfoFromDescriptor(
+          const detail::PluginDescriptor &_plugin);
+
+      /// \brief A library whose plugins were registered from a manifest. It
+      /// gets loaded the first time that one of its plugins is instantiated.
+      public: struct LazyLib
+      {
+        /// \brief Path to the library
+        std::string path;
+
+        /// \brief Whether RTLD_NODELETE should be used to load the library
+        bool noDelete = false;
+
+        /// \brief Names of the placeholder plugins that are registered for
+        /// this library. This is only used while the `mutex` of the Loader is
+        /// locked.
+        std::unordered_set<std::string> plugins;
+
+        /// \brief Protects the members below while they are filled in by the
+        /// first instantiation of a plugin from this library.
+        std::mutex mutex;
+
+        /// \brief True once we have tried to load the library. The members
+        /// below never change after that, so they may be read without
+        /// locking `mutex` once this is true.
+        std::atomic<bool> loaded{false};
+
+        /// \brief Reference-counting handle of the library once it is loaded
+        ///
+        /// CRUCIAL DEV NOTE: `dlHandle` MUST come BEFORE `resolved` so
+        /// that the Info gets destructed while the library is still loaded.
+        std::shared_ptr<void> dlHandle;
+
+        /// \brief The interface tables of the plugins of the library, made
+        /// from their real Info once it is loaded, keyed by plugin name.
+        std::unordered_map<std::string, detail::ConstInterfaceTablePtr>
+            resolved;
+      };
+      public: using LazyLibPtr = std::shared_ptr<LazyLib>;
+
+      /// \brief Get the real interface table and library handle for a plugin
+      /// which was
+      /// registered from a manifest, loading its library if this is the first
+      /// time. This is safe to call from several threads at once, and it does
+      /// not need `mutex` to be locked.
+      /// \param[in] _lazyLib The library that provides the plugin
+      /// \param[in] _pluginName Resolved name of the plugin
+      /// \param[out] _table The interface table made from the real Info of
+      /// the plugin
+      /// \param[out] _dlHandle The handle of the library of the plugin
+      /// \return False if the library could not provide the plugin
+      public: bool ResolveLazyPlugin(
+        LazyLib &_lazyLib,
+        const std::string &_pluginName,
+        detail::ConstInterfaceTablePtr &_table,
+        std::shared_ptr<void> &_dlHandle) const;
+
+      /// \brief Get the interface table that a plugin name or alias resolves
+      /// to right now, without loading any library. This is used to check
+      /// whether a plugin that was resolved earlier is still current.
+      /// \param[in] _pluginNameOrAlias Name or alias of the plugin
+      /// \return The interface table of the plugin, or a nullptr if there is
+      /// no such plugin or if its library has not been loaded yet
+      public: detail::ConstInterfaceTablePtr CurrentTable(
+        const std::string &_pluginNameOrAlias) const;
+
+      /// \brief Remove the placeholder of a plugin from the registry.
+      /// \param[in] _plugins The snapshot of `filePlugins` that is being
+      /// updated
+      /// \param[in] _pluginName Name of the placeholder plugin
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: void ForgetPlaceholder(
+        Registry::Snapshot &_plugins,
+        const std::string &_pluginName,
+        Garbage &_garbage);
+
+      /// \brief Forget a library that was registered from a manifest,
+      /// whether or not it has been loaded.
+      /// \param[in] _lazyLib The library to forget
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: void ForgetLazyLib(const LazyLibPtr &_lazyLib, Garbage &_garbage);
+
+      /// \brief Remove the instance pools of some plugins. The instances that
+      /// are ready in those pools get deleted once no ResolvedPlugin refers
+      /// to the pools anymore.
+      /// \param[in] _plugins Resolved names of the plugins
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: void ForgetPools(
+        const std::unordered_set<std::string> &_plugins, Garbage &_garbage);
+
+      /// \brief Find the instance pool of a plugin. This does not need
+      /// `mutex` to be locked.
+      /// \param[in] _resolvedName Resolved name of the plugin
+      /// \return The pool of the plugin, or a nullptr if it has none
+      public: std::shared_ptr<InstancePool> FindPool(
+        const std::string &_resolvedName) const;
+
+      /// \brief Drop the instances that Factory<T>(~) has cached for some
+      /// plugins. Factories that are still in use keep working.
+      /// \param[in] _plugins Resolved names of the plugins
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: void ForgetFactories(
+        const std::unordered_set<std::string> &_plugins, Garbage &_garbage);
+
+      /// \brief Drop the instances that Factory<T>(~) has cached under some
+      /// names or aliases, because those now resolve to different plugins.
+      /// The same instances stay cached under their other names and aliases.
+      /// \param[in] _namesOrAliases The names or aliases
+      /// \param[out] _garbage Receives what must be released after unlocking
+      public: void ForgetFactoriesRequestedAs(
+        const std::unordered_set<std::string> &_namesOrAliases,
+        Garbage &_garbage);
+
+      /// \brief Cache the instance that Factory<T>(~) hands out for a plugin
+      /// under a name or alias. This must be called while `mutex` is locked.
+      /// \param[in] _nameOrAlias The name or alias that the plugin was
+      /// requested with
+      /// \param[in] _resolvedName Resolved name of the plugin
+      /// \param[in] _plugin The instance to cache if the plugin does not
+      /// have one yet
+      /// \param[out] _garbage Receives what must be released after unlocking
+      /// \return The instance which is cached for the plugin
+      public: PluginPtr CacheFactory(
+        const std::string &_nameOrAlias,
+        const std::string &_resolvedName,
+        const PluginPtr &_plugin,
+        Garbage &_garbage);
+
+      /// \brief Optional cache of the plugin metadata of libraries
+      public: std::shared_ptr<ManifestCache> manifestCache;
+
+      /// \brief Libraries which were registered from a manifest, keyed by
+      /// the path that was given to DiscoverLib(~).
+      public: std::unordered_map<std::string, LazyLibPtr> lazyLibs;
+
+      /// \brief The plugins which were loaded from files.
       ///
-      /// If you change this class definition for ANY reason, be sure to
-      /// maintain the ordering of these member variables.
+      /// The entry of each plugin holds the reference-counting handle of the
+      /// library that provides it, so that its Info gets destructed while the
+      /// library is still loaded. The entry of a placeholder plugin holds its
+      /// LazyLib instead.
       public: Registry filePlugins;
 
       using DlHandleMap = std::unordered_map< void*, std::weak_ptr<void> >;
@@ -110,6 +339,258 @@ namespace gz
 
       /// \brief Pointer to the singleton StaticRegistry
       public: StaticRegistry* staticPlugins;
+
+      public: using PoolMap =
+          std::unordered_map<std::string, std::shared_ptr<InstancePool>>;
+      /// \brief The instance pools of plugins, keyed by the resolved names of
+      /// the plugins. Just like the snapshots of a Registry, the map is never
+      /// modified once it has been published. It must only be accessed
+      /// through the std::atomic_load and std::atomic_store family of
+      /// functions, and it may only be replaced while `mutex` is locked.
+      public: std::shared_ptr<const PoolMap> pools;
+
+      /// \brief True while `pools` is not empty. This lets Resolve(~) skip
+      /// looking for a pool when no plugin has one.
+      public: std::atomic<bool> hasPools{false};
+
+      /// \brief A plugin instance that is cached for Factory<T>(~)
+      public: struct CachedFactory
+      {
+        /// \brief Resolved name of the plugin
+        std::string resolvedName;
+
+        /// \brief The instance that gets handed out
+        PluginPtr plugin;
+      };
+
+      public: using FactoryMap =
+          std::unordered_map<std::string, CachedFactory>;
+      /// \brief The instances that Factory<T>(~) hands out. Each one is keyed
+      /// by the resolved name of its plugin, and also by every name or alias
+      /// that it was requested with, so that a cached instance is found with
+      /// a single lookup. This map is published the same way as `pools`.
+      ///
+      /// When a library gets registered, the entries of the names and aliases
+      /// that its plugins claim are dropped, because those names and aliases
+      /// may now resolve to different plugins. The entries of a library are
+      /// dropped when it gets forgotten.
+      public: std::shared_ptr<const FactoryMap> factories;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Keeps constructed instances of one plugin ready to be handed
+    /// out, and takes them back once they have been released and reset.
+    class Loader::InstancePool
+        : public std::enable_shared_from_this<Loader::InstancePool>
+    {
+      /// \brief Constructor
+      /// \param[in] _library Object that keeps the library of the plugin
+      /// loaded, or a nullptr for a static plugin
+      /// \param[in] _table The interface table of the plugin
+      public: InstancePool(
+        const std::shared_ptr<void> &_library,
+        const detail::ConstInterfaceTablePtr &_table)
+        : library(_library),
+          table(_table)
+      {
+        // Do nothing
+      }
+
+      /// \brief Take an instance that is ready, or construct a new one if
+      /// there is none. Either way, the instance is offered back to this pool
+      /// once the returned pointer and all of its copies are gone.
+      /// \return The abstract instance
+      public: std::shared_ptr<void> Acquire()
+      {
+        std::shared_ptr<void> instance;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          if (!this->idle.empty())
+          {
+            instance = std::move(this->idle.back());
+            this->idle.pop_back();
+            ++this->stats.hits;
+          }
+          else
+          {
+            ++this->stats.misses;
+          }
+        }
+
+        // Plugin constructors may be slow, so they never run while the pool
+        // is locked.
+        if (!instance)
+        {
+          instance = Plugin::PrivateCreateDetachedInstance(
+                this->table, this->library);
+        }
+
+        if (!instance)
+          return nullptr;
+
+        const std::shared_ptr<Lease> lease = std::make_shared<Lease>(
+              this->weak_from_this(), std::move(instance));
+
+        return std::shared_ptr<void>(lease, lease->instance.get());
+      }
+
+      /// \brief Set the capacity of this pool, and construct instances until
+      /// that many are ready.
+      /// \param[in] _capacity The new capacity
+      /// \return The number of instances that are ready
+      public: std::size_t Warm(const std::size_t _capacity)
+      {
+        std::size_t missing = 0;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->stats.capacity = _capacity;
+          if (this->idle.size() < _capacity)
+            missing = _capacity - this->idle.size();
+        }
+
+        std::vector<std::shared_ptr<void>> instances;
+        instances.reserve(missing);
+        for (std::size_t i = 0; i < missing; ++i)
+        {
+          instances.push_back(Plugin::PrivateCreateDetachedInstance(
+                this->table, this->library));
+        }
+
+        // Instances that do not fit anymore, because the pool was filled up
+        // or given a smaller capacity in the meantime, get deleted once the
+        // lock has been released.
+        std::vector<std::shared_ptr<void>> excess;
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (std::shared_ptr<void> &instance : instances)
+          this->idle.push_back(std::move(instance));
+
+        while (this->idle.size() > this->stats.capacity)
+        {
+          excess.push_back(std::move(this->idle.back()));
+          this->idle.pop_back();
+        }
+
+        return this->idle.size();
+      }
+
+      /// \brief Delete the instances that are ready, except for some.
+      /// \param[in] _keep The number of instances to keep
+      /// \return The number of instances that were deleted
+      public: std::size_t Trim(const std::size_t _keep)
+      {
+        // The instances get deleted once the lock has been released.
+        std::vector<std::shared_ptr<void>> excess;
+        std::lock_guard<std::mutex> lock(this->mutex);
+        while (this->idle.size() > _keep)
+        {
+          excess.push_back(std::move(this->idle.back()));
+          this->idle.pop_back();
+        }
+
+        return excess.size();
+      }
+
+      /// \brief Get the counters of this pool
+      /// \return The counters
+      public: PoolStats Stats() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        PoolStats result = this->stats;
+        result.idle = this->idle.size();
+        return result;
+      }
+
+      /// \brief Reset an instance that has been released, and keep it if
+      /// there is room for it. Otherwise it gets deleted.
+      /// \param[in] _instance The instance
+      private: void Release(std::shared_ptr<void> _instance)
+      {
+        const InterfaceId &id = InterfaceIdOf<Resettable>();
+        Resettable *resettable = static_cast<Resettable*>(this->table->Find(
+              _instance.get(), typeid(Resettable).name(),
+              id.hash, id.ambiguous));
+
+        if (!resettable)
+          return;
+
+        // The instance is not referred to by anything else at this point, so
+        // it can be reset without locking the pool.
+        //
+        // Dev note: This runs inside the destructor of a Lease, so an
+        // exception must not escape from here. An instance whose Reset()
+        // throws is in an unknown state, so it gets deleted.
+        bool reset = false;
+        try
+        {
+          reset = resettable->Reset();
+        }
+        catch (...)
+        {
+          reset = false;
+        }
+
+        if (!reset)
+          return;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->idle.size() < this->stats.capacity)
+        {
+          this->idle.push_back(std::move(_instance));
+          ++this->stats.recycled;
+        }
+
+        // Dev note: If the pool is full, _instance gets deleted when this
+        // function returns, which is after the lock has been released.
+      }
+
+      /// \brief Holds an instance while it is handed out, and offers it back
+      /// to its pool when it is released.
+      private: struct Lease
+      {
+        /// \brief Constructor
+        public: Lease(std::weak_ptr<InstancePool> _pool,
+                      std::shared_ptr<void> _instance)
+          : pool(std::move(_pool)),
+            instance(std::move(_instance))
+        {
+          // Do nothing
+        }
+
+        /// \brief Destructor. If the pool still exists, the instance is
+        /// given back to it.
+        public: ~Lease()
+        {
+          if (const std::shared_ptr<InstancePool> p = this->pool.lock())
+            p->Release(std::move(this->instance));
+        }
+
+        /// \brief The pool that handed out the instance
+        public: std::weak_ptr<InstancePool> pool;
+
+        /// \brief The instance. It keeps the library of the plugin loaded.
+        public: std::shared_ptr<void> instance;
+      };
+
+      /// \brief Object that keeps the library of the plugin loaded. This is a
+      /// nullptr for static plugins.
+      ///
+      /// CRUCIAL DEV NOTE: `library` MUST come BEFORE `table` so that the
+      /// Info gets destructed while the library is still loaded.
+      public: const std::shared_ptr<void> library;
+
+      /// \brief The interface table of the plugin
+      public: const detail::ConstInterfaceTablePtr table;
+
+      /// \brief Protects the members below
+      private: mutable std::mutex mutex;
+
+      /// \brief The instances that are ready to be handed out. Each of them
+      /// keeps the library of the plugin loaded on its own.
+      private: std::vector<std::shared_ptr<void>> idle;
+
+      /// \brief The counters and the capacity of this pool. Its `idle` field
+      /// is not used.
+      private: PoolStats stats;
     };
 
     /////////////////////////////////////////////////
@@ -146,47 +627,229 @@ namespace gz
     std::unordered_set<std::string> Loader::LoadLib(
         const std::string &_pathToLibrary, bool _noDelete)
     {
-      std::unordered_set<std::string> newPlugins;
+      // Opening the library does not touch the state of the Loader, so other
+      // threads can keep using it in the meantime.
+      Implementation::OpenedLib lib =
+          this->dataPtr->OpenLib(_pathToLibrary, _noDelete);
+      this->dataPtr->StoreManifest(lib);
+
+      std::vector<Implementation::OpenedLib> libs(1);
+      libs[0] = std::move(lib);
+
+      Implementation::Garbage garbage;
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      return std::move(this->dataPtr->RegisterLibs(libs, 1, garbage)[0]);
+    }
 
-      // Attempt to load the library at this path
-      const std::shared_ptr<void> &dlHandle =
-          this->dataPtr->LoadLib(_pathToLibrary, _noDelete);
+    /////////////////////////////////////////////////
+    std::vector<std::unordered_set<std::string>> Loader::LoadLibs(
+        const std::vector<std::string> &_pathsToLibraries,
+        bool _noDelete)
+    {
+      const std::size_t numLibs = _pathsToLibraries.size();
+      std::vector<std::unordered_set<std::string>> newPlugins(numLibs);
 
-      // Quit early and return an empty set of plugin names if we did not
-      // actually get a valid dlHandle.
-      if (nullptr == dlHandle)
-      {
+      if (0 == numLibs)
         return newPlugins;
-      }
 
-      // Found a shared library, does it have the symbols we're looking for?
-      std::vector<Info> loadedPlugins = this->dataPtr->LoadPlugins(
-            dlHandle, _pathToLibrary);
+      const std::size_t numWorkers = std::min<std::size_t>(
+            numLibs, std::max(1u, std::thread::hardware_concurrency()));
+
+      std::vector<Implementation::OpenedLib> openedLibs(numLibs);
+      std::vector<std::exception_ptr> errors(numLibs);
+      std::vector<char> opened(numLibs, false);
+      std::mutex openedMutex;
+      std::condition_variable openedCv;
+      std::atomic<std::size_t> nextLib(0);
 
-      for (Info &plugin : loadedPlugins)
+      // Each worker claims the next library that nobody has opened yet, opens
+      // it and hands it back to this thread for registration.
+      const auto work = [&]()
       {
-        // Demangle the plugin name before creating an entry for it.
-        plugin.name = DemangleSymbol(plugin.name);
+        for (std::size_t i = nextLib++; i < numLibs; i = nextLib++)
+        {
+          // Get the operating system started on reading the file that this
+          // worker will most likely claim next, while it opens this one.
+          if (i + numWorkers < numLibs)
+            Implementation::Readahead(_pathsToLibraries[i + numWorkers]);
+
+          // An exception must not escape from a std::thread, so it gets
+          // handed to this thread in place of the library instead.
+          Implementation::OpenedLib lib;
+          std::exception_ptr error;
+          try
+          {
+            lib = this->dataPtr->OpenLib(_pathsToLibraries[i], _noDelete);
+            this->dataPtr->StoreManifest(lib);
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+          }
+
+          {
+            std::lock_guard<std::mutex> lock(openedMutex);
+            openedLibs[i] = std::move(lib);
+            errors[i] = std::move(error);
+            opened[i] = true;
+          }
+          openedCv.notify_one();
+        }
+      };
 
-        // Make a list of the demangled interface names for later convenience.
-        for (auto const &interface : plugin.interfaces)
-          plugin.demangledInterfaces.insert(DemangleSymbol(interface.first));
+      /// \brief Stops the workers and waits for them when LoadLibs(~) is
+      /// left, including by an exception, because destroying a joinable
+      /// std::thread would terminate the program. Then it closes every
+      /// library that was opened but never registered.
+      struct WorkerGuard
+      {
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> &nextLib;
+        std::size_t numLibs;
+        std::vector<Implementation::OpenedLib> &openedLibs;
+
+        ~WorkerGuard()
+        {
+          // Workers finish the library that they are opening, but they do
+          // not claim any more.
+          this->nextLib = this->numLibs;
+          for (std::thread &worker : this->workers)
+            worker.join();
+
+          for (Implementation::OpenedLib &lib : this->openedLibs)
+            Implementation::CloseLib(lib);
+        }
+      };
 
-        // Add the plugin to the map
-        this->dataPtr->filePlugins.AddInfo(plugin);
+      WorkerGuard guard{{}, nextLib, numLibs, openedLibs};
+      guard.workers.reserve(numWorkers);
+      for (std::size_t i = 0; i < numWorkers; ++i)
+        guard.workers.emplace_back(work);
 
-        // Add the plugin's name to the set of newPlugins
-        newPlugins.insert(plugin.name);
+      // Wait until every library has been opened, or until one of them has
+      // failed.
+      std::size_t numOpened = 0;
+      std::exception_ptr error;
+      {
+        std::unique_lock<std::mutex> lock(openedMutex);
+        for (; numOpened < numLibs; ++numOpened)
+        {
+          openedCv.wait(lock, [&]() { return opened[numOpened] != 0; });
+          if (errors[numOpened])
+          {
+            error = errors[numOpened];
+            break;
+          }
+        }
+      }
 
-        // Save the dl handle for this plugin
-        this->dataPtr->pluginToDlHandlePtrs[plugin.name] = dlHandle;
+      // Dev note: The libraries are registered in the order of the paths
+      // that were given to us, so that the Loader ends up in exactly the same
+      // state that a sequence of LoadLib(~) calls would have produced (e.g.
+      // which library wins when two of them provide a plugin with the same
+      // name). They are published in a single update of the registry, so the
+      // batch costs one copy of the registry instead of one per library.
+      {
+        Implementation::Garbage garbage;
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        std::vector<std::unordered_set<std::string>> registered =
+            this->dataPtr->RegisterLibs(openedLibs, numOpened, garbage);
+        std::move(registered.begin(), registered.end(), newPlugins.begin());
       }
 
-      dataPtr->dlHandleToPluginMap[dlHandle.get()] = newPlugins;
+      // Libraries further down the list which were already opened get closed
+      // again by the guard, just as if LoadLib(~) had never been called on
+      // them.
+      if (error)
+        std::rethrow_exception(error);
 
       return newPlugins;
     }
 
+    /////////////////////////////////////////////////
+    std::future<std::vector<std::unordered_set<std::string>>>
+    Loader::LoadLibsAsync(
+        const std::vector<std::string> &_pathsToLibraries,
+        bool _noDelete)
+    {
+      return std::async(std::launch::async,
+            [this, _pathsToLibraries, _noDelete]()
+      {
+        return this->LoadLibs(_pathsToLibraries, _noDelete);
+      });
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::SetManifestCache(const std::shared_ptr<ManifestCache> &_cache)
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->manifestCache = _cache;
+    }
+
+    /////////////////////////////////////////////////
+    std::unordered_set<std::string> Loader::DiscoverLib(
+        const std::string &_pathToLibrary, bool _noDelete)
+    {
+      std::shared_ptr<ManifestCache> manifestCache;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        manifestCache = this->dataPtr->manifestCache;
+      }
+
+      // The ManifestCache does its own locking, so the files are read without
+      // holding up the other users of this Loader.
+      std::vector<Info> manifest;
+      if (!manifestCache || !manifestCache->Lookup(_pathToLibrary, manifest))
+      {
+        // Without a cache entry, we can still avoid loading the library if
+        // the registration macros left a description of its plugins in it.
+        if (!ReadPluginMetadata(_pathToLibrary, manifest))
+          return this->LoadLib(_pathToLibrary, _noDelete);
+
+        if (manifestCache)
+          manifestCache->Store(_pathToLibrary, manifest);
+      }
+
+      Implementation::Garbage garbage;
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+      Implementation::LazyLibPtr &lazyLib =
+          this->dataPtr->lazyLibs[_pathToLibrary];
+      if (!lazyLib)
+      {
+        lazyLib = std::make_shared<Implementation::LazyLib>();
+        lazyLib->path = _pathToLibrary;
+        lazyLib->noDelete = _noDelete;
+      }
+
+      std::unordered_set<std::string> discoveredPlugins;
+      std::unordered_set<std::string> claims;
+      garbage.push_back(this->dataPtr->filePlugins.Update(
+          [&](Registry::Snapshot &_plugins)
+      {
+        for (const Info &plugin : manifest)
+        {
+          discoveredPlugins.insert(plugin.name);
+          Implementation::CollectClaims(_plugins, plugin, claims);
+
+          // Dev note: Just like for loaded libraries, a plugin name that
+          // is already known keeps its current Info.
+          if (_plugins.AddInfo(std::make_shared<Info>(plugin), lazyLib))
+            lazyLib->plugins.insert(plugin.name);
+        }
+      }));
+
+      // If every plugin of the library was already known, then there is
+      // nothing to load lazily.
+      if (lazyLib->plugins.empty())
+        this->dataPtr->lazyLibs.erase(_pathToLibrary);
+
+      // The new plugins might shadow a cached plugin or one of its aliases
+      this->dataPtr->ForgetFactoriesRequestedAs(claims, garbage);
+
+      return discoveredPlugins;
+    }
+
     /////////////////////////////////////////////////
     std::unordered_set<std::string> Loader::InterfacesImplemented() const
     {
@@ -251,17 +914,24 @@ namespace gz
 
     /////////////////////////////////////////////////
     std::string Loader::LookupPlugin(const std::string &_nameOrAlias) const
+    {
+      return this->dataPtr->LookupPlugin(_nameOrAlias);
+    }
+
+    /////////////////////////////////////////////////
+    std::string Loader::Implementation::LookupPlugin(
+        const std::string &_nameOrAlias) const
     {
       // Higher priority for plugins loaded from file than from the static
       // registry.
       std::string nameInFilePlugins =
-          this->dataPtr->filePlugins.LookupPlugin(_nameOrAlias);
+          this->filePlugins.LookupPlugin(_nameOrAlias);
       if (!nameInFilePlugins.empty()) {
         return nameInFilePlugins;
       }
 
       std::string nameInStaticPlugins =
-          this->dataPtr->staticPlugins->LookupPlugin(_nameOrAlias);
+          this->staticPlugins->LookupPlugin(_nameOrAlias);
       if (!nameInStaticPlugins.empty()) {
         return nameInStaticPlugins;
       }
@@ -275,41 +945,320 @@ namespace gz
     /////////////////////////////////////////////////
     PluginPtr Loader::Instantiate(const std::string &_pluginNameOrAlias) const
     {
+      return this->Resolve(_pluginNameOrAlias).Instantiate();
+    }
+
+    /////////////////////////////////////////////////
+    PluginPtr Loader::Instantiate(
+        const std::string &_pluginNameOrAlias,
+        std::pmr::memory_resource *_resource) const
+    {
+      return this->Resolve(_pluginNameOrAlias).Instantiate(_resource);
+    }
+
+    /////////////////////////////////////////////////
+    std::vector<PluginPtr> Loader::InstantiateMany(
+        const std::string &_pluginNameOrAlias,
+        const std::size_t _count) const
+    {
+      return this->Resolve(_pluginNameOrAlias).InstantiateMany(_count);
+    }
+
+    /////////////////////////////////////////////////
+    Loader::ResolvedPlugin Loader::Resolve(
+        const std::string &_pluginNameOrAlias) const
+    {
+      // Dev note: The name, Info and library handle of the plugin must all
+      // come from the same snapshot, because another thread might forget or
+      // replace the plugin at any moment.
+      const Registry::ConstSnapshotPtr filePlugins =
+          this->dataPtr->filePlugins.GetSnapshot();
+
+      ResolvedPlugin resolved;
+
       // Higher priority for plugins loaded from file than from the static
       // registry.
-      const std::string &resolvedNameForFilePlugin =
-          this->PrivateLookupFilePlugin(_pluginNameOrAlias);
+      const std::string resolvedNameForFilePlugin =
+          filePlugins->LookupPlugin(_pluginNameOrAlias);
 
-      const std::string &resolvedNameForStaticPlugin =
-            this->PrivateLookupStaticPlugin(_pluginNameOrAlias);
+      if (!resolvedNameForFilePlugin.empty())
+      {
+        const Registry::Snapshot::Entry *entry =
+            filePlugins->FindPlugin(resolvedNameForFilePlugin);
 
-      PluginPtr ptr;
+        // If the plugin was registered from a manifest, then its entry holds
+        // the library that needs to be loaded.
+        if (Implementation::IsPlaceholder(*entry->info))
+        {
+          if (!this->dataPtr->ResolveLazyPlugin(
+                *std::static_pointer_cast<Implementation::LazyLib>(
+                  entry->library),
+                resolvedNameForFilePlugin, resolved.table, resolved.library))
+          {
+            return ResolvedPlugin();
+          }
+        }
+        else
+        {
+          resolved.library = entry->library;
+          resolved.table = entry->table;
+        }
+      }
+      else
+      {
+        const Registry::ConstSnapshotPtr staticPlugins =
+            this->dataPtr->staticPlugins->GetSnapshot();
 
-      if (!resolvedNameForFilePlugin.empty())
+        const Registry::Snapshot::Entry *entry = staticPlugins->FindPlugin(
+              staticPlugins->LookupPlugin(_pluginNameOrAlias));
+
+        if (nullptr == entry)
+          return ResolvedPlugin();
+
+        resolved.table = entry->table;
+      }
+
+      if (!resolved.table)
+        return ResolvedPlugin();
+
+      resolved.enablePluginFromThis =
+          resolved.table->GetInfo()->interfaces.count(
+            typeid(EnablePluginFromThis).name()) > 0;
+
+      resolved.shared = resolved.table->IsShared();
+
+      if (!resolved.shared
+          && this->dataPtr->hasPools.load(std::memory_order_acquire))
       {
-        ptr = PluginPtr(
-            this->PrivateGetInfoForFilePlugin(resolvedNameForFilePlugin),
-            this->PrivateGetPluginDlHandlePtr(resolvedNameForFilePlugin));
+        // A pool that was made for a different Info of the same name, e.g.
+        // for a static plugin that has since been shadowed by a plugin from a
+        // file, must not be used.
+        std::shared_ptr<InstancePool> pool =
+            this->dataPtr->FindPool(resolved.table->GetInfo()->name);
+        if (pool && pool->table == resolved.table)
+          resolved.pool = std::move(pool);
       }
-      else if (!resolvedNameForStaticPlugin.empty())
+
+      return resolved;
+    }
+
+    /////////////////////////////////////////////////
+    std::size_t Loader::WarmPool(
+        const std::string &_pluginNameOrAlias,
+        const std::size_t _capacity)
+    {
+      // Dev note: The plugin is resolved while the lock is NOT held, because
+      // resolving it might load its library.
+      std::shared_ptr<InstancePool> pool;
+      while (true)
       {
-        ptr = PluginPtr(
-            this->PrivateGetInfoForStaticPlugin(resolvedNameForStaticPlugin));
+        const ResolvedPlugin resolved = this->Resolve(_pluginNameOrAlias);
+        if (!resolved || resolved.shared)
+          return 0;
+
+        Implementation::Garbage garbage;
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+        // If the library of the plugin was forgotten, or another library took
+        // over its name or alias, then the pool must not be published.
+        if (this->dataPtr->CurrentTable(_pluginNameOrAlias) != resolved.table)
+          continue;
+
+        const std::string &resolvedName = resolved.table->GetInfo()->name;
+        const std::shared_ptr<const Implementation::PoolMap> current =
+            std::atomic_load(&this->dataPtr->pools);
+
+        auto pools = current ?
+            std::make_shared<Implementation::PoolMap>(*current) :
+            std::make_shared<Implementation::PoolMap>();
+
+        if (0 == _capacity)
+        {
+          pools->erase(resolvedName);
+        }
+        else
+        {
+          std::shared_ptr<InstancePool> &slot = (*pools)[resolvedName];
+          if (!slot || slot->table != resolved.table)
+          {
+            slot = std::make_shared<InstancePool>(
+                  resolved.library, resolved.table);
+          }
+
+          pool = slot;
+        }
+
+        this->dataPtr->hasPools.store(
+              !pools->empty(), std::memory_order_release);
+        std::atomic_store(&this->dataPtr->pools,
+            std::shared_ptr<const Implementation::PoolMap>(std::move(pools)));
+
+        // A pool that was dropped deletes its instances
+        garbage.push_back(current);
+        break;
+      }
+
+      // The instances are constructed without holding up the other users of
+      // this Loader.
+      if (!pool)
+        return 0;
+
+      return pool->Warm(_capacity);
+    }
+
+    /////////////////////////////////////////////////
+    std::size_t Loader::TrimPool(
+        const std::string &_pluginNameOrAlias,
+        const std::size_t _keep)
+    {
+      const std::shared_ptr<InstancePool> pool =
+          this->dataPtr->FindPool(this->LookupPlugin(_pluginNameOrAlias));
+      if (!pool)
+        return 0;
+
+      return pool->Trim(_keep);
+    }
+
+    /////////////////////////////////////////////////
+    std::size_t Loader::TrimPools(const std::size_t _keep)
+    {
+      const std::shared_ptr<const Implementation::PoolMap> pools =
+          std::atomic_load(&this->dataPtr->pools);
+      if (!pools)
+        return 0;
+
+      std::size_t trimmed = 0;
+      for (const auto &pool : *pools)
+        trimmed += pool.second->Trim(_keep);
+
+      return trimmed;
+    }
+
+    /////////////////////////////////////////////////
+    Loader::PoolStats Loader::PoolStatsOf(
+        const std::string &_pluginNameOrAlias) const
+    {
+      const std::shared_ptr<InstancePool> pool =
+          this->dataPtr->FindPool(this->LookupPlugin(_pluginNameOrAlias));
+      if (!pool)
+        return PoolStats();
+
+      return pool->Stats();
+    }
+
+    /////////////////////////////////////////////////
+    PluginPtr Loader::ResolvedPlugin::Instantiate() const
+    {
+      return this->Instantiate(nullptr);
+    }
+
+    /////////////////////////////////////////////////
+    PluginPtr Loader::ResolvedPlugin::Instantiate(
+        std::pmr::memory_resource *_resource) const
+    {
+      if (!this->table)
+        return PluginPtr();
+
+      // The shared instance had its EnablePluginFromThis set up when it was
+      // created.
+      if (this->shared)
+      {
+        return PluginPtr::PrivateMakeFromInstance(
+              this->table, this->PrivateGetSharedInstance());
+      }
+
+      PluginPtr ptr;
+      if (this->pool && !_resource)
+      {
+        ptr = PluginPtr::PrivateMakeFromInstance(
+              this->table, this->pool->Acquire());
       }
       else
       {
-        return PluginPtr();
+        ptr = this->library ?
+            PluginPtr(this->table, this->library, _resource) :
+            PluginPtr(this->table, _resource);
       }
 
-      if (auto *enableFromThis = ptr->QueryInterface<EnablePluginFromThis>())
-        enableFromThis->PrivateSetPluginFromThis(ptr);
+      if (this->enablePluginFromThis)
+      {
+        ptr->QueryInterface<EnablePluginFromThis>()
+            ->PrivateSetPluginFromThis(ptr);
+      }
 
       return ptr;
     }
 
+    /////////////////////////////////////////////////
+    std::vector<PluginPtr> Loader::ResolvedPlugin::InstantiateMany(
+        const std::size_t _count) const
+    {
+      return this->InstantiateMany<PluginPtr>(_count);
+    }
+
+    /////////////////////////////////////////////////
+    std::shared_ptr<void> Loader::ResolvedPlugin::PrivateGetSharedInstance()
+        const
+    {
+      return this->table->GetSharedInstance([this]()
+      {
+        std::shared_ptr<void> instance =
+            Plugin::PrivateCreateDetachedInstance(this->table, this->library);
+
+        if (instance && this->enablePluginFromThis)
+        {
+          // The instance only refers weakly to itself, so the table can
+          // still destroy it.
+          const PluginPtr ptr =
+              PluginPtr::PrivateMakeFromInstance(this->table, instance);
+          ptr->QueryInterface<EnablePluginFromThis>()
+              ->PrivateSetPluginFromThis(ptr);
+        }
+
+        return instance;
+      });
+    }
+
+    /////////////////////////////////////////////////
+    std::string Loader::ResolvedPlugin::Name() const
+    {
+      if (!this->table)
+        return "";
+
+      return this->table->GetInfo()->name;
+    }
+
+    /////////////////////////////////////////////////
+    Loader::ResolvedPlugin::operator bool() const
+    {
+      return this->table != nullptr;
+    }
+
+    /////////////////////////////////////////////////
+    bool Loader::ResolvedPlugin::IsShared() const
+    {
+      return this->shared;
+    }
+
     /////////////////////////////////////////////////
     bool Loader::ForgetLibrary(const std::string &_pathToLibrary)
     {
+      Implementation::Garbage garbage;
+      std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+      // A library that was registered from a manifest might never have been
+      // loaded, so we look for it by its path first.
+      const auto lazyIt = this->dataPtr->lazyLibs.find(_pathToLibrary);
+      if (lazyIt != this->dataPtr->lazyLibs.end())
+      {
+        this->dataPtr->ForgetLazyLib(lazyIt->second, garbage);
+        return true;
+      }
+
+      // Do not hold up the other users of this Loader while we ask the
+      // operating system about the library.
+      lock.unlock();
+
 #ifndef RTLD_NOLOAD
 // This macro is not part of the POSIX standard, and is a custom addition to
 // glibc-2.2, so we need create a no-op stand-in flag for it if we are not
@@ -331,21 +1280,99 @@ namespace gz
       // overall behavior of dlopen).
       dlclose(dlHandle);
 
-      return this->dataPtr->ForgetLibrary(dlHandle);
+      lock.lock();
+      return this->dataPtr->ForgetLibrary(dlHandle, garbage);
     }
 
     /////////////////////////////////////////////////
     bool Loader::ForgetLibraryOfPlugin(const std::string &_pluginNameOrAlias)
     {
-      const std::string &resolvedName = this->LookupPlugin(_pluginNameOrAlias);
+      Implementation::Garbage garbage;
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+      // Only the functions that hold the lock can change the registry, so
+      // this snapshot stays current until we are done.
+      const Registry::ConstSnapshotPtr filePlugins =
+          this->dataPtr->filePlugins.GetSnapshot();
+
+      const std::string &resolvedName =
+          this->dataPtr->LookupPlugin(_pluginNameOrAlias);
 
-      Implementation::PluginToDlHandleMap::iterator it =
-          dataPtr->pluginToDlHandlePtrs.find(resolvedName);
+      const Registry::Snapshot::Entry *entry =
+          filePlugins->FindPlugin(resolvedName);
 
-      if (dataPtr->pluginToDlHandlePtrs.end() == it)
+      if (nullptr == entry)
         return false;
 
-      return dataPtr->ForgetLibrary(it->second.get());
+      if (Implementation::IsPlaceholder(*entry->info))
+      {
+        this->dataPtr->ForgetLazyLib(
+            std::static_pointer_cast<Implementation::LazyLib>(entry->library),
+            garbage);
+        return true;
+      }
+
+      return dataPtr->ForgetLibrary(entry->library.get(), garbage);
+    }
+
+    /////////////////////////////////////////////////
+    PluginPtr Loader::PrivateGetFactoryPlugin(
+        const std::string &_pluginNameOrAlias) const
+    {
+      std::shared_ptr<const Implementation::FactoryMap> current =
+          std::atomic_load(&this->dataPtr->factories);
+      if (current)
+      {
+        const auto it = current->find(_pluginNameOrAlias);
+        if (it != current->end())
+          return it->second.plugin;
+      }
+
+      // Dev note: The plugin gets resolved and instantiated while the lock is
+      // NOT held, because resolving it might load its library, and the
+      // constructor of the plugin might use this Loader. If several threads
+      // instantiate the same plugin at once, the instance of the first one to
+      // publish it gets cached, and the others drop their own instances.
+      while (true)
+      {
+        const ResolvedPlugin resolved = this->Resolve(_pluginNameOrAlias);
+        if (!resolved)
+          return PluginPtr();
+
+        // The plugin might already be cached under a different alias
+        const std::string &resolvedName = resolved.table->GetInfo()->name;
+        current = std::atomic_load(&this->dataPtr->factories);
+        const bool cached = current && current->count(resolvedName) > 0;
+
+        // The resolved plugin holds the handle of its library, so the library
+        // stays loaded even if it gets forgotten while we instantiate.
+        const PluginPtr plugin = cached ? PluginPtr() : resolved.Instantiate();
+
+        Implementation::Garbage garbage;
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+        // Another thread might have cached the plugin in the meantime
+        current = std::atomic_load(&this->dataPtr->factories);
+        if (current)
+        {
+          const auto it = current->find(_pluginNameOrAlias);
+          if (it != current->end())
+            return it->second.plugin;
+        }
+
+        // If the library of the plugin was forgotten, or another library took
+        // over its name or alias, then the instance must not be cached.
+        if (this->dataPtr->CurrentTable(_pluginNameOrAlias) != resolved.table)
+          continue;
+
+        // If we skipped the instantiation, then the instance that we found
+        // under the resolved name must still be cached.
+        if (!plugin && (!current || current->count(resolvedName) == 0))
+          continue;
+
+        return this->dataPtr->CacheFactory(
+              _pluginNameOrAlias, resolvedName, plugin, garbage);
+      }
     }
 
     /////////////////////////////////////////////////
@@ -408,29 +1435,50 @@ namespace gz
     std::shared_ptr<void> Loader::PrivateGetPluginDlHandlePtr(
         const std::string &_resolvedName) const
     {
-      Implementation::PluginToDlHandleMap::iterator it =
-          dataPtr->pluginToDlHandlePtrs.find(_resolvedName);
+      const Registry::ConstSnapshotPtr filePlugins =
+          this->dataPtr->filePlugins.GetSnapshot();
+      const Registry::Snapshot::Entry *entry =
+          filePlugins->FindPlugin(_resolvedName);
 
-      if (this->dataPtr->pluginToDlHandlePtrs.end() == it)
+      if (nullptr == entry)
       {
         // LCOV_EXCL_START
         std::cerr << "[gz::Loader::PrivateGetInfo] A resolved name ["
                   << _resolvedName << "] could not be found in the "
-                  << "PluginToDlHandleMap. This should not be possible! Please "
-                  << "report this bug!\n";
+                  << "registry of loaded plugins. This should not be possible! "
+                  << "Please report this bug!\n";
         assert(false);
         return nullptr;
         // LCOV_EXCL_STOP
       }
 
-      return it->second;
+      return entry->library;
     }
 
     /////////////////////////////////////////////////
-    std::shared_ptr<void> Loader::Implementation::LoadLib(
-        const std::string &_full_path, bool _noDelete)
+    void Loader::Implementation::Readahead(const std::string &_pathToLibrary)
     {
-      std::shared_ptr<void> dlHandlePtr;
+#if !defined(_WIN32) && defined(POSIX_FADV_WILLNEED)
+      const int fd = open(_pathToLibrary.c_str(), O_RDONLY | O_CLOEXEC);
+
+      // If the file cannot be opened here, then dlopen will report the
+      // problem later.
+      if (fd < 0)
+        return;
+
+      posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+      close(fd);
+#else
+      (void) _pathToLibrary;
+#endif
+    }
+
+    /////////////////////////////////////////////////
+    Loader::Implementation::OpenedLib Loader::Implementation::OpenLib(
+        const std::string &_full_path, bool _noDelete) const
+    {
+      OpenedLib lib;
+      lib.path = _full_path;
 
       // Call dlerror() before dlopen(~) to ensure that we get accurate error
       // reporting afterwards. The function dlerror() is stateful, and that
@@ -454,11 +1502,64 @@ namespace gz
         std::cerr << "Error while loading the library [" << _full_path << "]: "
                   << loadError << std::endl;
 
-        // Just return a nullptr if the library could not be loaded. The
+        // Just return an empty library if it could not be loaded. The
         // Loader::LoadLib(~) function will handle this gracefully.
-        return nullptr;
+        return lib;
+      }
+
+      lib.dlHandle = dlHandle;
+
+      try
+      {
+        // Found a shared library, does it have the symbols we're looking for?
+        lib.plugins = this->LoadPlugins(dlHandle, _full_path);
+
+        for (Info &plugin : lib.plugins)
+        {
+          // Demangle the plugin name before creating an entry for it.
+          plugin.name = DemangleSymbol(plugin.name);
+
+          // Make a list of the demangled interface names for later
+          // convenience.
+          for (auto const &interface : plugin.interfaces)
+          {
+            if (!detail::IsSharedInstanceMarker(interface.first))
+            {
+              plugin.demangledInterfaces.insert(
+                    DemangleSymbol(interface.first));
+            }
+          }
+        }
+      }
+      catch (...)
+      {
+        // Nothing owns the handle yet, so we must close it ourselves.
+        CloseLib(lib);
+        throw;
       }
 
+      return lib;
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::CloseLib(OpenedLib &_lib)
+    {
+      if (nullptr == _lib.dlHandle)
+        return;
+
+      // The Info must be cleared before the library goes away, because the
+      // destructors of its `factory` and `deleter` members live inside of it.
+      _lib.plugins.clear();
+      dlclose(_lib.dlHandle);
+      _lib.dlHandle = nullptr;
+    }
+
+    /////////////////////////////////////////////////
+    std::shared_ptr<void> Loader::Implementation::AcquireDlHandle(
+        void *_dlHandle)
+    {
+      std::shared_ptr<void> dlHandlePtr;
+
       // The dl library maintains a reference count of how many times dlopen(~)
       // or dlclose(~) has been called on each loaded library. dlopen(~)
       // increments the reference count while dlclose(~) decrements the count.
@@ -479,7 +1580,7 @@ namespace gz
       bool inserted;
       DlHandleMap::iterator it;
       std::tie(it, inserted) = this->dlHandlePtrMap.insert(
-            std::make_pair(dlHandle, std::weak_ptr<void>()));
+            std::make_pair(_dlHandle, std::weak_ptr<void>()));
 
       if (!inserted)
       {
@@ -498,13 +1599,12 @@ namespace gz
           // dlopen.
           //
           // At this line of code, we know that dlopen had been called by this
-          // Loader instance prior to this run of LoadLib. Therefore,
-          // we should undo the dlopen that we did just a moment ago in this
-          // function so that only one dlclose must be performed to finally
-          // close the shared library. That final dlclose will be performed in
-          // the destructor of the std::shared_ptr<void> which stores the
-          // library handle.
-          dlclose(dlHandle);
+          // Loader instance prior to the dlopen that produced _dlHandle.
+          // Therefore, we should undo that most recent dlopen so that only one
+          // dlclose must be performed to finally close the shared library. That
+          // final dlclose will be performed in the destructor of the
+          // std::shared_ptr<void> which stores the library handle.
+          dlclose(_dlHandle);
         }
       }
 
@@ -514,7 +1614,7 @@ namespace gz
         // it is no longer active), so we should create a reference counting
         // handle for it.
         dlHandlePtr = std::shared_ptr<void>(
-              dlHandle, [](void *ptr) { dlclose(ptr); }); // NOLINT
+              _dlHandle, [](void *ptr) { dlclose(ptr); }); // NOLINT
 
         it->second = dlHandlePtr;
       }
@@ -522,9 +1622,119 @@ namespace gz
       return dlHandlePtr;
     }
 
+    /////////////////////////////////////////////////
+    void Loader::Implementation::StoreManifest(const OpenedLib &_lib)
+    {
+      if (nullptr == _lib.dlHandle)
+        return;
+
+      std::shared_ptr<ManifestCache> cache;
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        cache = this->manifestCache;
+      }
+
+      // The ManifestCache does its own locking, and it reads the file, so
+      // this must not hold up the other users of this Loader.
+      if (cache)
+        cache->Store(_lib.path, _lib.plugins);
+    }
+
+    /////////////////////////////////////////////////
+    std::vector<std::unordered_set<std::string>>
+    Loader::Implementation::RegisterLibs(
+        std::vector<OpenedLib> &_libs, const std::size_t _count,
+        Garbage &_garbage)
+    {
+      std::vector<std::unordered_set<std::string>> newPlugins(_count);
+
+      // The reference-counting handle of each library, or a nullptr for the
+      // libraries that we did not actually get a valid dlHandle for
+      std::vector<std::shared_ptr<void>> dlHandles(_count);
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        if (nullptr == _libs[i].dlHandle)
+          continue;
+
+        dlHandles[i] = this->AcquireDlHandle(_libs[i].dlHandle);
+        _libs[i].dlHandle = nullptr;
+
+        // If other libraries already provide all of its plugins, then this
+        // handle is the last one, and it must not unload the library while
+        // the lock is held.
+        _garbage.push_back(dlHandles[i]);
+      }
+
+      // The plugins whose Info in the registry came from each library
+      std::vector<std::unordered_set<std::string>> providedPlugins(_count);
+
+      // The names and aliases which resolve differently once the plugins of
+      // the libraries have been added
+      std::unordered_set<std::string> claims;
+
+      // All the plugins of the libraries are published in one update, so
+      // readers see either none or all of them.
+      _garbage.push_back(this->filePlugins.Update(
+          [&](Registry::Snapshot &_plugins)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (!dlHandles[i])
+            continue;
+
+          for (const Info &plugin : _libs[i].plugins)
+          {
+            // If the plugin was registered from a manifest, replace the
+            // placeholder with the real Info.
+            const Registry::Snapshot::Entry *existing =
+                _plugins.FindPlugin(plugin.name);
+            if (existing && IsPlaceholder(*existing->info))
+              this->ForgetPlaceholder(_plugins, plugin.name, _garbage);
+
+            CollectClaims(_plugins, plugin, claims);
+
+            // Add the plugin to the registry together with the dl handle
+            // that keeps its library loaded.
+            //
+            // Dev note: If a different library already provided a plugin
+            // with this name, then the registry keeps that library's Info
+            // and handle. Replacing the handle would unload the library while
+            // its Info is still in the registry.
+            _plugins.AddInfo(std::make_shared<Info>(plugin), dlHandles[i]);
+
+            // Add the plugin's name to the set of newPlugins
+            newPlugins[i].insert(plugin.name);
+
+            if (_plugins.FindPlugin(plugin.name)->library == dlHandles[i])
+              providedPlugins[i].insert(plugin.name);
+          }
+        }
+      }));
+
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        // Dev note: The Info of the opened library must be cleared while
+        // we still hold a reference to the library handle, because the
+        // destructors of its `factory` and `deleter` members live inside of
+        // the library.
+        _libs[i].plugins.clear();
+
+        if (dlHandles[i])
+        {
+          this->dlHandleToPluginMap[dlHandles[i].get()] =
+              std::move(providedPlugins[i]);
+        }
+      }
+
+      // The new plugins might shadow a cached plugin or one of its aliases
+      this->ForgetFactoriesRequestedAs(claims, _garbage);
+
+      return newPlugins;
+    }
+
     /////////////////////////////////////////////////
     std::vector<Info> Loader::Implementation::LoadPlugins(
-        const std::shared_ptr<void> &_dlHandle,
+        void *_dlHandle,
         const std::string& _pathToLibrary) const
     {
       std::vector<Info> loadedPlugins;
@@ -535,7 +1745,7 @@ namespace gz
              "a nullptr value for _dlHandle.");
 
       const std::string infoSymbol = "GzPluginHook";
-      void *infoFuncPtr = dlsym(_dlHandle.get(), infoSymbol.c_str());
+      void *infoFuncPtr = dlsym(_dlHandle, infoSymbol.c_str());
 
       // Does the library have the right symbol?
       if (nullptr == infoFuncPtr)
@@ -556,23 +1766,26 @@ namespace gz
       auto InfoHook =
           reinterpret_cast<PluginLoadFunctionSignature>(infoFuncPtr);
 
+      // Ask for the descriptor table first. A library that was built against
+      // version 1 of the Info API answers with that version instead, and then
+      // we ask again for its InfoMap.
       int version = INFO_API_VERSION;
-      std::size_t size = sizeof(Info);
-      std::size_t alignment = alignof(Info);
-      const InfoMap *allInfo = nullptr;
+      std::size_t size = sizeof(detail::PluginDescriptor);
+      std::size_t alignment = alignof(detail::PluginDescriptor);
+      const detail::PluginDescriptorTable *table = nullptr;
 
       // Note: static_cast cannot be used to convert from a T** to a void**
       // because of the possibility of breaking the type system by assigning a
       // Non-T pointer to the T* memory location. However, we need to retrieve
-      // a reference to an STL-type using a C-compatible function signature, so
-      // we resort to a reinterpret_cast to achieve this.
+      // a reference to the plugin information using a C-compatible function
+      // signature, so we resort to a reinterpret_cast to achieve this.
       //
       // Despite its many dangers, reinterpret_cast is well-defined for casting
       // between pointer types as of C++11, as explained in bullet point 1 of
       // the "Explanation" section in this reference:
       // http://en.cppreference.com/w/cpp/language/reinterpret_cast
       //
-      // We have a tight grip over the implementation of how the `allInfo`
+      // We have a tight grip over the implementation of how the output
       // pointer gets used, so we do not need to worry about its memory address
       // being filled with a non-compatible type. The only risk would be if a
       // user decides to implement their own version of
@@ -584,16 +1797,47 @@ namespace gz
       // against the static runtime. Using this pointer-to-a-pointer approach is
       // the cleanest way to ensure that all dynamically allocated objects are
       // deleted in the same heap that they were allocated from.
-      InfoHook(nullptr, reinterpret_cast<const void**>(&allInfo),
+      InfoHook(nullptr, reinterpret_cast<const void**>(&table),
            &version, &size, &alignment);
 
-      if (gz::plugin::INFO_API_VERSION != version)
+      if (INFO_API_VERSION == version)
       {
-        // TODO(anyone): When we need to support multiple API versions,
-        // put the logic for it into here.
-        // We can call GzPluginHook(~) again with the
-        // API version that it expects.
+        if (sizeof(detail::PluginDescriptor) != size ||
+            alignof(detail::PluginDescriptor) != alignment)
+        {
+          std::cerr << "The plugin descriptor size or alignment are not "
+                 << "consistent with the expected values for the library ["
+                 << _pathToLibrary << "]:\n -- size: expected "
+                 << sizeof(detail::PluginDescriptor) << " | received " << size
+                 << "\n -- alignment: expected "
+                 << alignof(detail::PluginDescriptor) << " | received "
+                 << alignment << "\n"
+                 << " -- We will not be able to safely load plugins from that "
+                 << "library.\n";
+
+          return loadedPlugins;
+        }
+
+        if (!table)
+        {
+          std::cerr << "The library [" << _pathToLibrary << "] failed to "
+                    << "provide gz::plugin descriptors for unknown reasons. "
+                    << "Please report this error as a bug!\n";
 
+          return loadedPlugins;
+        }
+
+        // The descriptors are read in place, and each Info is built directly
+        // from them.
+        loadedPlugins.reserve(table->count);
+        for (std::size_t i = 0; i < table->count; ++i)
+          loadedPlugins.push_back(InfoFromDescriptor(table->plugins[i]));
+
+        return loadedPlugins;
+      }
+
+      if (INFO_MAP_API_VERSION != version)
+      {
         std::cerr << "The library [" << _pathToLibrary << "] is using an "
                   << "incompatible version [" << version << "] of the "
                   << "gz::plugin Info API. The version in this library "
@@ -601,6 +1845,13 @@ namespace gz
         return loadedPlugins;
       }
 
+      size = sizeof(Info);
+      alignment = alignof(Info);
+      const InfoMap *allInfo = nullptr;
+
+      InfoHook(nullptr, reinterpret_cast<const void**>(&allInfo),
+           &version, &size, &alignment);
+
       if (sizeof(Info) != size || alignof(Info) != alignment)
       {
         std::cerr << "The plugin::Info size or alignment are not consistent "
@@ -625,6 +1876,29 @@ namespace gz
 
       for (const InfoMap::value_type &info : *allInfo)
       {
+        // Dev note: The virtual functions of Factory have changed since
+        // version 1 of the Info API, so the factories of such a library would
+        // be called through the wrong entries of their vtables.
+        const bool implementsFactory = std::any_of(
+              info.second.interfaces.begin(), info.second.interfaces.end(),
+              [](const Info::InterfaceCastingMap::value_type &_interface)
+        {
+          return DemangleSymbol(_interface.first).rfind(
+                "gz::plugin::Factory<", 0) == 0;
+        });
+
+        if (implementsFactory)
+        {
+          std::cerr << "The plugin [" << DemangleSymbol(info.second.name)
+                    << "] of the library [" << _pathToLibrary << "] is a "
+                    << "gz::plugin::Factory, but the library is using "
+                    << "version [" << INFO_MAP_API_VERSION << "] of the "
+                    << "gz::plugin Info API, whose factories are not "
+                    << "compatible with this version of gz::plugin. Rebuild "
+                    << "the library to load this plugin.\n";
+          continue;
+        }
+
         loadedPlugins.push_back(info.second);
       }
 
@@ -632,27 +1906,361 @@ namespace gz
     }
 
     /////////////////////////////////////////////////
-    bool Loader::Implementation::ForgetLibrary(void *_dlHandle)
+    Info Loader::Implementation::InfoFromDescriptor(
+        const detail::PluginDescriptor &_plugin)
+    {
+      Info info;
+      info.name.assign(_plugin.name.data, _plugin.name.size);
+
+      for (std::size_t i = 0; i < _plugin.aliasCount; ++i)
+      {
+        const detail::DescriptorString &alias = _plugin.aliases[i];
+        info.aliases.emplace(alias.data, alias.size);
+      }
+
+      info.interfaces.reserve(_plugin.interfaceCount);
+      for (std::size_t i = 0; i < _plugin.interfaceCount; ++i)
+      {
+        const detail::InterfaceDescriptor &interface = _plugin.interfaces[i];
+        std::function<void*(void*)> cast;
+        if (interface.cast)
+          cast = interface.cast;
+        else
+          cast = InterfaceOffset{interface.offset};
+
+        info.interfaces.emplace(
+            std::string(interface.name.data, interface.name.size),
+            std::move(cast));
+      }
+
+      if (_plugin.describe)
+        info.factory = InstanceFactory{_plugin.describe};
+      else
+        info.factory = _plugin.create;
+
+      info.deleter = _plugin.deleter;
+
+      return info;
+    }
+
+    /////////////////////////////////////////////////
+    bool Loader::Implementation::ResolveLazyPlugin(
+        LazyLib &_lazyLib,
+        const std::string &_pluginName,
+        detail::ConstInterfaceTablePtr &_table,
+        std::shared_ptr<void> &_dlHandle) const
+    {
+      // Only the first instantiation of a plugin from the library needs the
+      // lock. Later ones find the results of that one without waiting.
+      if (!_lazyLib.loaded)
+      {
+        std::lock_guard<std::mutex> lock(_lazyLib.mutex);
+
+        // Another instantiation may have loaded the library while we were
+        // waiting for the lock.
+        if (!_lazyLib.loaded)
+        {
+          OpenedLib lib = this->OpenLib(_lazyLib.path, _lazyLib.noDelete);
+          if (lib.dlHandle)
+          {
+            // Dev note: This handle is not shared through dlHandlePtrMap,
+            // because other threads may be reading that map right now. Each
+            // reference-counting handle matches exactly one dlopen, so having
+            // a separate one for this library is still correct.
+            _lazyLib.dlHandle = std::shared_ptr<void>(
+                  lib.dlHandle, [](void *ptr) { dlclose(ptr); }); // NOLINT
+
+            for (Info &plugin : lib.plugins)
+            {
+              const std::string name = plugin.name;
+              _lazyLib.resolved[name] =
+                  std::make_shared<const detail::InterfaceTable>(
+                    std::make_shared<Info>(std::move(plugin)));
+            }
+            lib.plugins.clear();
+          }
+
+          _lazyLib.loaded = true;
+        }
+      }
+
+      const auto resolvedIt = _lazyLib.resolved.find(_pluginName);
+      if (resolvedIt == _lazyLib.resolved.end())
+      {
+        std::cerr << "[gz::plugin::Loader::Instantiate] According to its "
+                  << "manifest, the library [" << _lazyLib.path << "] provides "
+                  << "the plugin [" << _pluginName << "], but "
+                  << (_lazyLib.dlHandle ? "it does not."
+                                        : "the library could not be loaded.")
+                  << "\n";
+        return false;
+      }
+
+      _table = resolvedIt->second;
+      _dlHandle = _lazyLib.dlHandle;
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    detail::ConstInterfaceTablePtr Loader::Implementation::CurrentTable(
+        const std::string &_pluginNameOrAlias) const
+    {
+      const Registry::ConstSnapshotPtr files = this->filePlugins.GetSnapshot();
+      const std::string resolvedName = files->LookupPlugin(_pluginNameOrAlias);
+      if (resolvedName.empty())
+      {
+        const Registry::ConstSnapshotPtr statics =
+            this->staticPlugins->GetSnapshot();
+        const Registry::Snapshot::Entry *entry =
+            statics->FindPlugin(statics->LookupPlugin(_pluginNameOrAlias));
+        return entry ? entry->table : nullptr;
+      }
+
+      const Registry::Snapshot::Entry *entry = files->FindPlugin(resolvedName);
+      if (!IsPlaceholder(*entry->info))
+        return entry->table;
+
+      // Dev note: `resolved` is filled in before `loaded` gets set, and it
+      // never changes afterwards.
+      const LazyLib &lazyLib = *std::static_pointer_cast<LazyLib>(
+            entry->library);
+      if (!lazyLib.loaded)
+        return nullptr;
+
+      const auto it = lazyLib.resolved.find(resolvedName);
+      return it == lazyLib.resolved.end() ? nullptr : it->second;
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::ForgetPlaceholder(
+        Registry::Snapshot &_plugins,
+        const std::string &_pluginName,
+        Garbage &_garbage)
+    {
+      const Registry::Snapshot::Entry *entry = _plugins.FindPlugin(_pluginName);
+      if (nullptr == entry)
+        return;
+
+      const LazyLibPtr lazyLib =
+          std::static_pointer_cast<LazyLib>(entry->library);
+      _plugins.ForgetInfo(_pluginName);
+
+      lazyLib->plugins.erase(_pluginName);
+      if (lazyLib->plugins.empty())
+        this->lazyLibs.erase(lazyLib->path);
+
+      _garbage.push_back(lazyLib);
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::ForgetLazyLib(
+        const LazyLibPtr &_lazyLib, Garbage &_garbage)
+    {
+      // Hold on to the library while we erase it from the maps, and until
+      // the lock has been released.
+      const LazyLibPtr lazyLib = _lazyLib;
+      _garbage.push_back(lazyLib);
+
+      _garbage.push_back(this->filePlugins.Update(
+          [&](Registry::Snapshot &_plugins)
+      {
+        for (const std::string &plugin : lazyLib->plugins)
+          _plugins.ForgetInfo(plugin);
+      }));
+
+      this->ForgetPools(lazyLib->plugins, _garbage);
+      this->ForgetFactories(lazyLib->plugins, _garbage);
+
+      this->lazyLibs.erase(lazyLib->path);
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::ForgetPools(
+        const std::unordered_set<std::string> &_plugins, Garbage &_garbage)
+    {
+      if (!this->hasPools.load(std::memory_order_acquire))
+        return;
+
+      const std::shared_ptr<const PoolMap> current =
+          std::atomic_load(&this->pools);
+
+      auto next = std::make_shared<PoolMap>(*current);
+      for (const std::string &plugin : _plugins)
+        next->erase(plugin);
+
+      if (next->size() == current->size())
+        return;
+
+      this->hasPools.store(!next->empty(), std::memory_order_release);
+      std::atomic_store(&this->pools,
+          std::shared_ptr<const PoolMap>(std::move(next)));
+      _garbage.push_back(current);
+    }
+
+    /////////////////////////////////////////////////
+    std::shared_ptr<Loader::InstancePool> Loader::Implementation::FindPool(
+        const std::string &_resolvedName) const
+    {
+      const std::shared_ptr<const PoolMap> current =
+          std::atomic_load(&this->pools);
+      if (!current)
+        return nullptr;
+
+      const auto it = current->find(_resolvedName);
+      if (it == current->end())
+        return nullptr;
+
+      return it->second;
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::ForgetFactories(
+        const std::unordered_set<std::string> &_plugins, Garbage &_garbage)
+    {
+      const std::shared_ptr<const FactoryMap> current =
+          std::atomic_load(&this->factories);
+      if (!current || current->empty())
+        return;
+
+      auto next = std::make_shared<FactoryMap>();
+      for (const auto &entry : *current)
+      {
+        if (_plugins.count(entry.second.resolvedName) == 0)
+          next->insert(entry);
+      }
+
+      if (next->size() == current->size())
+        return;
+
+      std::atomic_store(&this->factories,
+          std::shared_ptr<const FactoryMap>(std::move(next)));
+      _garbage.push_back(current);
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::ForgetFactoriesRequestedAs(
+        const std::unordered_set<std::string> &_namesOrAliases,
+        Garbage &_garbage)
+    {
+      const std::shared_ptr<const FactoryMap> current =
+          std::atomic_load(&this->factories);
+      if (!current || current->empty() || _namesOrAliases.empty())
+        return;
+
+      auto next = std::make_shared<FactoryMap>();
+      for (const auto &entry : *current)
+      {
+        if (_namesOrAliases.count(entry.first) == 0)
+          next->insert(entry);
+      }
+
+      if (next->size() == current->size())
+        return;
+
+      std::atomic_store(&this->factories,
+          std::shared_ptr<const FactoryMap>(std::move(next)));
+      _garbage.push_back(current);
+    }
+
+    /////////////////////////////////////////////////
+    PluginPtr Loader::Implementation::CacheFactory(
+        const std::string &_nameOrAlias,
+        const std::string &_resolvedName,
+        const PluginPtr &_plugin,
+        Garbage &_garbage)
+    {
+      const std::shared_ptr<const FactoryMap> current =
+          std::atomic_load(&this->factories);
+
+      auto next = current ?
+          std::make_shared<FactoryMap>(*current) :
+          std::make_shared<FactoryMap>();
+
+      // The plugin might already be cached under a different alias
+      CachedFactory &cached = (*next)[_resolvedName];
+      if (!cached.plugin)
+      {
+        cached.resolvedName = _resolvedName;
+        cached.plugin = _plugin;
+      }
+
+      const CachedFactory entry = cached;
+      next->insert(std::make_pair(_nameOrAlias, entry));
+
+      std::atomic_store(&this->factories,
+          std::shared_ptr<const FactoryMap>(std::move(next)));
+      _garbage.push_back(current);
+
+      return entry.plugin;
+    }
+
+    /////////////////////////////////////////////////
+    bool Loader::Implementation::IsPlaceholder(const Info &_info)
+    {
+      // Every plugin library provides a factory, so an Info without one can
+      // only have come from a manifest.
+      return !_info.factory;
+    }
+
+    /////////////////////////////////////////////////
+    void Loader::Implementation::CollectClaims(
+        const Registry::Snapshot &_plugins,
+        const Info &_info,
+        std::unordered_set<std::string> &_claims)
+    {
+      // A plugin whose name is already known keeps its current Info, but its
+      // aliases get added anyway.
+      if (nullptr == _plugins.FindPlugin(_info.name))
+        _claims.insert(_info.name);
+
+      for (const std::string &alias : _info.aliases)
+      {
+        if (_plugins.PluginsWithAlias(alias).count(_info.name) == 0)
+          _claims.insert(alias);
+      }
+    }
+
+    /////////////////////////////////////////////////
+    bool Loader::Implementation::ForgetLibrary(
+        void *_dlHandle, Garbage &_garbage)
     {
       DlHandleToPluginMap::iterator it = dlHandleToPluginMap.find(_dlHandle);
       if (dlHandleToPluginMap.end() == it)
+      {
+        // The library might have been loaded lazily through a different path
+        // than the one that was used to forget it.
+        for (const auto &lazyLib : this->lazyLibs)
+        {
+          // Dev note: The handle of a lazy library is filled in by
+          // Instantiate(~) without the exclusive lock, so it may only be
+          // read once the library is marked as loaded.
+          if (lazyLib.second->loaded
+              && lazyLib.second->dlHandle.get() == _dlHandle)
+          {
+            this->ForgetLazyLib(lazyLib.second, _garbage);
+            return true;
+          }
+        }
+
         return false;
+      }
 
       const std::unordered_set<std::string> &forgottenPlugins = it->second;
 
-      for (const std::string &forget : forgottenPlugins)
+      // Dev note: Each entry of the registry releases its Info before the
+      // handle of its library, so the library stays loaded for the
+      // destructors of the `deleter` member variables. Snapshots that are
+      // still being used by other threads keep the library loaded until they
+      // are released.
+      _garbage.push_back(this->filePlugins.Update(
+          [&](Registry::Snapshot &_plugins)
       {
-        // CRUCIAL DEV NOTE (MXG): Be sure to erase the Info from
-        // `plugins` BEFORE erasing the plugin entry in `pluginToDlHandlePtrs`,
-        // because the Info structs require the library to remain loaded
-        // for the destructors of their `deleter` member variables.
-
-        // This erase should come FIRST.
-        this->filePlugins.ForgetInfo(forget);
+        for (const std::string &forget : forgottenPlugins)
+          _plugins.ForgetInfo(forget);
+      }));
 
-        // This erase should come LAST.
-        this->pluginToDlHandlePtrs.erase(forget);
-      }
+      this->ForgetPools(forgottenPlugins, _garbage);
+      this->ForgetFactories(forgottenPlugins, _garbage);
 
       // Dev note (MXG): We do not need to delete anything from `dlHandlePtrMap`
       // because it uses std::weak_ptrs. It will clear itself automatically.
@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gz/plugin/ManifestCache.hh>
+
+#include "ElfReader.hh"
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace
+    {
+      /// \brief The first line of every cache file. Increment the version if
+      /// the format of the file changes, so that old files get ignored.
+      const char kManifestHeader[] = "gz-plugin-manifest\t1";
+
+      /// \brief Counts the temporary files that this process has written, so
+      /// that no two of them get the same name.
+      std::atomic<std::uint64_t> tmpFileCounter(0);
+
+      /////////////////////////////////////////////////
+      /// \brief Make a name for a temporary file next to _file which no
+      /// other process or ManifestCache is using.
+      std::filesystem::path TmpFileFor(const std::filesystem::path &_file)
+      {
+#ifdef _WIN32
+        const auto pid = _getpid();
+#else
+        const auto pid = getpid();
+#endif
+        return _file.string() + ".tmp" + std::to_string(pid) + "."
+            + std::to_string(tmpFileCounter++);
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Escape the characters which have a meaning in the cache file
+      std::string Escape(const std::string &_text)
+      {
+        std::string escaped;
+        escaped.reserve(_text.size());
+        for (const char c : _text)
+        {
+          switch (c)
+          {
+            case '\\': escaped += "\\\\"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            default: escaped += c;
+          }
+        }
+        return escaped;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Undo Escape(~)
+      /// \return False if _text is not a valid escaped string
+      bool Unescape(const std::string &_text, std::string &_result)
+      {
+        _result.clear();
+        _result.reserve(_text.size());
+        for (std::size_t i = 0; i < _text.size(); ++i)
+        {
+          if ('\\' != _text[i])
+          {
+            _result += _text[i];
+            continue;
+          }
+
+          if (++i == _text.size())
+            return false;
+
+          switch (_text[i])
+          {
+            case '\\': _result += '\\'; break;
+            case 't': _result += '\t'; break;
+            case 'n': _result += '\n'; break;
+            case 'r': _result += '\r'; break;
+            default: return false;
+          }
+        }
+        return true;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Split a line of the cache file into its unescaped fields
+      /// \return False if any field is not a valid escaped string
+      bool SplitFields(const std::string &_line,
+                       std::vector<std::string> &_fields)
+      {
+        _fields.clear();
+        std::size_t start = 0;
+        while (true)
+        {
+          const std::size_t end = _line.find('\t', start);
+          _fields.emplace_back();
+          if (!Unescape(_line.substr(start, end - start), _fields.back()))
+            return false;
+
+          if (std::string::npos == end)
+            return true;
+
+          start = end + 1;
+        }
+      }
+    }
+
+    /////////////////////////////////////////////////
+    class ManifestCache::Implementation
+    {
+      /// \brief The properties of a library file which must be unchanged for
+      /// a cache entry to be used.
+      public: struct FileKey
+      {
+        /// \brief Size of the file in bytes
+        std::uintmax_t size = 0;
+
+        /// \brief Last modification time of the file
+        std::int64_t mtime = 0;
+
+        /// \brief Build-id of the library, or empty if it has none
+        std::string buildId;
+
+        /// \brief Compare two keys
+        bool operator==(const FileKey &_other) const
+        {
+          return size == _other.size && mtime == _other.mtime
+              && buildId == _other.buildId;
+        }
+      };
+
+      /// \brief A cached library
+      public: struct Entry
+      {
+        /// \brief The properties of the library file when it was stored
+        FileKey key;
+
+        /// \brief Metadata of the plugins of the library
+        std::vector<Info> plugins;
+      };
+
+      /// \brief Inspect the library file at a path
+      /// \param[in] _path Path to a library
+      /// \param[out] _key The current properties of the file
+      /// \return False if the file does not exist
+      public: static bool ReadKey(const std::string &_path, FileKey &_key);
+
+      /// \brief Read the entries of the cache file
+      public: void Load();
+
+      /// \brief Write the entries to a stream. The mutex must be locked.
+      /// \param[in] _stream Stream to write to
+      public: void Write(std::ostream &_stream) const;
+
+      /// \brief Path of the cache file
+      public: std::string cacheFile;
+
+      /// \brief Protects entries and dirty
+      public: mutable std::mutex mutex;
+
+      /// \brief Cached libraries, keyed by their path
+      public: std::map<std::string, Entry> entries;
+
+      /// \brief True if entries has changed since the last save
+      public: mutable bool dirty = false;
+    };
+
+    /////////////////////////////////////////////////
+    bool ManifestCache::Implementation::ReadKey(
+        const std::string &_path, FileKey &_key)
+    {
+      std::error_code ec;
+      _key.size = std::filesystem::file_size(_path, ec);
+      if (ec)
+        return false;
+
+      const auto mtime = std::filesystem::last_write_time(_path, ec);
+      if (ec)
+        return false;
+
+      _key.mtime = static_cast<std::int64_t>(
+            mtime.time_since_epoch().count());
+      _key.buildId = ElfFile(_path).BuildId();
+
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    void ManifestCache::Implementation::Load()
+    {
+      std::ifstream file(this->cacheFile);
+      if (!file)
+        return;
+
+      std::string line;
+      if (!std::getline(file, line) || line != kManifestHeader)
+      {
+        std::cerr << "[gz::plugin::ManifestCache] The file ["
+                  << this->cacheFile << "] is not a plugin manifest cache of "
+                  << "a compatible version. It will be ignored.\n";
+        return;
+      }
+
+      std::map<std::string, Entry> loaded;
+      Entry *entry = nullptr;
+      Info *plugin = nullptr;
+      std::vector<std::string> fields;
+      std::size_t lineNumber = 1;
+
+      while (std::getline(file, line))
+      {
+        ++lineNumber;
+
+        bool valid = SplitFields(line, fields);
+        const std::string &tag = fields.front();
+
+        if (!valid)
+        {
+          // Report the problem below
+        }
+        else if ("library" == tag && 5u == fields.size())
+        {
+          Entry &newEntry = loaded[fields[1]];
+          newEntry = Entry();
+          try
+          {
+            newEntry.key.size = std::stoull(fields[2]);
+            newEntry.key.mtime = std::stoll(fields[3]);
+          }
+          catch (const std::exception &)
+          {
+            valid = false;
+          }
+          newEntry.key.buildId = fields[4];
+          entry = &newEntry;
+          plugin = nullptr;
+        }
+        else if ("plugin" == tag && 2u == fields.size() && entry)
+        {
+          entry->plugins.emplace_back();
+          plugin = &entry->plugins.back();
+          plugin->name = fields[1];
+        }
+        else if ("alias" == tag && 2u == fields.size() && plugin)
+        {
+          plugin->aliases.insert(fields[1]);
+        }
+        else if ("interface" == tag && 2u == fields.size() && plugin)
+        {
+          plugin->interfaces.insert(std::make_pair(fields[1], nullptr));
+        }
+        else if ("demangled" == tag && 2u == fields.size() && plugin)
+        {
+          plugin->demangledInterfaces.insert(fields[1]);
+        }
+        else if ("end" == tag && 1u == fields.size() && entry)
+        {
+          entry = nullptr;
+          plugin = nullptr;
+        }
+        else
+        {
+          valid = false;
+        }
+
+        if (!valid)
+        {
+          std::cerr << "[gz::plugin::ManifestCache] Line [" << lineNumber
+                    << "] of the file [" << this->cacheFile << "] is "
+                    << "malformed. The file will be ignored.\n";
+          return;
+        }
+      }
+
+      if (entry)
+      {
+        std::cerr << "[gz::plugin::ManifestCache] The file ["
+                  << this->cacheFile << "] is truncated. It will be "
+                  << "ignored.\n";
+        return;
+      }
+
+      this->entries = std::move(loaded);
+    }
+
+    /////////////////////////////////////////////////
+    void ManifestCache::Implementation::Write(std::ostream &_stream) const
+    {
+      _stream << kManifestHeader << "\n";
+      for (const auto &[path, entry] : this->entries)
+      {
+        _stream << "library\t" << Escape(path) << "\t" << entry.key.size
+                << "\t" << entry.key.mtime << "\t" << Escape(entry.key.buildId)
+                << "\n";
+
+        for (const Info &plugin : entry.plugins)
+        {
+          _stream << "plugin\t" << Escape(plugin.name) << "\n";
+
+          for (const std::string &alias : plugin.aliases)
+            _stream << "alias\t" << Escape(alias) << "\n";
+
+          for (const auto &interface : plugin.interfaces)
+            _stream << "interface\t" << Escape(interface.first) << "\n";
+
+          for (const std::string &interface : plugin.demangledInterfaces)
+            _stream << "demangled\t" << Escape(interface) << "\n";
+        }
+
+        _stream << "end\n";
+      }
+    }
+
+    /////////////////////////////////////////////////
+    ManifestCache::ManifestCache(const std::string &_cacheFile)
+      : dataPtr(new Implementation)
+    {
+      this->dataPtr->cacheFile = _cacheFile;
+      this->dataPtr->Load();
+    }
+
+    /////////////////////////////////////////////////
+    ManifestCache::~ManifestCache()
+    {
+      bool dirty;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        dirty = this->dataPtr->dirty;
+      }
+
+      if (dirty)
+        this->Save();
+    }
+
+    /////////////////////////////////////////////////
+    const std::string &ManifestCache::CacheFile() const
+    {
+      return this->dataPtr->cacheFile;
+    }
+
+    /////////////////////////////////////////////////
+    bool ManifestCache::Lookup(const std::string &_pathToLibrary,
+                               std::vector<Info> &_plugins) const
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        if (this->dataPtr->entries.count(_pathToLibrary) == 0)
+          return false;
+      }
+
+      // Dev note: We inspect the file without holding the lock, because
+      // it involves file system calls and mapping the file.
+      Implementation::FileKey key;
+      if (!Implementation::ReadKey(_pathToLibrary, key))
+        return false;
+
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      const auto it = this->dataPtr->entries.find(_pathToLibrary);
+      if (it == this->dataPtr->entries.end() || !(it->second.key == key))
+        return false;
+
+      _plugins = it->second.plugins;
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    bool ManifestCache::Store(const std::string &_pathToLibrary,
+                              const std::vector<Info> &_plugins)
+    {
+      Implementation::Entry entry;
+      if (!Implementation::ReadKey(_pathToLibrary, entry.key))
+        return false;
+
+      entry.plugins.reserve(_plugins.size());
+      for (const Info &plugin : _plugins)
+      {
+        entry.plugins.emplace_back();
+        Info &metadata = entry.plugins.back();
+        metadata.name = plugin.name;
+        metadata.aliases = plugin.aliases;
+        metadata.demangledInterfaces = plugin.demangledInterfaces;
+        for (const auto &interface : plugin.interfaces)
+          metadata.interfaces.insert(std::make_pair(interface.first, nullptr));
+      }
+
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->entries[_pathToLibrary] = std::move(entry);
+      this->dataPtr->dirty = true;
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    void ManifestCache::Remove(const std::string &_pathToLibrary)
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      if (this->dataPtr->entries.erase(_pathToLibrary) > 0)
+        this->dataPtr->dirty = true;
+    }
+
+    /////////////////////////////////////////////////
+    bool ManifestCache::Save() const
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+      const std::filesystem::path file(this->dataPtr->cacheFile);
+      std::error_code ec;
+      if (file.has_parent_path())
+        std::filesystem::create_directories(file.parent_path(), ec);
+
+      // Write to a temporary file first and then move it into place, so that
+      // other processes never read a partially written cache.
+      const std::filesystem::path tmpFile = TmpFileFor(file);
+
+      {
+        std::ofstream stream(tmpFile, std::ios::trunc);
+        this->dataPtr->Write(stream);
+        stream.flush();
+        if (!stream)
+        {
+          std::cerr << "[gz::plugin::ManifestCache::Save] Failed to write the "
+                    << "file [" << tmpFile.string() << "].\n";
+          std::filesystem::remove(tmpFile, ec);
+          return false;
+        }
+      }
+
+      std::filesystem::rename(tmpFile, file, ec);
+      if (ec)
+      {
+        std::cerr << "[gz::plugin::ManifestCache::Save] Failed to move the "
+                  << "file [" << tmpFile.string() << "] to ["
+                  << file.string() << "]: " << ec.message() << "\n";
+        std::filesystem::remove(tmpFile, ec);
+        return false;
+      }
+
+      this->dataPtr->dirty = false;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/plugin/ManifestCache.hh>
+
+namespace fs = std::filesystem;
+
+/////////////////////////////////////////////////
+class ManifestCacheTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    this->directory = fs::temp_directory_path() /
+        ("gz_plugin_manifest_" + std::string(
+          ::testing::UnitTest::GetInstance()->current_test_info()->name()));
+    fs::remove_all(this->directory);
+    fs::create_directories(this->directory);
+
+    // Work with a private copy of the library, so that its modification time
+    // can be changed and so that no other test has it loaded.
+    this->library = (this->directory / "libGzDummyPluginsCopy.so").string();
+    fs::copy_file(GzDummyPlugins_LIB, this->library);
+
+    this->cacheFile = (this->directory / "manifest.txt").string();
+  }
+
+  protected: void TearDown() override
+  {
+    fs::remove_all(this->directory);
+  }
+
+  protected: fs::path directory;
+  protected: std::string library;
+  protected: std::string cacheFile;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ManifestCacheTest, StoreAndLookup)
+{
+  gz::plugin::ManifestCache cache(this->cacheFile);
+  EXPECT_EQ(this->cacheFile, cache.CacheFile());
+
+  std::vector<gz::plugin::Info> plugins;
+  EXPECT_FALSE(cache.Lookup(this->library, plugins));
+
+  gz::plugin::Info info;
+  info.name = "some::Plugin\twith a tab";
+  info.aliases.insert("an alias");
+  info.aliases.insert("back\\slash\nnewline");
+  info.interfaces.insert(std::make_pair("N4some9InterfaceE",
+                         [](void *_ptr) { return _ptr; }));
+  info.demangledInterfaces.insert("some::Interface");
+  info.factory = []() -> void* { return nullptr; };
+
+  EXPECT_TRUE(cache.Store(this->library, {info}));
+  EXPECT_FALSE(cache.Store(
+        (this->directory / "does_not_exist.so").string(), {info}));
+
+  ASSERT_TRUE(cache.Lookup(this->library, plugins));
+  ASSERT_EQ(1u, plugins.size());
+  EXPECT_EQ(info.name, plugins[0].name);
+  EXPECT_EQ(info.aliases, plugins[0].aliases);
+  EXPECT_EQ(info.demangledInterfaces, plugins[0].demangledInterfaces);
+  ASSERT_EQ(1u, plugins[0].interfaces.count("N4some9InterfaceE"));
+
+  // Only the metadata is stored
+  EXPECT_FALSE(plugins[0].interfaces.at("N4some9InterfaceE"));
+  EXPECT_FALSE(plugins[0].factory);
+
+  ASSERT_TRUE(cache.Save());
+
+  // A new cache reads the entries back from the file
+  gz::plugin::ManifestCache reloaded(this->cacheFile);
+  plugins.clear();
+  ASSERT_TRUE(reloaded.Lookup(this->library, plugins));
+  ASSERT_EQ(1u, plugins.size());
+  EXPECT_EQ(info.name, plugins[0].name);
+  EXPECT_EQ(info.aliases, plugins[0].aliases);
+  EXPECT_EQ(info.demangledInterfaces, plugins[0].demangledInterfaces);
+  EXPECT_EQ(1u, plugins[0].interfaces.count("N4some9InterfaceE"));
+
+  // Changing the library invalidates its entry
+  fs::last_write_time(this->library,
+      fs::last_write_time(this->library) + std::chrono::seconds(10));
+  EXPECT_FALSE(reloaded.Lookup(this->library, plugins));
+
+  reloaded.Remove(this->library);
+  EXPECT_FALSE(reloaded.Lookup(this->library, plugins));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ManifestCacheTest, IgnoreMalformedFile)
+{
+  {
+    std::ofstream file(this->cacheFile);
+    file << "gz-plugin-manifest\t1\n"
+         << "library\t" << this->library << "\tnot-a-number\t0\t\n"
+         << "end\n";
+  }
+
+  gz::plugin::ManifestCache cache(this->cacheFile);
+  std::vector<gz::plugin::Info> plugins;
+  EXPECT_FALSE(cache.Lookup(this->library, plugins));
+
+  {
+    std::ofstream file(this->cacheFile);
+    file << "some other format\n";
+  }
+
+  gz::plugin::ManifestCache otherFormat(this->cacheFile);
+  EXPECT_FALSE(otherFormat.Lookup(this->library, plugins));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ManifestCacheTest, DiscoverWithoutLoading)
+{
+  std::set<std::string> allPlugins;
+  std::unordered_set<std::string> interfaces;
+  {
+    auto cache = std::make_shared<gz::plugin::ManifestCache>(this->cacheFile);
+    gz::plugin::Loader loader;
+    loader.SetManifestCache(cache);
+
+    // Without an entry in the cache, the library gets inspected and stored
+    EXPECT_EQ(3u, loader.DiscoverLib(this->library).size());
+    allPlugins = loader.AllPlugins();
+    interfaces = loader.InterfacesImplemented();
+
+    // The destructor of the cache saves it
+  }
+  ASSERT_TRUE(fs::exists(this->cacheFile));
+
+  gz::plugin::Loader loader;
+  loader.SetManifestCache(
+        std::make_shared<gz::plugin::ManifestCache>(this->cacheFile));
+
+  const std::unordered_set<std::string> discovered =
+      loader.DiscoverLib(this->library);
+  EXPECT_EQ(3u, discovered.size());
+  EXPECT_EQ(1u, discovered.count("test::util::DummyMultiPlugin"));
+
+  EXPECT_EQ(allPlugins, loader.AllPlugins());
+  EXPECT_EQ(interfaces, loader.InterfacesImplemented());
+  EXPECT_EQ(3u, loader.PluginsImplementing("test::util::DummyNameBase").size());
+  EXPECT_EQ("test::util::DummyMultiPlugin", loader.LookupPlugin("Foo"));
+  EXPECT_EQ(2u, loader.PluginsWithAlias("Bar").size());
+
+  // The library gets loaded by the first instantiation
+  EXPECT_TRUE(loader.Instantiate("test::util::DummyMultiPlugin"));
+  EXPECT_EQ(allPlugins, loader.AllPlugins());
+
+  // Loading the library explicitly replaces what was discovered
+  EXPECT_EQ(3u, loader.LoadLib(this->library).size());
+  EXPECT_EQ(allPlugins, loader.AllPlugins());
+  EXPECT_TRUE(loader.Instantiate("test::util::DummyMultiPlugin"));
+  EXPECT_TRUE(loader.ForgetLibrary(this->library));
+  EXPECT_TRUE(loader.AllPlugins().empty());
+
+  // A library that was discovered can be forgotten before it gets loaded
+  EXPECT_EQ(3u, loader.DiscoverLib(this->library).size());
+  EXPECT_EQ(allPlugins, loader.AllPlugins());
+  EXPECT_TRUE(loader.ForgetLibrary(this->library));
+  EXPECT_TRUE(loader.AllPlugins().empty());
+}
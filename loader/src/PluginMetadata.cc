@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cctype>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ElfReader.hh"
+#include "PluginMetadata.hh"
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace
+    {
+      // Dev note: These must match the records which are written by
+      // gz/plugin/detail/Metadata.hh in the register component.
+      const char kMetadataSection[] = "gz_plugin_metadata";
+      const char kMetadataHeader[] = "gz-plugin-metadata";
+      const char kMetadataVersion[] = "1";
+
+      /////////////////////////////////////////////////
+      /// \brief Split a line of a record at its tabs, keeping at most
+      /// _maxFields fields. The last field keeps any remaining tabs.
+      std::vector<std::string> SplitFields(const std::string &_line,
+                                           const std::size_t _maxFields)
+      {
+        std::vector<std::string> fields;
+        std::size_t start = 0;
+        while (fields.size() + 1 < _maxFields)
+        {
+          const std::size_t tab = _line.find('\t', start);
+          if (std::string::npos == tab)
+            break;
+
+          fields.push_back(_line.substr(start, tab - start));
+          start = tab + 1;
+        }
+
+        fields.push_back(_line.substr(start));
+        return fields;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Check whether a string is a C++ identifier.
+      bool IsIdentifier(const std::string &_text)
+      {
+        if (_text.empty()
+            || std::isdigit(static_cast<unsigned char>(_text.front())))
+        {
+          return false;
+        }
+
+        for (const char c : _text)
+        {
+          if (!std::isalnum(static_cast<unsigned char>(c)) && '_' != c)
+            return false;
+        }
+
+        return true;
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Parse the alias arguments of GZ_ADD_PLUGIN_ALIAS as they were
+      /// written, e.g. `"Foo", "Bar"`.
+      /// \param[in] _text The stringified alias arguments
+      /// \param[out] _aliases The values of the aliases
+      /// \return False if any of the arguments is not a plain string literal
+      bool ParseAliases(const std::string &_text,
+                        std::set<std::string> &_aliases)
+      {
+        std::size_t i = 0;
+        const auto skipSpaces = [&]()
+        {
+          while (i < _text.size() && ' ' == _text[i])
+            ++i;
+        };
+
+        while (true)
+        {
+          std::string alias;
+
+          // Adjacent string literals get concatenated
+          skipSpaces();
+          if (i >= _text.size() || '"' != _text[i])
+            return false;
+
+          while (i < _text.size() && '"' == _text[i])
+          {
+            ++i;
+            while (i < _text.size() && '"' != _text[i])
+            {
+              char c = _text[i++];
+              if ('\\' == c)
+              {
+                if (i >= _text.size())
+                  return false;
+
+                switch (_text[i++])
+                {
+                  case '"': c = '"'; break;
+                  case '\'': c = '\''; break;
+                  case '?': c = '?'; break;
+                  case '\\': c = '\\'; break;
+                  case 'n': c = '\n'; break;
+                  case 't': c = '\t'; break;
+                  case 'r': c = '\r'; break;
+                  // Octal, hexadecimal and universal character escapes are
+                  // not worth supporting here.
+                  default: return false;
+                }
+              }
+
+              alias.push_back(c);
+            }
+
+            if (i >= _text.size())
+              return false;
+
+            ++i;
+            skipSpaces();
+          }
+
+          _aliases.insert(alias);
+
+          if (i >= _text.size())
+            return true;
+
+          if (',' != _text[i])
+            return false;
+
+          ++i;
+        }
+      }
+    }
+
+    /////////////////////////////////////////////////
+    bool MangleClassName(const std::string &_name, std::string &_mangled)
+    {
+      std::vector<std::string> parts;
+      std::size_t start = 0;
+      while (true)
+      {
+        const std::size_t separator = _name.find("::", start);
+        parts.push_back(_name.substr(start, separator - start));
+        if (std::string::npos == separator)
+          break;
+
+        start = separator + 2;
+      }
+
+      for (const std::string &part : parts)
+      {
+        if (!IsIdentifier(part))
+          return false;
+      }
+
+      // Names in the std namespace get abbreviated, and may live in an inline
+      // namespace that does not show up in their demangled name, so we leave
+      // those to the Loader.
+      if ("std" == parts.front())
+        return false;
+
+      _mangled.clear();
+      if (parts.size() > 1)
+        _mangled += "N";
+
+      for (const std::string &part : parts)
+        _mangled += std::to_string(part.size()) + part;
+
+      if (parts.size() > 1)
+        _mangled += "E";
+
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    bool ReadPluginMetadata(const std::string &_pathToLibrary,
+                            std::vector<Info> &_plugins)
+    {
+      _plugins.clear();
+
+      const ElfFile file(_pathToLibrary);
+      std::string contents;
+      if (!file.Valid() || !file.SectionContents(kMetadataSection, contents))
+        return false;
+
+      // We use a std::map so that the plugins come out in a consistent order
+      std::map<std::string, Info> plugins;
+      const auto getPlugin = [&](const std::string &_name) -> Info*
+      {
+        std::string mangled;
+        if (!MangleClassName(_name, mangled))
+          return nullptr;
+
+        Info &info = plugins[_name];
+        info.name = _name;
+        return &info;
+      };
+
+      bool versionKnown = false;
+      Info *plugin = nullptr;
+
+      std::size_t start = 0;
+      while (start < contents.size())
+      {
+        std::size_t end = contents.find('\n', start);
+        if (std::string::npos == end)
+          end = contents.size();
+
+        std::string line = contents.substr(start, end - start);
+        start = end + 1;
+
+        // The linker may have padded the section between records
+        line.erase(0, line.find_first_not_of('\0'));
+        if (line.empty())
+          continue;
+
+        if (0 == line.compare(0, sizeof(kMetadataHeader) - 1, kMetadataHeader))
+        {
+          const std::vector<std::string> fields = SplitFields(line, 2);
+          if (2u != fields.size() || kMetadataHeader != fields[0]
+              || kMetadataVersion != fields[1])
+          {
+            // This record was written by a version of gz-plugin that we do
+            // not understand.
+            return false;
+          }
+
+          versionKnown = true;
+          plugin = nullptr;
+          continue;
+        }
+
+        if (!versionKnown)
+          return false;
+
+        const std::vector<std::string> fields = SplitFields(line, 3);
+        const std::string &tag = fields[0];
+
+        if ("plugin" == tag && 2u == fields.size())
+        {
+          plugin = getPlugin(fields[1]);
+          if (!plugin)
+            return false;
+        }
+        else if ("interface" == tag && 2u == fields.size() && plugin)
+        {
+          std::string mangled;
+          if (!MangleClassName(fields[1], mangled))
+            return false;
+
+          plugin->interfaces.insert(std::make_pair(mangled, nullptr));
+          plugin->demangledInterfaces.insert(fields[1]);
+        }
+        else if ("alias" == tag && 3u == fields.size())
+        {
+          Info *aliased = getPlugin(fields[1]);
+          if (!aliased || !ParseAliases(fields[2], aliased->aliases))
+            return false;
+
+          plugin = nullptr;
+        }
+        else
+        {
+          return false;
+        }
+      }
+
+      if (plugins.empty())
+        return false;
+
+      _plugins.reserve(plugins.size());
+      for (auto &entry : plugins)
+        _plugins.push_back(std::move(entry.second));
+
+      return true;
+    }
+  }
+}
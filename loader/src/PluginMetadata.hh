@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_PLUGIN_SRC_PLUGINMETADATA_HH_
+#define GZ_PLUGIN_SRC_PLUGINMETADATA_HH_
+
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Info.hh>
+
+namespace gz
+{
+  namespace plugin
+  {
+    /// \brief Read the plugin metadata that the plugin registration macros
+    /// embed into a shared library, without loading the library.
+    ///
+    /// The metadata only describes the plugins, so the factory, deleter and
+    /// interface casting functions of the resulting Info objects are empty,
+    /// just like the Info that ManifestCache::Lookup(~) produces.
+    ///
+    /// \param[in] _pathToLibrary Path to the library
+    /// \param[out] _plugins The Info of the plugins of the library, with
+    /// demangled plugin names and mangled interface names, as the Loader
+    /// would have them after loading the library.
+    /// \return True if the library has metadata and all of it could be
+    /// understood. If this is false, the library needs to be loaded to find
+    /// out which plugins it provides.
+    bool ReadPluginMetadata(const std::string &_pathToLibrary,
+                            std::vector<Info> &_plugins);
+
+    /// \brief Mangle the demangled name of a class the same way that
+    /// typeid(~).name() would spell it. Only names made of plain identifiers
+    /// separated by "::" are supported.
+    /// \param[in] _name Demangled name of a class, e.g. "ns::Class"
+    /// \param[out] _mangled The mangled name, e.g. "N2ns5ClassE"
+    /// \return False if the name is not supported
+    bool MangleClassName(const std::string &_name, std::string &_mangled);
+  }
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <unordered_set>
+
+#include <gz/plugin/Loader.hh>
+
+namespace fs = std::filesystem;
+
+/////////////////////////////////////////////////
+/// \brief Expect that two loaders know the same plugins with the same aliases
+/// and interfaces.
+void ExpectSamePlugins(const gz::plugin::Loader &_expected,
+                       const gz::plugin::Loader &_actual)
+{
+  EXPECT_EQ(_expected.AllPlugins(), _actual.AllPlugins());
+  EXPECT_EQ(_expected.InterfacesImplemented(),
+            _actual.InterfacesImplemented());
+
+  for (const std::string &plugin : _expected.AllPlugins())
+  {
+    EXPECT_EQ(_expected.AliasesOfPlugin(plugin),
+              _actual.AliasesOfPlugin(plugin));
+  }
+
+  for (const std::string &interface : _expected.InterfacesImplemented())
+  {
+    EXPECT_EQ(_expected.PluginsImplementing(interface),
+              _actual.PluginsImplementing(interface));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PluginMetadata, DiscoverMatchesLoad)
+{
+  gz::plugin::Loader loaded;
+  const std::unordered_set<std::string> loadedPlugins =
+      loaded.LoadLib(GzDummyPlugins_LIB);
+  ASSERT_EQ(3u, loadedPlugins.size());
+
+  // Without a manifest cache, discovery relies on the metadata that the
+  // registration macros embedded into the library.
+  gz::plugin::Loader discovered;
+  EXPECT_EQ(loadedPlugins, discovered.DiscoverLib(GzDummyPlugins_LIB));
+  ExpectSamePlugins(loaded, discovered);
+
+  EXPECT_EQ(2u, discovered.PluginsWithAlias("Baz").size());
+  EXPECT_EQ("test::util::DummyMultiPlugin", discovered.LookupPlugin("Foo"));
+  EXPECT_EQ("test::util::DummySinglePlugin",
+            discovered.LookupPlugin("Alternative name"));
+
+  // The plugins are still real plugins
+  EXPECT_TRUE(discovered.Instantiate("test::util::DummyMultiPlugin"));
+  ExpectSamePlugins(loaded, discovered);
+}
+
+/////////////////////////////////////////////////
+TEST(PluginMetadata, DiscoverWithoutLoading)
+{
+  const fs::path directory =
+      fs::temp_directory_path() / "gz_plugin_metadata_DiscoverWithoutLoading";
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+
+  const std::string library = (directory / "libGzDummyPluginsCopy.so").string();
+  fs::copy_file(GzDummyPlugins_LIB, library);
+
+  gz::plugin::Loader loader;
+  EXPECT_EQ(3u, loader.DiscoverLib(library).size());
+
+  // If the library was discovered without being loaded, then it can no longer
+  // be loaded once the file is gone.
+  fs::remove_all(directory);
+  EXPECT_EQ(3u, loader.AllPlugins().size());
+  EXPECT_FALSE(loader.Instantiate("test::util::DummyMultiPlugin"));
+}
+
+/////////////////////////////////////////////////
+TEST(PluginMetadata, LibraryWithoutMetadata)
+{
+  // The core library does not provide any plugins, so it has no metadata and
+  // needs to be loaded to find that out.
+  gz::plugin::Loader loader;
+  EXPECT_TRUE(loader.DiscoverLib(GZ_PLUGIN_LIB).empty());
+  EXPECT_TRUE(loader.AllPlugins().empty());
+
+  EXPECT_TRUE(loader.DiscoverLib("/not/a/real/library.so").empty());
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_set>
+
+#include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/Registry.hh>
+
+using gz::plugin::Info;
+using gz::plugin::Registry;
+
+/////////////////////////////////////////////////
+/// \brief Make an Info with the given name, alias and interface.
+Info MakeInfo(const std::string &_name,
+              const std::string &_alias,
+              const std::string &_interface)
+{
+  Info info;
+  info.name = _name;
+  info.aliases.insert(_alias);
+  info.interfaces.insert({_interface, [](void *_ptr) { return _ptr; }});
+  info.demangledInterfaces.insert(_interface);
+  return info;
+}
+
+/////////////////////////////////////////////////
+TEST(Registry, SnapshotIsNotAffectedByLaterChanges)
+{
+  Registry registry;
+  EXPECT_TRUE(registry.AddInfo(MakeInfo("A", "first", "Interface")));
+
+  const Registry::ConstSnapshotPtr before = registry.GetSnapshot();
+
+  EXPECT_TRUE(registry.AddInfo(MakeInfo("B", "second", "Interface")));
+  EXPECT_FALSE(registry.AddInfo(MakeInfo("A", "other", "Interface")));
+  registry.ForgetInfo("A");
+
+  EXPECT_EQ(std::set<std::string>({"A"}), before->AllPlugins());
+  EXPECT_EQ("A", before->LookupPlugin("first"));
+  EXPECT_EQ("", before->LookupPlugin("second"));
+  EXPECT_EQ(1u, before->PluginsImplementing("Interface").size());
+  ASSERT_NE(nullptr, before->GetInfo("A"));
+
+  EXPECT_EQ(std::set<std::string>({"B"}), registry.AllPlugins());
+  EXPECT_EQ("", registry.LookupPlugin("first"));
+  EXPECT_EQ("B", registry.LookupPlugin("second"));
+  EXPECT_EQ(nullptr, registry.GetInfo("A"));
+}
+
+/////////////////////////////////////////////////
+TEST(Registry, UpdateIsPublishedAllAtOnce)
+{
+  Registry registry;
+  const Registry::ConstSnapshotPtr empty = registry.GetSnapshot();
+
+  Registry::ConstSnapshotPtr during;
+  registry.Update([&](Registry::Snapshot &_plugins)
+  {
+    EXPECT_TRUE(_plugins.AddInfo(
+        std::make_shared<Info>(MakeInfo("A", "alias", "Interface"))));
+    EXPECT_TRUE(_plugins.AddInfo(
+        std::make_shared<Info>(MakeInfo("B", "alias", "Interface"))));
+
+    // Nothing is published until the update is finished
+    during = registry.GetSnapshot();
+  });
+
+  EXPECT_EQ(empty, during);
+  EXPECT_TRUE(empty->AllPlugins().empty());
+
+  const Registry::ConstSnapshotPtr after = registry.GetSnapshot();
+  EXPECT_NE(empty, after);
+  EXPECT_EQ(std::set<std::string>({"A", "B"}), after->AllPlugins());
+  EXPECT_EQ(std::set<std::string>({"A", "B"}),
+            after->PluginsWithAlias("alias"));
+}
+
+/////////////////////////////////////////////////
+TEST(Registry, SnapshotKeepsLibraryAlive)
+{
+  Registry registry;
+
+  std::shared_ptr<void> library = std::make_shared<int>(0);
+  const std::weak_ptr<void> weakLibrary = library;
+
+  EXPECT_TRUE(registry.AddInfo(MakeInfo("A", "alias", "Interface"), library));
+  library.reset();
+
+  Registry::ConstSnapshotPtr snapshot = registry.GetSnapshot();
+  const Registry::Snapshot::Entry *entry = snapshot->FindPlugin("A");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(weakLibrary.lock(), entry->library);
+  EXPECT_EQ(nullptr, snapshot->FindPlugin("alias"));
+
+  registry.ForgetInfo("A");
+  EXPECT_FALSE(weakLibrary.expired());
+
+  snapshot.reset();
+  EXPECT_TRUE(weakLibrary.expired());
+}
+
+/////////////////////////////////////////////////
+TEST(Registry, InterfaceIndex)
+{
+  Registry registry;
+
+  Info a = MakeInfo("A", "alias", "mangledFirst");
+  a.demangledInterfaces = {"First"};
+  a.interfaces.insert({"mangledSecond", [](void *_ptr) { return _ptr; }});
+  a.demangledInterfaces.insert("Second");
+  EXPECT_TRUE(registry.AddInfo(a));
+
+  Info b = MakeInfo("B", "alias", "mangledSecond");
+  b.demangledInterfaces = {"Second"};
+  EXPECT_TRUE(registry.AddInfo(b));
+
+  using Names = std::unordered_set<std::string>;
+  EXPECT_EQ(Names({"A"}), registry.PluginsImplementing("First"));
+  EXPECT_EQ(Names({"A", "B"}), registry.PluginsImplementing("Second"));
+  EXPECT_EQ(Names({"A"}), registry.PluginsImplementing("mangledFirst", false));
+  EXPECT_EQ(Names({"A", "B"}),
+            registry.PluginsImplementing("mangledSecond", false));
+
+  // A mangled name is not found as a demangled one, and vice versa
+  EXPECT_TRUE(registry.PluginsImplementing("mangledFirst").empty());
+  EXPECT_TRUE(registry.PluginsImplementing("First", false).empty());
+
+  // A plugin that was not added does not show up in the index
+  Info c = MakeInfo("B", "alias", "mangledThird");
+  c.demangledInterfaces = {"Third"};
+  EXPECT_FALSE(registry.AddInfo(c));
+  EXPECT_TRUE(registry.PluginsImplementing("Third").empty());
+
+  registry.ForgetInfo("A");
+  EXPECT_TRUE(registry.PluginsImplementing("First").empty());
+  EXPECT_TRUE(registry.PluginsImplementing("mangledFirst", false).empty());
+  EXPECT_EQ(Names({"B"}), registry.PluginsImplementing("Second"));
+  EXPECT_EQ(Names({"Second"}), registry.InterfacesImplemented());
+
+  registry.ForgetInfo("B");
+  EXPECT_TRUE(registry.PluginsImplementing("Second").empty());
+  EXPECT_TRUE(registry.InterfacesImplemented().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Registry, ManyPlugins)
+{
+  Registry registry;
+  const int numPlugins = 1000;
+
+  for (int i = 0; i < numPlugins; ++i)
+  {
+    const std::string name = "plugin" + std::to_string(i);
+    EXPECT_TRUE(registry.AddInfo(MakeInfo(name, "alias" + name, "Common")));
+  }
+
+  // A snapshot keeps every plugin, even while they get forgotten
+  const Registry::ConstSnapshotPtr full = registry.GetSnapshot();
+
+  for (int i = 0; i < numPlugins; i += 2)
+    registry.ForgetInfo("plugin" + std::to_string(i));
+
+  EXPECT_EQ(static_cast<std::size_t>(numPlugins), full->AllPlugins().size());
+  EXPECT_EQ(static_cast<std::size_t>(numPlugins),
+            full->PluginsImplementing("Common").size());
+
+  EXPECT_EQ(static_cast<std::size_t>(numPlugins / 2),
+            registry.AllPlugins().size());
+  EXPECT_EQ(static_cast<std::size_t>(numPlugins / 2),
+            registry.PluginsImplementing("Common").size());
+
+  for (int i = 0; i < numPlugins; ++i)
+  {
+    const std::string name = "plugin" + std::to_string(i);
+    EXPECT_EQ(name, full->LookupPlugin("alias" + name));
+    EXPECT_EQ(i % 2 ? name : std::string(),
+              registry.LookupPlugin("alias" + name));
+  }
+
+  for (int i = 1; i < numPlugins; i += 2)
+    registry.ForgetInfo("plugin" + std::to_string(i));
+
+  EXPECT_TRUE(registry.AllPlugins().empty());
+  EXPECT_TRUE(registry.InterfacesImplemented().empty());
+  EXPECT_EQ(static_cast<std::size_t>(numPlugins), full->AllPlugins().size());
+}
@@ -16,8 +16,12 @@
  */
 
 
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
+#include <utility>
 
 #include <gz/plugin/detail/Registry.hh>
 
@@ -25,8 +29,51 @@ namespace gz
 {
   namespace plugin
   {
+    namespace
+    {
+      using NameIndex = detail::PersistentMap<detail::PersistentSet>;
+
+      /////////////////////////////////////////////////
+      /// \brief Add a plugin name to the names of a key of an index
+      /// \param[in] _index The index
+      /// \param[in] _key The key
+      /// \param[in] _name The plugin name
+      void AddName(NameIndex &_index, const std::string &_key,
+                   const std::string &_name)
+      {
+        const detail::PersistentSet *names = _index.Find(_key);
+        detail::PersistentSet newNames =
+            names ? *names : detail::PersistentSet();
+        if (newNames.Insert(_name))
+          _index.Set(_key, std::move(newNames));
+      }
+
+      /////////////////////////////////////////////////
+      /// \brief Remove a plugin name from the names of a key of an index,
+      /// dropping the key once it has no names left
+      /// \param[in] _index The index
+      /// \param[in] _key The key
+      /// \param[in] _name The plugin name
+      void RemoveName(NameIndex &_index, const std::string &_key,
+                      const std::string &_name)
+      {
+        const detail::PersistentSet *names = _index.Find(_key);
+        if (!names)
+          return;
+
+        detail::PersistentSet newNames = *names;
+        if (!newNames.Erase(_name))
+          return;
+
+        if (newNames.Empty())
+          _index.Erase(_key);
+        else
+          _index.Set(_key, std::move(newNames));
+      }
+    }
+
     /////////////////////////////////////////////////
-    std::string Registry::PrettyStr() const
+    std::string Registry::Snapshot::PrettyStr() const
     {
       auto interfaces = this->InterfacesImplemented();
       std::stringstream pretty;
@@ -56,21 +103,24 @@ namespace gz
           pretty << "\t\t\thas no aliases\n";
         }
 
-        const std::size_t iSize = plugin->interfaces.size();
+        const std::size_t iSize = plugin->demangledInterfaces.size();
         pretty << "\t\t\timplements " << iSize
                << (iSize == 1? " interface" : " interfaces") << ":\n";
         for (const auto &interface : plugin->demangledInterfaces)
           pretty << "\t\t\t\t" << interface << "\n";
       }
 
-      AliasMap badAliases;
-      for (const auto &entry : this->aliases)
+      std::map<std::string, std::set<std::string>> badAliases;
+      this->aliases.ForEach(
+            [&](const std::string &_alias, const detail::PersistentSet &_names)
       {
-        if (entry.second.size() > 1)
+        if (_names.Size() > 1)
         {
-          badAliases.insert(entry);
+          std::set<std::string> &names = badAliases[_alias];
+          _names.ForEach(
+                [&](const std::string &_name) { names.insert(_name); });
         }
-      }
+      });
 
       if (!badAliases.empty())
       {
@@ -92,57 +142,50 @@ namespace gz
     }
 
     /////////////////////////////////////////////////
-    std::unordered_set<std::string> Registry::InterfacesImplemented() const
+    std::unordered_set<std::string>
+    Registry::Snapshot::InterfacesImplemented() const
     {
-      std::set<std::string> pluginNames = this->AllPlugins();
+      // Dev note: The demangled interface index only has entries for the
+      // interfaces that at least one plugin implements, so its keys are
+      // exactly the result.
       std::unordered_set<std::string> interfaces;
-      for (auto const &name : pluginNames)
+      interfaces.reserve(this->pluginsByDemangledInterface.Size());
+      this->pluginsByDemangledInterface.ForEach(
+            [&](const std::string &_interface, const detail::PersistentSet &)
       {
-        const ConstInfoPtr &plugin = this->GetInfo(name);
-        for (auto const &interface : plugin->demangledInterfaces)
-          interfaces.insert(interface);
-      }
+        interfaces.insert(_interface);
+      });
       return interfaces;
     }
 
     /////////////////////////////////////////////////
-    std::unordered_set<std::string> Registry::PluginsImplementing(
+    std::unordered_set<std::string> Registry::Snapshot::PluginsImplementing(
         const std::string &_interface,
         const bool demangled) const
     {
-      std::set<std::string> allPlugins = this->AllPlugins();
-      std::unordered_set<std::string> availablePlugins;
+      const InterfaceMap &index = demangled ?
+          this->pluginsByDemangledInterface : this->pluginsByInterface;
 
-      for (auto const &name : allPlugins)
-      {
-        const ConstInfoPtr &plugin = this->GetInfo(name);
-        if (demangled)
-        {
-          if (plugin->demangledInterfaces.find(_interface) !=
-              plugin->demangledInterfaces.end())
-            availablePlugins.insert(plugin->name);
-        }
-        else
-        {
-          if (plugin->interfaces.find(_interface) !=
-              plugin->interfaces.end())
-            availablePlugins.insert(plugin->name);
-        }
-      }
+      const detail::PersistentSet *names = index.Find(_interface);
+      if (!names)
+        return {};
 
-      return availablePlugins;
+      std::unordered_set<std::string> result;
+      result.reserve(names->Size());
+      names->ForEach([&](const std::string &_name) { result.insert(_name); });
+      return result;
     }
 
     /////////////////////////////////////////////////
-    std::set<std::string> Registry::PluginsWithAlias(
+    std::set<std::string> Registry::Snapshot::PluginsWithAlias(
         const std::string &_alias) const
     {
       std::set<std::string> result;
 
-      const AliasMap::const_iterator names = this->aliases.find(_alias);
+      const detail::PersistentSet *names = this->aliases.Find(_alias);
 
-      if (names != this->aliases.end())
-        result = names->second;
+      if (names)
+        names->ForEach([&](const std::string &_name) { result.insert(_name); });
 
       ConstInfoPtr plugin = this->GetInfo(_alias);
 
@@ -153,7 +196,7 @@ namespace gz
     }
 
     /////////////////////////////////////////////////
-    std::set<std::string> Registry::AliasesOfPlugin(
+    std::set<std::string> Registry::Snapshot::AliasesOfPlugin(
         const std::string &_pluginName) const
     {
       ConstInfoPtr plugin = this->GetInfo(_pluginName);
@@ -165,18 +208,26 @@ namespace gz
     }
 
     /////////////////////////////////////////////////
-    std::string Registry::LookupPlugin(const std::string &_nameOrAlias) const
+    std::string Registry::Snapshot::LookupPlugin(
+        const std::string &_nameOrAlias) const
     {
-      ConstInfoPtr pluginPtr = this->GetInfo(_nameOrAlias);
-
-      if (pluginPtr != nullptr)
+      if (nullptr != this->FindPlugin(_nameOrAlias))
         return _nameOrAlias;
 
-      const AliasMap::const_iterator alias = this->aliases.find(_nameOrAlias);
-      if (this->aliases.end() != alias && !alias->second.empty())
+      const detail::PersistentSet *names = this->aliases.Find(_nameOrAlias);
+      if (names && !names->Empty())
       {
-        if (alias->second.size() == 1)
-          return *alias->second.begin();
+        if (names->Size() == 1)
+        {
+          std::string name;
+          names->ForEach([&](const std::string &_name) { name = _name; });
+          return name;
+        }
+
+        // Print the plugins in a stable order
+        std::set<std::string> plugins;
+        names->ForEach(
+              [&](const std::string &_name) { plugins.insert(_name); });
 
         // We use a stringstream because we're going to output to std::cerr, and
         // we want it all to print at once, but std::cerr does not support
@@ -186,7 +237,7 @@ namespace gz
         ss << "[gz::plugin::Registry::LookupPlugin] Failed to resolve the "
            << "alias [" << _nameOrAlias << "] because it refers to multiple "
            << "plugins:\n";
-        for (const std::string &plugin : alias->second)
+        for (const std::string &plugin : plugins)
           ss << " -- [" << plugin << "]\n";
 
         std::cerr << ss.str();
@@ -198,45 +249,207 @@ namespace gz
     }
 
     /////////////////////////////////////////////////
-    std::set<std::string> Registry::AllPlugins() const
+    std::set<std::string> Registry::Snapshot::AllPlugins() const
     {
       std::set<std::string> result;
 
-      for (const auto &entry : this->plugins)
-        result.insert(result.end(), entry.first);
+      this->plugins.ForEach([&](const std::string &_name, const Entry &)
+      {
+        result.insert(_name);
+      });
 
       return result;
     }
 
     /////////////////////////////////////////////////
-    ConstInfoPtr Registry::GetInfo(const std::string &_pluginName) const {
-      const PluginMap::const_iterator it = this->plugins.find(_pluginName);
-      if (this->plugins.end() == it)
+    ConstInfoPtr Registry::Snapshot::GetInfo(
+        const std::string &_pluginName) const
+    {
+      const Entry *entry = this->FindPlugin(_pluginName);
+      if (nullptr == entry)
         return nullptr;
-      return it->second;
+      return entry->info;
     }
 
     /////////////////////////////////////////////////
-    bool Registry::AddInfo(const Info &_info) {
-      for (const std::string &alias : _info.aliases)
-        this->aliases[alias].insert(_info.name);
+    auto Registry::Snapshot::FindPlugin(
+        const std::string &_pluginName) const -> const Entry*
+    {
+      return this->plugins.Find(_pluginName);
+    }
+
+    /////////////////////////////////////////////////
+    bool Registry::Snapshot::AddInfo(
+        ConstInfoPtr _info, std::shared_ptr<void> _library)
+    {
+      for (const std::string &alias : _info->aliases)
+        AddName(this->aliases, alias, _info->name);
+
+      const std::string name = _info->name;
+      if (nullptr != this->plugins.Find(name))
+        return false;
+
+      // Every instance of the plugin will share this table. Making it also
+      // registers the IDs of the interfaces, which Plugin::QueryInterface
+      // relies on.
+      detail::ConstInterfaceTablePtr table =
+          std::make_shared<const detail::InterfaceTable>(_info);
+
+      const Info &info = *_info;
+      for (const auto &interface : info.interfaces)
+      {
+        if (!detail::IsSharedInstanceMarker(interface.first))
+          AddName(this->pluginsByInterface, interface.first, name);
+      }
+      for (const std::string &interface : info.demangledInterfaces)
+        AddName(this->pluginsByDemangledInterface, interface, name);
 
-      auto result = this->plugins.insert(
-          std::make_pair(_info.name, std::make_shared<Info>(_info)));
+      this->plugins.Insert(name, Entry{
+            std::move(_library), std::move(_info), std::move(table)});
 
-      return result.second;
+      return true;
     }
 
     /////////////////////////////////////////////////
-    void Registry::ForgetInfo(const std::string &_pluginName) {
-      ConstInfoPtr info = this->GetInfo(_pluginName);
-      if (info == nullptr)
+    void Registry::Snapshot::ForgetInfo(const std::string &_pluginName)
+    {
+      const Entry *entry = this->plugins.Find(_pluginName);
+      if (nullptr == entry)
         return;
 
-      for (const std::string &alias : info->aliases)
-          this->aliases.at(alias).erase(info->name);
-      this->plugins.erase(_pluginName);
-      return;
+      // Keep the Info alive until the plugin has been removed from every
+      // index, because removing it from `plugins` may destroy the entry.
+      const ConstInfoPtr infoPtr = entry->info;
+      const Info &info = *infoPtr;
+      for (const std::string &alias : info.aliases)
+        RemoveName(this->aliases, alias, info.name);
+
+      // Remove the plugin from the interface indexes, dropping the interfaces
+      // that no other plugin implements.
+      for (const auto &interface : info.interfaces)
+      {
+        if (!detail::IsSharedInstanceMarker(interface.first))
+          RemoveName(this->pluginsByInterface, interface.first, info.name);
+      }
+      for (const std::string &interface : info.demangledInterfaces)
+        RemoveName(this->pluginsByDemangledInterface, interface, info.name);
+
+      this->plugins.Erase(_pluginName);
+    }
+
+    /////////////////////////////////////////////////
+    Registry::Registry()
+      : current(std::make_shared<const Snapshot>())
+    {
+      // Do nothing
+    }
+
+    /////////////////////////////////////////////////
+    Registry::ConstSnapshotPtr Registry::GetSnapshot() const
+    {
+      return std::atomic_load(&this->current);
+    }
+
+    /////////////////////////////////////////////////
+    Registry::ConstSnapshotPtr Registry::Update(
+        const std::function<void(Snapshot&)> &_update)
+    {
+      std::lock_guard<std::mutex> lock(this->updateMutex);
+
+      // Only updates modify `current`, so we can read it without the atomic
+      // functions while we hold the lock.
+      //
+      // Dev note: The copy shares every plugin and index with the current
+      // snapshot, so it is cheap no matter how many plugins there are. Only
+      // the parts that the callback changes get copied.
+      const std::shared_ptr<Snapshot> next =
+          std::make_shared<Snapshot>(*this->current);
+      _update(*next);
+
+      // Dev note: The previous snapshot is handed to the caller instead of
+      // being released here, so that it is not destructed while the lock is
+      // held, nor while the caller holds a lock of its own.
+      return std::atomic_exchange(&this->current, ConstSnapshotPtr(next));
+    }
+
+    /////////////////////////////////////////////////
+    std::string Registry::PrettyStr() const
+    {
+      return this->GetSnapshot()->PrettyStr();
+    }
+
+    /////////////////////////////////////////////////
+    std::unordered_set<std::string> Registry::InterfacesImplemented() const
+    {
+      return this->GetSnapshot()->InterfacesImplemented();
+    }
+
+    /////////////////////////////////////////////////
+    std::unordered_set<std::string> Registry::PluginsImplementing(
+        const std::string &_interface,
+        const bool _demangled) const
+    {
+      return this->GetSnapshot()->PluginsImplementing(_interface, _demangled);
+    }
+
+    /////////////////////////////////////////////////
+    std::set<std::string> Registry::PluginsWithAlias(
+        const std::string &_alias) const
+    {
+      return this->GetSnapshot()->PluginsWithAlias(_alias);
+    }
+
+    /////////////////////////////////////////////////
+    std::set<std::string> Registry::AliasesOfPlugin(
+        const std::string &_pluginName) const
+    {
+      return this->GetSnapshot()->AliasesOfPlugin(_pluginName);
+    }
+
+    /////////////////////////////////////////////////
+    std::string Registry::LookupPlugin(const std::string &_nameOrAlias) const
+    {
+      return this->GetSnapshot()->LookupPlugin(_nameOrAlias);
+    }
+
+    /////////////////////////////////////////////////
+    std::set<std::string> Registry::AllPlugins() const
+    {
+      return this->GetSnapshot()->AllPlugins();
+    }
+
+    /////////////////////////////////////////////////
+    ConstInfoPtr Registry::GetInfo(const std::string &_pluginName) const
+    {
+      return this->GetSnapshot()->GetInfo(_pluginName);
+    }
+
+    /////////////////////////////////////////////////
+    bool Registry::AddInfo(const Info &_info)
+    {
+      return this->AddInfo(_info, nullptr);
+    }
+
+    /////////////////////////////////////////////////
+    bool Registry::AddInfo(
+        const Info &_info, const std::shared_ptr<void> &_library)
+    {
+      bool inserted = false;
+      this->Update([&](Snapshot &_plugins)
+      {
+        inserted = _plugins.AddInfo(std::make_shared<Info>(_info), _library);
+      });
+
+      return inserted;
+    }
+
+    /////////////////////////////////////////////////
+    void Registry::ForgetInfo(const std::string &_pluginName)
+    {
+      this->Update([&](Snapshot &_plugins)
+      {
+        _plugins.ForgetInfo(_pluginName);
+      });
     }
   }
 }
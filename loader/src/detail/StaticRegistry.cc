@@ -30,74 +30,62 @@ namespace gz
       return *instance;
     }
 
-    /////////////////////////////////////////////////
-    std::set<std::string> StaticRegistry::AllPlugins() const
-    {
-      std::set<std::string> result;
-
-      for (const auto &entry : this->infos)
-        result.insert(result.end(), entry.first);
-
-      return result;
-    }
-
     /////////////////////////////////////////////////
     bool StaticRegistry::AddInfo(const Info& _info)
     {
-      InfoMap::iterator it;
-      bool inserted;
-
-      std::string pluginName = DemangleSymbol(_info.name);
+      const std::string pluginName = DemangleSymbol(_info.name);
 
-      // We use insert to ensure that we do not accidentally overwrite some
-      // existing information for the plugin that has this name.
-      std::tie(it, inserted) = this->infos.insert(
-          std::make_pair(pluginName, _info));
-
-      if (inserted)
+      this->Update([&](Snapshot &_plugins)
       {
-        it->second.name = pluginName;
-        for (const auto &interfaceMapEntry : _info.interfaces)
+        // The Info in a snapshot cannot be modified, so we merge the new
+        // information into a copy and replace the old Info with it.
+        std::shared_ptr<Info> merged;
+
+        const Snapshot::Entry *existing = _plugins.FindPlugin(pluginName);
+        if (nullptr == existing)
         {
-          it->second.demangledInterfaces.insert(
-              DemangleSymbol(interfaceMapEntry.first));
+          merged = std::make_shared<Info>(_info);
+          merged->name = pluginName;
+          for (const auto &interfaceMapEntry : _info.interfaces)
+          {
+            if (!detail::IsSharedInstanceMarker(interfaceMapEntry.first))
+            {
+              merged->demangledInterfaces.insert(
+                  DemangleSymbol(interfaceMapEntry.first));
+            }
+          }
         }
-      }
-      else
-      {
-        // If the object was not inserted, then an entry already existed for
-        // this plugin type. We should still insert each of the interface map
-        // entries provided by the input info, just in case any of
-        // them are missing from the currently existing entry. This allows the
-        // user to specify different interfaces for the same plugin
-        // type using different macros in different locations or across
-        // multiple translation units.
-        for (const auto &interfaceMapEntry : _info.interfaces)
+        else
         {
-          it->second.interfaces.insert(interfaceMapEntry);
-          it->second.demangledInterfaces.insert(
-              DemangleSymbol(interfaceMapEntry.first));
-        }
+          // If an entry already existed for this plugin type, we should
+          // still insert each of the interface map entries provided by the
+          // input info, just in case any of them are missing from the
+          // currently existing entry. This allows the user to specify
+          // different interfaces for the same plugin type using different
+          // macros in different locations or across multiple translation
+          // units.
+          merged = std::make_shared<Info>(*existing->info);
+          for (const auto &interfaceMapEntry : _info.interfaces)
+          {
+            merged->interfaces.insert(interfaceMapEntry);
+            if (!detail::IsSharedInstanceMarker(interfaceMapEntry.first))
+            {
+              merged->demangledInterfaces.insert(
+                  DemangleSymbol(interfaceMapEntry.first));
+            }
+          }
 
-        // Add aliases
-        for (const std::string &alias : _info.aliases)
-          it->second.aliases.insert(alias);
-      }
+          // Add aliases
+          for (const std::string &alias : _info.aliases)
+            merged->aliases.insert(alias);
 
-      for (const std::string &alias : _info.aliases)
-        this->aliases[alias].insert(pluginName);
+          _plugins.ForgetInfo(pluginName);
+        }
 
-      return true;
-    }
+        _plugins.AddInfo(std::move(merged));
+      });
 
-    /////////////////////////////////////////////////
-    ConstInfoPtr StaticRegistry::GetInfo(
-        const std::string &_pluginName) const
-    {
-      const InfoMap::const_iterator it = this->infos.find(_pluginName);
-      if (this->infos.end() == it)
-        return nullptr;
-      return std::make_shared<Info>(it->second);
+      return true;
     }
   }
 }
@@ -53,6 +53,29 @@
 #define GZ_ADD_PLUGIN(PluginClass, ...) \
   DETAIL_GZ_ADD_PLUGIN(PluginClass, __VA_ARGS__)
 
+/// \brief Add a plugin whose one instance is shared by all of its users.
+///
+/// This works like GZ_ADD_PLUGIN, except that the Loader constructs the
+/// plugin only once, the first time it gets instantiated, and every later
+/// call to Instantiate(~) returns a PluginPtr to that same instance. This is
+/// meant for stateless plugins, e.g. strategy objects which are used in tight
+/// loops, because it saves constructing and destructing a new instance every
+/// time. Since the instance is used concurrently by everyone who instantiates
+/// the plugin, calling its interfaces must be thread-safe.
+///
+/// Every Loader that loads the library keeps its own instance, which is
+/// destructed once the Loader has forgotten the library and the last
+/// PluginPtr to the instance is gone.
+///
+/// \code
+/// GZ_ADD_PLUGIN_SHARED(PluginClass, Interface1, Interface2)
+/// \endcode
+///
+/// It is enough to use this macro for one of the registrations of a plugin,
+/// and the others may use GZ_ADD_PLUGIN.
+#define GZ_ADD_PLUGIN_SHARED(PluginClass, ...) \
+  DETAIL_GZ_ADD_PLUGIN(PluginClass, __VA_ARGS__, ::gz::plugin::SharedInstance)
+
 /// \brief Add an alias for one of your plugins.
 ///
 /// This macro can be put in any namespace and may be called any number of
@@ -52,6 +52,16 @@
 #define GZ_ADD_STATIC_PLUGIN(PluginClass, ...) \
   DETAIL_GZ_ADD_STATIC_PLUGIN(PluginClass, __VA_ARGS__)
 
+/// \brief Add a plugin from this static library whose one instance is
+/// shared by all of its users.
+///
+/// This works like GZ_ADD_PLUGIN_SHARED, except that the instance belongs to
+/// the program rather than to a Loader, so every Loader hands out PluginPtrs
+/// to the same instance. It lives until the program exits.
+#define GZ_ADD_STATIC_PLUGIN_SHARED(PluginClass, ...) \
+  DETAIL_GZ_ADD_STATIC_PLUGIN( \
+      PluginClass, __VA_ARGS__, ::gz::plugin::SharedInstance)
+
 /// \brief Add an alias for one of your plugins.
 ///
 /// This macro can be put in any namespace and may be called any number of
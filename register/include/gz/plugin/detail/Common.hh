@@ -19,6 +19,8 @@
 #ifndef GZ_PLUGIN_DETAIL_COMMON_HH_
 #define GZ_PLUGIN_DETAIL_COMMON_HH_
 
+#include <functional>
+#include <new>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -35,6 +37,124 @@ namespace gz
   {
     namespace detail
     {
+      //////////////////////////////////////////////////
+      /// \brief Makes the function which casts an instance of PluginClass to
+      /// one of its interfaces. This default is used when Interface is a
+      /// virtual base of PluginClass, because the location of a virtual base
+      /// can only be found through the instance itself. The casting function
+      /// is a plain function, so that it can also be put into a
+      /// PluginDescriptor.
+      template <typename PluginClass, typename Interface, typename = void>
+      struct InterfaceCaster
+      {
+        public: static void *Cast(void *v_ptr)
+        {
+          PluginClass *d_ptr = static_cast<PluginClass*>(v_ptr);
+          return static_cast<Interface*>(d_ptr);
+        }
+
+        public: static std::function<void*(void*)> Make()
+        {
+          return &Cast;
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief This specialization is used when Interface is a non-virtual
+      /// base of PluginClass (which is exactly when a pointer to Interface can
+      /// be static_cast back to a pointer to PluginClass). Then the interface
+      /// is always at the same offset within the instance.
+      template <typename PluginClass, typename Interface>
+      struct InterfaceCaster<PluginClass, Interface, std::void_t<
+          decltype(static_cast<PluginClass*>(std::declval<Interface*>()))>>
+      {
+        public: static std::function<void*(void*)> Make()
+        {
+          // Converting a pointer into a pointer to a non-virtual base is plain
+          // pointer arithmetic which never reads the object, so any suitably
+          // aligned address other than nullptr can be used to measure the
+          // offset.
+          PluginClass *const d_ptr =
+              reinterpret_cast<PluginClass*>(alignof(PluginClass));
+          Interface *const i_ptr = d_ptr;
+
+          return InterfaceOffset{
+              reinterpret_cast<char*>(i_ptr) - reinterpret_cast<char*>(d_ptr)};
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief The layout of PluginClass, which lets the Loader construct its
+      /// instances in storage that it allocates itself.
+      template <typename PluginClass>
+      struct InstanceLayoutOf
+      {
+        public: static void *Create()
+        {
+          // vvvvvvvvvvvvvvvvvvvvvvvv  READ ME  vvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+          // If you get a compilation error here, then you are trying to
+          // register an abstract class as a plugin, which is not allowed. To
+          // register a plugin class, every one if its virtual functions must
+          // have a definition.
+          //
+          // Read through the error produced by your compiler to see which
+          // pure virtual functions you are neglecting to provide overrides
+          // for.
+          // ^^^^^^^^^^^^^ READ ABOVE FOR COMPILATION ERRORS ^^^^^^^^^^^^^^^^
+          return static_cast<void*>(new PluginClass);
+        }
+
+        public: static void *Construct(void *_storage)
+        {
+          return static_cast<void*>(::new (_storage) PluginClass);
+        }
+
+        public: static void Destroy(void *_instance)
+        {
+          static_cast<PluginClass*>(_instance)->~PluginClass();
+        }
+
+GZ_UTILS_WARN_IGNORE__NON_VIRTUAL_DESTRUCTOR
+        public: static void Delete(void *_instance)
+        {
+          delete static_cast<PluginClass*>(_instance);
+        }
+GZ_UTILS_WARN_RESUME__NON_VIRTUAL_DESTRUCTOR
+
+        public: static InstanceLayout Describe()
+        {
+          return {sizeof(PluginClass), alignof(PluginClass),
+                  &Create, &Construct, &Destroy};
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief Makes the factory of PluginClass. This default is used for
+      /// most plugin classes, and it lets the Loader construct their instances
+      /// in place.
+      template <typename PluginClass, typename = void>
+      struct FactoryMaker
+      {
+        public: static std::function<void*()> Make()
+        {
+          return InstanceFactory{&InstanceLayoutOf<PluginClass>::Describe};
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief This specialization is used when PluginClass has its own
+      /// operator new, which must not be bypassed. Its instances are always
+      /// allocated by a new-expression.
+      template <typename PluginClass>
+      struct FactoryMaker<PluginClass, std::void_t<
+          decltype(PluginClass::operator new(std::declval<std::size_t>()))>>
+      {
+        public: static std::function<void*()> Make()
+        {
+          return &InstanceLayoutOf<PluginClass>::Create;
+        }
+      };
+
       //////////////////////////////////////////////////
       /// \brief This default will be called when NoMoreInterfaces is an empty
       /// parameter pack. When one or more Interfaces are provided, the other
@@ -71,11 +191,26 @@ namespace gz
 
           interfaces.insert(std::make_pair(
                 typeid(Interface).name(),
-                [=](void* v_ptr)
-                {
-                    PluginClass *d_ptr = static_cast<PluginClass*>(v_ptr);
-                    return static_cast<Interface*>(d_ptr);
-                }));
+                InterfaceCaster<PluginClass, Interface>::Make()));
+
+          InterfaceHelper<PluginClass, RemainingInterfaces...>
+              ::InsertInterfaces(interfaces);
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief This specialization will be called for the SharedInstance
+      /// marker, which is listed like an interface even though it is not a
+      /// base class of the plugin.
+      template <typename PluginClass, typename... RemainingInterfaces>
+      struct InterfaceHelper<PluginClass, SharedInstance,
+                             RemainingInterfaces...>
+      {
+        public: static void InsertInterfaces(
+          Info::InterfaceCastingMap &interfaces)
+        {
+          interfaces.insert(std::make_pair(
+                typeid(SharedInstance).name(), InterfaceOffset{0}));
 
           InterfaceHelper<PluginClass, RemainingInterfaces...>
               ::InsertInterfaces(interfaces);
@@ -109,11 +244,7 @@ namespace gz
         {
           _interfaces.insert(std::make_pair(
                   typeid(EnablePluginFromThis).name(),
-                  [=](void *v_ptr)
-                  {
-                    PluginClass *d_ptr = static_cast<PluginClass*>(v_ptr);
-                    return static_cast<EnablePluginFromThis*>(d_ptr);
-                  }));
+                  InterfaceCaster<PluginClass, EnablePluginFromThis>::Make()));
         }
       };
 
@@ -135,6 +266,32 @@ namespace gz
                 std::is_base_of<EnablePluginFromThis, PluginClass>::value>
       { }; // NOLINT
 
+      //////////////////////////////////////////////////
+      /// \brief Add the Info of one registration to the Info of a library.
+      /// If the plugin was already registered, then the interfaces and aliases
+      /// of _info are added to its existing Info. This allows the user to
+      /// specify different interfaces and aliases for the same plugin type
+      /// using different macros in different locations or across multiple
+      /// translation units.
+      /// \param[in,out] _infos The Info of every plugin of the library
+      /// \param[in] _info The Info of the registration
+      inline void InsertInfo(InfoMap &_infos, const Info &_info)
+      {
+        // We use insert(~) to ensure that we do not accidentally overwrite
+        // some existing information for the plugin that has this name.
+        const auto result = _infos.insert(std::make_pair(_info.name, _info));
+        if (result.second)
+          return;
+
+        Info &entry = result.first->second;
+
+        for (const auto &interfaceMapEntry : _info.interfaces)
+          entry.interfaces.insert(interfaceMapEntry);
+
+        for (const auto &aliasSetEntry : _info.aliases)
+          entry.aliases.insert(aliasSetEntry);
+      }
+
       //////////////////////////////////////////////////
       template <typename PluginClass, typename... Interfaces>
       Info MakeInfo()
@@ -145,28 +302,10 @@ namespace gz
         info.name = typeid(PluginClass).name();
 
         // Create a factory for generating new plugin instances
-        info.factory = [=]()
-        {
-          // vvvvvvvvvvvvvvvvvvvvvvvv  READ ME  vvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-          // If you get a compilation error here, then you are trying to
-          // register an abstract class as a plugin, which is not allowed. To
-          // register a plugin class, every one if its virtual functions must
-          // have a definition.
-          //
-          // Read through the error produced by your compiler to see which
-          // pure virtual functions you are neglecting to provide overrides
-          // for.
-          // ^^^^^^^^^^^^^ READ ABOVE FOR COMPILATION ERRORS ^^^^^^^^^^^^^^^^
-          return static_cast<void*>(new PluginClass);
-        };
+        info.factory = FactoryMaker<PluginClass>::Make();
 
-GZ_UTILS_WARN_IGNORE__NON_VIRTUAL_DESTRUCTOR
         // Create a deleter to clean up destroyed instances
-        info.deleter = [=](void *ptr)
-        {
-          delete static_cast<PluginClass*>(ptr);
-        };
-GZ_UTILS_WARN_RESUME__NON_VIRTUAL_DESTRUCTOR
+        info.deleter = &InstanceLayoutOf<PluginClass>::Delete;
 
         // Construct a map from the plugin to its interfaces
         InterfaceHelper<PluginClass, Interfaces...>
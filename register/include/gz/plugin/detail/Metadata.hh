@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PLUGIN_DETAIL_METADATA_HH_
+#define GZ_PLUGIN_DETAIL_METADATA_HH_
+
+#include <cstddef>
+#include <type_traits>
+
+#include <gz/plugin/EnablePluginFromThis.hh>
+
+// Dev note: The plugin registration macros describe each plugin with a
+// plain text record which gets placed into a dedicated section of the shared
+// library, so that the Loader can find out which plugins a library provides by
+// reading the file instead of loading it. The records contain no pointers, so
+// they are read-only and need no relocations. Each record looks like
+//
+//     gz-plugin-metadata\t1\n
+//     plugin\t<plugin type name>\n
+//     interface\t<interface type name>\n   (zero or more times)
+//
+// or, for aliases,
+//
+//     gz-plugin-metadata\t1\n
+//     alias\t<plugin type name>\t<alias arguments as written in the macro>\n
+//
+// The type names are computed at compile time from __PRETTY_FUNCTION__, so
+// they are demangled names. The linker may pad the section with null bytes
+// between records. The name of the section is also hard-coded in the loader
+// component (see loader/src/PluginMetadata.cc), so both must be kept in sync.
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+  #define DETAIL_GZ_PLUGIN_HAVE_METADATA
+  #define DETAIL_GZ_PLUGIN_METADATA_SECTION "gz_plugin_metadata"
+#endif
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      /// \brief A view of a string that can be used in constant expressions.
+      struct MetadataString
+      {
+        /// \brief Start of the string. It is not null-terminated.
+        const char *data;
+
+        /// \brief Number of characters in the string
+        std::size_t size;
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief Make a MetadataString out of a string literal.
+      template <std::size_t N>
+      constexpr MetadataString MetadataLiteral(const char (&_literal)[N])
+      {
+        return MetadataString{_literal, N - 1};
+      }
+
+      //////////////////////////////////////////////////
+      /// \brief Get the fully qualified name of a type at compile time.
+      template <typename T>
+      struct MetadataTypeName
+      {
+        public: static constexpr MetadataString Get()
+        {
+#ifdef DETAIL_GZ_PLUGIN_HAVE_METADATA
+          // GCC spells this function as
+          //   "... Get() [with T = some::Type]"
+          // while Clang spells it as
+          //   "... Get() [T = some::Type]"
+          const char *pretty = __PRETTY_FUNCTION__;
+
+          std::size_t begin = 0;
+          while (pretty[begin] != '\0'
+                 && !(pretty[begin] == '=' && pretty[begin + 1] == ' '))
+          {
+            ++begin;
+          }
+
+          if (pretty[begin] == '\0')
+            return MetadataString{pretty, 0};
+
+          begin += 2;
+
+          // Find the closing bracket, while skipping over any brackets that
+          // belong to template arguments.
+          std::size_t end = begin;
+          int depth = 0;
+          while (pretty[end] != '\0'
+                 && !(depth == 0 && (pretty[end] == ']' || pretty[end] == ';')))
+          {
+            if (pretty[end] == '<' || pretty[end] == '[')
+              ++depth;
+            else if (pretty[end] == '>' || pretty[end] == ']')
+              --depth;
+
+            ++end;
+          }
+
+          return MetadataString{pretty + begin, end - begin};
+#else
+          return MetadataString{"", 0};
+#endif
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief Storage for a metadata record. This is a plain character
+      /// array, so it can be constant-initialized into a read-only section.
+      template <std::size_t N>
+      struct MetadataRecord
+      {
+        /// \brief Text of the record
+        char text[N];
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief Helper for writing the text of a metadata record. The same
+      /// function is used to measure the record and to fill it in.
+      struct MetadataWriter
+      {
+        /// \brief Append a string to the record.
+        /// \param[in] _string The string to append
+        public: constexpr void Append(const MetadataString &_string)
+        {
+          for (std::size_t i = 0; i < _string.size; ++i)
+          {
+            if (this->text)
+              this->text[this->size] = _string.data[i];
+            ++this->size;
+          }
+        }
+
+        /// \brief Buffer to write into, or nullptr to only measure the size
+        public: char *text;
+
+        /// \brief Number of characters that have been appended
+        public: std::size_t size;
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief The metadata record which describes one plugin registration.
+      template <typename PluginClass, typename... Interfaces>
+      struct PluginMetadata
+      {
+        /// \brief Write the record.
+        /// \param[in,out] _writer The writer for the record
+        public: static constexpr void Write(MetadataWriter &_writer)
+        {
+          const MetadataString interfaces[] = {
+            MetadataTypeName<Interfaces>::Get()...,
+            // Add the EnablePluginFromThis interface just like the Registrar
+            // does when PluginClass inherits it.
+            std::is_base_of<EnablePluginFromThis, PluginClass>::value
+              ? MetadataTypeName<EnablePluginFromThis>::Get()
+              : MetadataString{"", 0}
+          };
+
+          _writer.Append(MetadataLiteral("gz-plugin-metadata\t1\nplugin\t"));
+          _writer.Append(MetadataTypeName<PluginClass>::Get());
+          _writer.Append(MetadataLiteral("\n"));
+
+          for (const MetadataString &interface : interfaces)
+          {
+            if (0 == interface.size)
+              continue;
+
+            _writer.Append(MetadataLiteral("interface\t"));
+            _writer.Append(interface);
+            _writer.Append(MetadataLiteral("\n"));
+          }
+        }
+
+        /// \brief Get the size of the record.
+        public: static constexpr std::size_t Size()
+        {
+          MetadataWriter writer{nullptr, 0};
+          Write(writer);
+          return writer.size;
+        }
+
+        /// \brief Make the record.
+        public: static constexpr MetadataRecord<Size()> Make()
+        {
+          MetadataRecord<Size()> record{};
+          MetadataWriter writer{record.text, 0};
+          Write(writer);
+          return record;
+        }
+      };
+
+      //////////////////////////////////////////////////
+      /// \brief The metadata record which describes one alias registration.
+      /// \tparam N Size of the stringified alias arguments, including the
+      /// null terminator
+      template <std::size_t N, typename PluginClass>
+      struct AliasMetadata
+      {
+        /// \brief Write the record.
+        /// \param[in,out] _writer The writer for the record
+        /// \param[in] _aliases The stringified alias arguments
+        public: static constexpr void Write(
+          MetadataWriter &_writer, const char (&_aliases)[N])
+        {
+          _writer.Append(MetadataLiteral("gz-plugin-metadata\t1\nalias\t"));
+          _writer.Append(MetadataTypeName<PluginClass>::Get());
+          _writer.Append(MetadataLiteral("\t"));
+          _writer.Append(MetadataLiteral(_aliases));
+          _writer.Append(MetadataLiteral("\n"));
+        }
+
+        /// \brief Get the size of the record.
+        public: static constexpr std::size_t Size()
+        {
+          // The alias arguments are only measured here, so any string of the
+          // right size will do.
+          MetadataWriter writer{nullptr, 0};
+          const char placeholder[N] = {};
+          Write(writer, placeholder);
+          return writer.size;
+        }
+
+        /// \brief Make the record.
+        /// \param[in] _aliases The stringified alias arguments
+        public: static constexpr MetadataRecord<Size()> Make(
+          const char (&_aliases)[N])
+        {
+          MetadataRecord<Size()> record{};
+          MetadataWriter writer{record.text, 0};
+          Write(writer, _aliases);
+          return record;
+        }
+      };
+    }
+  }
+}
+
+#ifdef DETAIL_GZ_PLUGIN_HAVE_METADATA
+//////////////////////////////////////////////////
+/// This macro places a metadata record into the metadata section of the
+/// library. It must be used inside of an anonymous namespace.
+#define DETAIL_GZ_PLUGIN_METADATA(UniqueID, ...) \
+  __attribute__((section(DETAIL_GZ_PLUGIN_METADATA_SECTION), used)) \
+  constexpr auto metadata##UniqueID = __VA_ARGS__;
+#else
+#define DETAIL_GZ_PLUGIN_METADATA(UniqueID, ...)
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PLUGIN_DETAIL_PLUGINDESCRIPTORS_HH_
+#define GZ_PLUGIN_DETAIL_PLUGINDESCRIPTORS_HH_
+
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/PluginDescriptor.hh>
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      /// \brief Owns the descriptors of all the plugins of a library, which
+      /// are made from the Info that its registration macros have collected.
+      /// The descriptors point into that Info, so the InfoMap must not change
+      /// anymore once they have been made.
+      class PluginDescriptors
+      {
+        /// \brief Describe the plugins of a library
+        /// \param[in] _infos The Info of every plugin of the library
+        public: explicit PluginDescriptors(const InfoMap &_infos)
+        {
+          // Reserve everything up front, so that the pointers which the
+          // plugin descriptors hold into the other vectors stay valid.
+          std::size_t interfaceCount = 0;
+          std::size_t aliasCount = 0;
+          for (const InfoMap::value_type &entry : _infos)
+          {
+            interfaceCount += entry.second.interfaces.size();
+            aliasCount += entry.second.aliases.size();
+          }
+
+          this->plugins.reserve(_infos.size());
+          this->interfaces.reserve(interfaceCount);
+          this->aliases.reserve(aliasCount);
+
+          for (const InfoMap::value_type &entry : _infos)
+          {
+            if (!this->Describe(entry.second))
+            {
+              this->complete = false;
+              return;
+            }
+          }
+
+          this->table = {this->plugins.data(), this->plugins.size()};
+        }
+
+        /// \brief Check whether every plugin could be described. A plugin
+        /// whose Info holds a callable that is not a plain function cannot
+        /// be, and then the library may only hand out its InfoMap.
+        /// \return True if the table describes every plugin
+        public: bool Complete() const
+        {
+          return this->complete;
+        }
+
+        /// \brief Get the table of all the plugins
+        /// \return The table of all the plugins
+        public: const PluginDescriptorTable &Table() const
+        {
+          return this->table;
+        }
+
+        /// \brief Add the descriptor of a plugin
+        /// \param[in] _info The Info of the plugin
+        /// \return False if the plugin cannot be described
+        private: bool Describe(const Info &_info)
+        {
+          PluginDescriptor plugin = {};
+          plugin.name = View(_info.name);
+
+          if (const InstanceFactory *factory =
+                _info.factory.target<InstanceFactory>())
+          {
+            plugin.describe = factory->describe;
+          }
+          else if (void *(*const *create)() =
+                     _info.factory.target<void*(*)()>())
+          {
+            plugin.create = *create;
+          }
+          else
+          {
+            return false;
+          }
+
+          if (void (*const *deleter)(void*) =
+                _info.deleter.target<void(*)(void*)>())
+          {
+            plugin.deleter = *deleter;
+          }
+          else
+          {
+            return false;
+          }
+
+          plugin.interfaces = this->interfaces.data() + this->interfaces.size();
+          for (const auto &interface : _info.interfaces)
+          {
+            InterfaceDescriptor descriptor = {};
+            descriptor.name = View(interface.first);
+
+            if (const InterfaceOffset *offset =
+                  interface.second.target<InterfaceOffset>())
+            {
+              descriptor.offset = offset->offset;
+            }
+            else if (void *(*const *cast)(void*) =
+                       interface.second.target<void*(*)(void*)>())
+            {
+              descriptor.cast = *cast;
+            }
+            else
+            {
+              return false;
+            }
+
+            this->interfaces.push_back(descriptor);
+          }
+          plugin.interfaceCount = _info.interfaces.size();
+
+          plugin.aliases = this->aliases.data() + this->aliases.size();
+          for (const std::string &alias : _info.aliases)
+            this->aliases.push_back(View(alias));
+          plugin.aliasCount = _info.aliases.size();
+
+          this->plugins.push_back(plugin);
+          return true;
+        }
+
+        /// \brief Refer to a string of the InfoMap
+        /// \param[in] _string The string
+        /// \return A descriptor string which points into _string
+        private: static DescriptorString View(const std::string &_string)
+        {
+          return {_string.data(), _string.size()};
+        }
+
+        /// \brief The descriptors of the plugins
+        private: std::vector<PluginDescriptor> plugins;
+
+        /// \brief The descriptors of the interfaces of all the plugins
+        private: std::vector<InterfaceDescriptor> interfaces;
+
+        /// \brief The aliases of all the plugins
+        private: std::vector<DescriptorString> aliases;
+
+        /// \brief The table that is handed to the Loader
+        private: PluginDescriptorTable table = {nullptr, 0};
+
+        /// \brief False if some plugin could not be described
+        private: bool complete = true;
+      };
+    }
+  }
+}
+
+#endif
@@ -24,6 +24,8 @@
 
 #include <gz/plugin/Info.hh>
 #include <gz/plugin/detail/Common.hh>
+#include <gz/plugin/detail/Metadata.hh>
+#include <gz/plugin/detail/PluginDescriptors.hh>
 #include <gz/plugin/utility.hh>
 
 
@@ -45,11 +47,66 @@
   #endif
 #endif
 
+// Dev note: On ELF platforms, the plugin registration macros do not run any
+// code when the library gets loaded. Instead, each of them places a constant
+// Registration record into a dedicated section of the library. GzPluginHook
+// walks over the records of its own library the first time that a Loader
+// queries it, and only then makes the Info of the plugins. On other platforms,
+// each macro declares a static object whose constructor hands the Info of its
+// registration to GzPluginHook while the library is being loaded.
+//
+// The section name must be a valid C identifier, so that the linker defines
+// the __start_ and __stop_ symbols for it. It is spelled out again in those
+// symbol names below, so both must be kept in sync.
+#ifdef DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION
+  #undef DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION
+#endif
+
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+  #define DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION
+  #define DETAIL_GZ_PLUGIN_REGISTRATION_SECTION "gz_plugin_registrations"
+#endif
+
+namespace gz
+{
+  namespace plugin
+  {
+    namespace detail
+    {
+      //////////////////////////////////////////////////
+      /// \brief The record that a plugin registration macro leaves in the
+      /// library. It holds nothing but a pointer to a function, so it is
+      /// constant-initialized and needs no code to run when the library gets
+      /// loaded.
+      struct Registration
+      {
+        /// \brief Makes the Info of the registration
+        Info (*makeInfo)();
+      };
+    }
+  }
+}
+
 // extern "C" ensures that the symbol name of GzPluginHook
 // does not get mangled by the compiler, so we can easily use dlsym(~) to
 // retrieve it.
 extern "C"
 {
+#if defined(DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION) \
+    && !defined(GZ_PLUGIN_REGISTER_MORE_TRANS_UNITS)
+  // The linker defines these symbols at the start and the end of the section
+  // of registration records. They are hidden so that GzPluginHook only finds
+  // the records of its own library, and weak so that a library without any
+  // records still links.
+  extern const gz::plugin::detail::Registration
+      __start_gz_plugin_registrations[]
+      __attribute__((weak, visibility("hidden")));
+
+  extern const gz::plugin::detail::Registration
+      __stop_gz_plugin_registrations[]
+      __attribute__((weak, visibility("hidden")));
+#endif
+
   /// \private GzPluginHook is the hook that's used by the Loader to
   /// retrieve Info from a shared library that provides plugins.
   ///
@@ -61,17 +118,20 @@ extern "C"
   /// should be using it.
   ///
   /// \param[in] _inputSingleInfo
-  ///   This argument is used by Registrar to input a single instance of
-  ///   plugin::Info data. Loader will set this to a nullptr when trying to
-  ///   receive data from the hook.
+  ///   This argument is used by the registration macros to input a single
+  ///   instance of plugin::Info data on platforms where they cannot leave a
+  ///   Registration record in the library. Loader will set this to a nullptr
+  ///   when trying to receive data from the hook.
   ///
   /// \param[out] _outputAllInfo
-  ///   Loader will pass in a pointer to a pointer of an InfoMap pertaining to
-  ///   the highest API version that it knows of. If this GzPluginHook was
-  ///   built against a version of gz-plugin that provides an equal or greater
-  ///   API version, then GzPluginHook will modify *_outputAllInfo to
-  ///   point at its internal &InfoMap that corresponds to the requested API
-  ///   version, which is identified by _inputAndOutputAPIVersion.
+  ///   Loader will pass in a pointer to a pointer of the plugin information
+  ///   pertaining to the highest API version that it knows of. That is a
+  ///   PluginDescriptorTable for version 2, and an InfoMap for version 1. If
+  ///   this GzPluginHook was built against a version of gz-plugin that
+  ///   provides an equal or greater API version, then GzPluginHook will
+  ///   modify *_outputAllInfo to point at its internal information that
+  ///   corresponds to the requested API version, which is identified by
+  ///   _inputAndOutputAPIVersion.
   ///
   ///   If _inputAndOutputAPIVersion is greater than the highest API version
   ///   known by this GzPluginHook, then GzPluginHook will not
@@ -123,43 +183,17 @@ extern "C"
   {
     using InfoMap = gz::plugin::InfoMap;
     // We use a static variable here so that we can accumulate multiple
-    // Info objects from multiple plugin registration calls within one
-    // shared library, and then provide it all to the Loader through this
-    // single hook.
+    // Info objects from multiple plugin registrations within one shared
+    // library, and then provide it all to the Loader through this single
+    // hook.
     static InfoMap pluginMap;
 
     if (_inputSingleInfo)
     {
       // When _inputSingleInfo is not a nullptr, it means that one of the plugin
       // registration macros is providing us with some Info.
-      const gz::plugin::Info *input =
-          static_cast<const gz::plugin::Info*>(_inputSingleInfo);
-
-      InfoMap::iterator it;
-      bool inserted;
-
-      // We use insert(~) to ensure that we do not accidentally overwrite some
-      // existing information for the plugin that has this name.
-      std::tie(it, inserted) =
-          pluginMap.insert(std::make_pair(input->name, *input));
-
-      if (!inserted)
-      {
-        // If the object was not inserted, then an entry already existed for
-        // this plugin type. We should still insert each of the interface map
-        // entries and aliases provided by the input info, just in case any of
-        // them are missing from the currently existing entry. This allows the
-        // user to specify different interfaces and aliases for the same plugin
-        // type using different macros in different locations or across multiple
-        // translation units.
-        gz::plugin::Info &entry = it->second;
-
-        for (const auto &interfaceMapEntry : input->interfaces)
-          entry.interfaces.insert(interfaceMapEntry);
-
-        for (const auto &aliasSetEntry : input->aliases)
-          entry.aliases.insert(aliasSetEntry);
-      }
+      gz::plugin::detail::InsertInfo(pluginMap,
+          *static_cast<const gz::plugin::Info*>(_inputSingleInfo));
     }
 
     if (_outputAllInfo)
@@ -179,29 +213,72 @@ extern "C"
         // LCOV_EXCL_STOP
       }
 
-      bool agreement = true;
-
-      if (gz::plugin::INFO_API_VERSION != *_inputAndOutputAPIVersion)
+#ifdef DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION
+      // The Info of the plugins is made from the registration records the
+      // first time that a Loader asks for it. Concurrent Loaders wait until
+      // it is ready.
+      static const bool registered = []()
       {
-        // LCOV_EXCL_START
-        agreement = false;
-        // LCOV_EXCL_STOP
-      }
+        for (const gz::plugin::detail::Registration *registration =
+               __start_gz_plugin_registrations;
+             registration != __stop_gz_plugin_registrations;
+             ++registration)
+        {
+          // Skip any padding that the linker might have put between records
+          if (registration->makeInfo)
+          {
+            gz::plugin::detail::InsertInfo(
+                  pluginMap, registration->makeInfo());
+          }
+        }
+
+        return true;
+      }();
+      static_cast<void>(registered);
+#endif
 
-      if (sizeof(gz::plugin::Info) != *_inputAndOutputInfoSize)
+      // We answer with the version that the Loader asked for if we know it.
+      // Loaders which were built before version 2 of the API ask for the
+      // InfoMap of version 1, and the others get the descriptor table.
+      int version = gz::plugin::INFO_API_VERSION;
+      std::size_t size = sizeof(gz::plugin::detail::PluginDescriptor);
+      std::size_t alignment = alignof(gz::plugin::detail::PluginDescriptor);
+      const void *output = nullptr;
+
+      if (gz::plugin::INFO_MAP_API_VERSION == *_inputAndOutputAPIVersion)
       {
-        // LCOV_EXCL_START
-        agreement = false;
-        // LCOV_EXCL_STOP
+        version = gz::plugin::INFO_MAP_API_VERSION;
+        size = sizeof(gz::plugin::Info);
+        alignment = alignof(gz::plugin::Info);
+        output = &pluginMap;
       }
-
-      if (alignof(gz::plugin::Info) != *_inputAndOutputInfoAlign)
+      else
       {
-        // LCOV_EXCL_START
-        agreement = false;
-        // LCOV_EXCL_STOP
+        // The descriptors are made the first time that a Loader asks for
+        // them, which is after every plugin of this library has been
+        // registered. Concurrent Loaders wait until they are ready.
+        static const gz::plugin::detail::PluginDescriptors
+            descriptors(pluginMap);
+
+        if (descriptors.Complete())
+        {
+          output = &descriptors.Table();
+        }
+        else
+        {
+          // LCOV_EXCL_START
+          version = gz::plugin::INFO_MAP_API_VERSION;
+          size = sizeof(gz::plugin::Info);
+          alignment = alignof(gz::plugin::Info);
+          // LCOV_EXCL_STOP
+        }
       }
 
+      const bool agreement =
+          version == *_inputAndOutputAPIVersion &&
+          size == *_inputAndOutputInfoSize &&
+          alignment == *_inputAndOutputInfoAlign;
+
       // The handshake parameters that were passed into us are overwritten with
       // the values that we have on our end. That way, if our Info API is
       // lower than that of the Loader, then the Loader will know
@@ -211,17 +288,17 @@ extern "C"
       // This implementation might change when new API versions are introduced,
       // but this current implementation will still be forward compatible with
       // new API versions.
-      *_inputAndOutputAPIVersion = gz::plugin::INFO_API_VERSION;
-      *_inputAndOutputInfoSize = sizeof(gz::plugin::Info);
-      *_inputAndOutputInfoAlign = alignof(gz::plugin::Info);
+      *_inputAndOutputAPIVersion = version;
+      *_inputAndOutputInfoSize = size;
+      *_inputAndOutputInfoAlign = alignment;
 
       // If the size, alignment, or API do not agree, we should return without
       // outputting any of the plugin info; otherwise, we could get a
       // segmentation fault.
       //
-      // We will return the current API version to the Loader, and it may
-      // then decide to attempt the call to this function again with the correct
-      // API version if it supports backwards/forwards compatibility.
+      // We will return the API version that we can provide to the Loader, and
+      // it may then decide to attempt the call to this function again with
+      // that API version if it supports backwards/forwards compatibility.
       if (!agreement)
       {
         // LCOV_EXCL_START
@@ -229,7 +306,7 @@ extern "C"
         // LCOV_EXCL_STOP
       }
 
-      *_outputAllInfo = &pluginMap;
+      *_outputAllInfo = output;
     }
   }
 #endif
@@ -242,16 +319,16 @@ namespace gz
     namespace detail
     {
       //////////////////////////////////////////////////
-      /// \brief This specialization of the Register class will be called when
-      /// one or more arguments are provided to the GZ_ADD_PLUGIN(~)
-      /// macro. This is the only version of the Registrar class that is allowed
-      /// to compile.
+      /// \brief Makes the Info of a plugin registration. Only the primary
+      /// template of the Registrar class exists, and it requires at least the
+      /// plugin class as an argument of the GZ_ADD_PLUGIN(~) macro.
       template <typename PluginClass, typename... Interfaces>
       struct Registrar
       {
-        /// \brief This function registers a plugin along with a set of
-        /// interfaces that it provides.
-        public: static void Register()
+        /// \brief Make the Info of a plugin along with a set of interfaces
+        /// that it provides.
+        /// \return The Info of the registration
+        public: static Info MakeRegisteredInfo()
         {
           // Make all info that the user has specified
           Info info = MakeInfo<PluginClass, Interfaces...>();
@@ -260,16 +337,16 @@ namespace gz
           // inherited by PluginClass.
           IfEnablePluginFromThis<PluginClass>::AddIt(info.interfaces);
 
-          // Send this information as input to this library's global repository
-          // of plugins.
-          GzPluginHook(&info, nullptr, nullptr, nullptr, nullptr);
+          return info;
         }
 
-
+        /// \brief Make the Info of a set of aliases for a plugin
+        /// \param[in] aliases The aliases
+        /// \return The Info of the registration
         public: template <typename... Aliases>
-        static void RegisterAlias(Aliases&&... aliases)
+        static Info MakeAliasInfo(Aliases&&... aliases)
         {
-          // Dev note (MXG): We expect the RegisterAlias function to be called
+          // Dev note (MXG): We expect the MakeAliasInfo function to be called
           // using the GZ_ADD_PLUGIN_ALIAS(~) macro, which should never
           // contain any interfaces. Therefore, this parameter pack should be
           // empty.
@@ -287,22 +364,49 @@ namespace gz
           // Gather up all the aliases that have been specified for this plugin.
           InsertAlias(info.aliases, std::forward<Aliases>(aliases)...);
 
-          // Send this information as input to this library's global repository
-          // of plugins.
-          GzPluginHook(&info, nullptr, nullptr, nullptr, nullptr);
+          return info;
         }
       };
     }
   }
 }
 
+#ifdef DETAIL_GZ_PLUGIN_HAVE_REGISTRATION_SECTION
+//////////////////////////////////////////////////
+/// This macro places a Registration record into the registration section of
+/// the library. The variadic arguments are the function which makes the Info
+/// of the registration. It must be used inside of an anonymous namespace.
+#define DETAIL_GZ_PLUGIN_REGISTRATION(UniqueID, ...) \
+  __attribute__((section(DETAIL_GZ_PLUGIN_REGISTRATION_SECTION), used)) \
+  constexpr ::gz::plugin::detail::Registration registration##UniqueID = \
+      {__VA_ARGS__};
+#else
+//////////////////////////////////////////////////
+/// This macro creates a uniquely-named class whose constructor hands the Info
+/// of the registration to GzPluginHook. It then declares a uniquely-named
+/// instance of the class with static lifetime. Since the class instance has a
+/// static lifetime, it will be constructed when the shared library is loaded.
+#define DETAIL_GZ_PLUGIN_REGISTRATION(UniqueID, ...) \
+  struct ExecuteWhenLoadingLibrary##UniqueID \
+  { \
+    ExecuteWhenLoadingLibrary##UniqueID() \
+    { \
+      const ::gz::plugin::Info info = (__VA_ARGS__)(); \
+      GzPluginHook(&info, nullptr, nullptr, nullptr, nullptr); \
+    } \
+  }; \
+  \
+  static ExecuteWhenLoadingLibrary##UniqueID execute##UniqueID;
+#endif
+
 //////////////////////////////////////////////////
-/// This macro creates a uniquely-named class whose constructor calls the
-/// gz::plugin::detail::Registrar::Register function. It then declares a
-/// uniquely-named instance of the class with static lifetime. Since the class
-/// instance has a static lifetime, it will be constructed when the shared
-/// library is loaded. When it is constructed, the Register function will
-/// be called.
+/// This macro registers a plugin through
+/// gz::plugin::detail::Registrar::MakeRegisteredInfo, which is only called
+/// once a Loader asks the library for its plugins (see
+/// DETAIL_GZ_PLUGIN_REGISTRATION).
+///
+/// It also places a metadata record describing the plugin into the library, so
+/// that the Loader can discover the plugin without loading the library.
 #define DETAIL_GZ_ADD_PLUGIN_HELPER(UniqueID, ...) \
   namespace gz \
   { \
@@ -310,15 +414,11 @@ namespace gz
     { \
       namespace \
       { \
-        struct ExecuteWhenLoadingLibrary##UniqueID \
-        { \
-          ExecuteWhenLoadingLibrary##UniqueID() \
-          { \
-            ::gz::plugin::detail::Registrar<__VA_ARGS__>::Register(); \
-          } \
-        }; \
+        DETAIL_GZ_PLUGIN_REGISTRATION(UniqueID, \
+          &::gz::plugin::detail::Registrar<__VA_ARGS__>::MakeRegisteredInfo) \
   \
-        static ExecuteWhenLoadingLibrary##UniqueID execute##UniqueID; \
+        DETAIL_GZ_PLUGIN_METADATA(UniqueID, \
+          ::gz::plugin::detail::PluginMetadata<__VA_ARGS__>::Make()) \
       } /* namespace */ \
     } \
   }
@@ -339,12 +439,12 @@ namespace gz
 
 
 //////////////////////////////////////////////////
-/// This macro creates a uniquely-named class whose constructor calls the
-/// gz::plugin::detail::Registrar::RegisterAlias function. It then
-/// declares a uniquely-named instance of the class with static lifetime. Since
-/// the class instance has a static lifetime, it will be constructed when the
-/// shared library is loaded. When it is constructed, the Register function will
-/// be called.
+/// This macro creates a uniquely-named function which makes the Info of the
+/// aliases through gz::plugin::detail::Registrar::MakeAliasInfo, and registers
+/// it. The alias arguments are only evaluated when that function gets called.
+///
+/// The alias arguments are also recorded as written in the metadata of the
+/// library. The Loader can only make use of them if they are string literals.
 #define DETAIL_GZ_ADD_PLUGIN_ALIAS_HELPER(UniqueID, PluginClass, ...) \
   namespace gz \
   { \
@@ -352,16 +452,17 @@ namespace gz
     { \
       namespace \
       { \
-        struct ExecuteWhenLoadingLibrary##UniqueID \
+        ::gz::plugin::Info makeInfo##UniqueID() \
         { \
-          ExecuteWhenLoadingLibrary##UniqueID() \
-          { \
-            ::gz::plugin::detail::Registrar<PluginClass>::RegisterAlias( \
-                __VA_ARGS__); \
-          } \
-        }; \
+          return ::gz::plugin::detail::Registrar<PluginClass>::MakeAliasInfo( \
+              __VA_ARGS__); \
+        } \
+  \
+        DETAIL_GZ_PLUGIN_REGISTRATION(UniqueID, &makeInfo##UniqueID) \
   \
-        static ExecuteWhenLoadingLibrary##UniqueID execute##UniqueID; \
+        DETAIL_GZ_PLUGIN_METADATA(UniqueID, \
+          ::gz::plugin::detail::AliasMetadata< \
+            sizeof(#__VA_ARGS__), PluginClass>::Make(#__VA_ARGS__)) \
       } /* namespace */ \
     } \
   }
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+
+#include "../plugins/DummyPlugins.hh"
+#include "../plugins/TemplatedPlugins.hh"
+
+/////////////////////////////////////////////////
+TEST(ConcurrentLoader, ReadersWhileLoadingAndForgetting)
+{
+  gz::plugin::Loader loader;
+  ASSERT_EQ(3u, loader.LoadLib(GzDummyPlugins_LIB).size());
+
+  std::atomic<bool> done(false);
+
+  // One thread keeps loading and forgetting a second library, while all the
+  // other threads use the plugins of both libraries.
+  std::thread writer([&]()
+  {
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      EXPECT_EQ(4u, loader.LoadLib(GzTemplatedPlugins_LIB).size());
+      EXPECT_TRUE(loader.ForgetLibrary(GzTemplatedPlugins_LIB));
+    }
+    done = true;
+  });
+
+  const std::size_t numReaders =
+      std::max(4u, std::thread::hardware_concurrency());
+
+  std::vector<std::thread> readers;
+  for (std::size_t r = 0; r < numReaders; ++r)
+  {
+    readers.emplace_back([&]()
+    {
+      while (!done)
+      {
+        gz::plugin::PluginPtr plugin =
+            loader.Instantiate("test::util::DummySinglePlugin");
+        ASSERT_TRUE(plugin);
+        auto *nameBase = plugin->QueryInterface<test::util::DummyNameBase>();
+        ASSERT_NE(nullptr, nameBase);
+        EXPECT_EQ("DummySinglePlugin", nameBase->MyNameIs());
+
+        EXPECT_EQ("test::util::DummyMultiPlugin", loader.LookupPlugin("Foo"));
+        EXPECT_EQ(3u, loader.PluginsImplementing<
+                  test::util::DummyNameBase>().size());
+
+        // The second library might be loaded or forgotten at any moment, but
+        // a plugin that we get from it must stay usable.
+        gz::plugin::PluginPtr templated =
+            loader.Instantiate("test::plugins::DoubleTemplatePlugin");
+        if (templated)
+        {
+          auto *setter = templated->QueryInterface<
+              test::plugins::TemplatedSetInterface<int>>();
+          auto *getter = templated->QueryInterface<
+              test::plugins::TemplatedGetInterface<int>>();
+          ASSERT_NE(nullptr, setter);
+          ASSERT_NE(nullptr, getter);
+          setter->Set(7);
+          EXPECT_EQ(7, getter->Get());
+        }
+
+        const std::size_t numPlugins = loader.AllPlugins().size();
+        EXPECT_TRUE(numPlugins == 3u || numPlugins == 7u);
+      }
+    });
+  }
+
+  writer.join();
+  for (std::thread &reader : readers)
+    reader.join();
+
+  EXPECT_EQ(3u, loader.AllPlugins().size());
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentLoader, LoadFromSeveralThreads)
+{
+  gz::plugin::Loader loader;
+
+  const std::vector<std::string> libraries = {
+    GzDummyPlugins_LIB,
+    GzTemplatedPlugins_LIB,
+    GzFactoryPlugins_LIB};
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < 4 * libraries.size(); ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      EXPECT_FALSE(loader.LoadLib(libraries[i % libraries.size()]).empty());
+    });
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  gz::plugin::Loader serial;
+  for (const std::string &library : libraries)
+    serial.LoadLib(library);
+
+  EXPECT_EQ(serial.AllPlugins(), loader.AllPlugins());
+
+  for (const std::string &library : libraries)
+    EXPECT_TRUE(loader.ForgetLibrary(library));
+
+  EXPECT_TRUE(loader.AllPlugins().empty());
+}
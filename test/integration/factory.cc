@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gz/plugin/Factory.hh>
 #include <gz/plugin/Loader.hh>
 
@@ -242,3 +248,178 @@ TEST(Factory, LibraryManagement)
   // With the reference counts deleted, the library should automatically unload.
   CHECK_FOR_LIBRARY(libraryPath, false);
 }
+
+/////////////////////////////////////////////////
+TEST(Factory, Cached)
+{
+  const std::string &libraryPath = GzFactoryPlugins_LIB;
+
+  {
+    gz::plugin::Loader pl;
+    pl.LoadLib(libraryPath);
+
+    std::shared_ptr<SomeObjectFactory> factory =
+        pl.Factory<SomeObjectFactory>("test::util::SomeObjectAddTwo");
+    ASSERT_NE(nullptr, factory);
+
+    // The same factory is handed out for the name and every alias
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "test::util::SomeObjectAddTwo"));
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "This factory has an alias"));
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "and also a second alias"));
+
+    // A different plugin gets its own factory
+    EXPECT_NE(factory, pl.Factory<SomeObjectFactory>(
+                "test::util::SomeObjectForward"));
+
+    // Instantiate still creates a separate instance
+    EXPECT_NE(factory, pl.Instantiate("test::util::SomeObjectAddTwo")
+              ->QueryInterfaceSharedPtr<SomeObjectFactory>());
+
+    // Failed lookups are not cached
+    EXPECT_EQ(nullptr, pl.Factory<SomeObjectFactory>("not a real factory"));
+    EXPECT_EQ(nullptr, pl.Factory<SomeObjectFactory>("not a real factory"));
+
+    // Loading a library whose plugins do not take over any of the names or
+    // aliases keeps the cached factories
+    EXPECT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "This factory has an alias"));
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "test::util::SomeObjectAddTwo"));
+    EXPECT_TRUE(pl.ForgetLibrary(GzDummyPlugins_LIB));
+
+    // Once the library is forgotten, its factories are no longer available,
+    // but the ones that are still being used keep working.
+    EXPECT_TRUE(pl.ForgetLibrary(libraryPath));
+    EXPECT_EQ(nullptr, pl.Factory<SomeObjectFactory>(
+                "test::util::SomeObjectAddTwo"));
+    CHECK_FOR_LIBRARY(libraryPath, true);
+
+    auto object = factory->Construct(1, 2.0);
+    ASSERT_NE(nullptr, object);
+    EXPECT_EQ(3, object->someInt);
+
+    object.reset();
+    factory.reset();
+    CHECK_FOR_LIBRARY(libraryPath, false);
+
+    // Loading the library again makes a new factory
+    pl.LoadLib(libraryPath);
+    factory = pl.Factory<SomeObjectFactory>("This factory has an alias");
+    ASSERT_NE(nullptr, factory);
+    EXPECT_EQ(factory, pl.Factory<SomeObjectFactory>(
+                "test::util::SomeObjectAddTwo"));
+  }
+
+  // The Loader lets go of its cached factories when it is destroyed
+  CHECK_FOR_LIBRARY(libraryPath, false);
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, LostProductReaper)
+{
+  const std::string &libraryPath = GzFactoryPlugins_LIB;
+
+  const gz::plugin::LostProductStats before =
+      gz::plugin::LostProductStatistics();
+  EXPECT_EQ(0u, before.depth);
+
+  {
+    std::unique_ptr<SomeObject> obj;
+
+    {
+      gz::plugin::Loader pl;
+      pl.LoadLib(libraryPath);
+
+      auto factory = pl.Factory<SomeObjectFactory>(
+            "test::util::SomeObjectAddTwo");
+      ASSERT_NE(nullptr, factory);
+
+      obj = std::unique_ptr<SomeObject>(factory->Construct(3, 4.0).release());
+      ASSERT_NE(nullptr, obj);
+    }
+
+    CHECK_FOR_LIBRARY(libraryPath, true);
+  }
+
+  gz::plugin::LostProductStats stats = gz::plugin::LostProductStatistics();
+  EXPECT_EQ(1u, stats.depth);
+  EXPECT_EQ(before.lost + 1, stats.lost);
+  EXPECT_EQ(before.reclaimed, stats.reclaimed);
+
+  // The reaper cleans up the lost product without being asked to. A new
+  // schedule takes effect right away, even while the reaper is waiting out a
+  // long period.
+  gz::plugin::StartLostProductReaper(std::chrono::hours(1));
+  gz::plugin::StartLostProductReaper(std::chrono::milliseconds(1));
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (gz::plugin::LostProductCount() > 0
+         && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  gz::plugin::StopLostProductReaper();
+
+  stats = gz::plugin::LostProductStatistics();
+  EXPECT_EQ(0u, stats.depth);
+  EXPECT_EQ(before.reclaimed + 1, stats.reclaimed);
+  EXPECT_GT(stats.lastReclaimLatency.count(), 0);
+  EXPECT_GE(stats.maxReclaimLatency, stats.lastReclaimLatency);
+
+  CHECK_FOR_LIBRARY(libraryPath, false);
+
+  // Stopping again does nothing
+  gz::plugin::StopLostProductReaper();
+}
+
+/////////////////////////////////////////////////
+TEST(Factory, RecycleProducts)
+{
+  const std::string &libraryPath = GzFactoryPlugins_LIB;
+
+  {
+    gz::plugin::Loader pl;
+    pl.LoadLib(libraryPath);
+
+    // The Loader hands out the same factory every time, so its recycled
+    // products are shared by everyone who asks for it.
+    pl.Factory<SomeObjectFactory>("test::util::SomeObjectAddTwo")
+        ->RecycleProducts(4);
+
+    std::vector<SomeObjectFactory::ProductPtrType> objects =
+        pl.Factory<SomeObjectFactory>("test::util::SomeObjectAddTwo")
+          ->ConstructMany(3, 1, 2.0);
+    ASSERT_EQ(3u, objects.size());
+    for (const auto &object : objects)
+    {
+      ASSERT_NE(nullptr, object);
+      EXPECT_EQ(3, object->someInt);
+      EXPECT_DOUBLE_EQ(4.0, object->someDouble);
+    }
+
+    objects.clear();
+
+    auto factory = pl.Factory<SomeObjectFactory>("This factory has an alias");
+    EXPECT_EQ(3u, factory->RecycledProductCount());
+
+    auto object = factory->Construct(5, 6.0);
+    ASSERT_NE(nullptr, object);
+    EXPECT_EQ(7, object->someInt);
+    EXPECT_EQ(2u, factory->RecycledProductCount());
+
+    // A recycled product keeps the library loaded just like any other
+    factory.reset();
+    EXPECT_TRUE(pl.ForgetLibrary(libraryPath));
+    CHECK_FOR_LIBRARY(libraryPath, true);
+
+    object.reset();
+  }
+
+  CHECK_FOR_LIBRARY(libraryPath, false);
+}
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/EnablePluginFromThis.hh>
+#include <gz/plugin/Loader.hh>
+#include <gz/plugin/PluginPtr.hh>
+#include <gz/plugin/RegisterStatic.hh>
+#include <gz/plugin/Resettable.hh>
+
+#include "../plugins/DummyPlugins.hh"
+
+namespace test
+{
+namespace pool
+{
+/// \brief Number of PooledPlugin instances that were constructed
+static std::atomic<int> constructed{0};
+
+/// \brief Number of PooledPlugin instances that were destroyed
+static std::atomic<int> destroyed{0};
+
+/// \brief Number of calls to PooledPlugin::Reset()
+static std::atomic<int> resets{0};
+
+/// \brief When true, PooledPlugin::Reset() refuses to reset the instance
+static std::atomic<bool> refuseReset{false};
+
+/// \brief When true, PooledPlugin::Reset() throws, which it must not do
+static std::atomic<bool> throwInReset{false};
+
+/// \brief A plugin that can be reused
+class PooledPlugin
+    : public util::DummyIntBase,
+      public util::DummySetterBase,
+      public gz::plugin::Resettable
+{
+  public: PooledPlugin()
+  {
+    ++constructed;
+  }
+
+  public: ~PooledPlugin() override
+  {
+    ++destroyed;
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return this->value;
+  }
+
+  public: void SetName(const std::string &) override
+  {
+    // Do nothing
+  }
+
+  public: void SetDoubleValue(const double) override
+  {
+    // Do nothing
+  }
+
+  public: void SetIntegerValue(const int _value) override
+  {
+    this->value = _value;
+  }
+
+  public: bool Reset() override
+  {
+    ++resets;
+    if (throwInReset)
+      throw std::runtime_error("PooledPlugin could not be reset");
+
+    this->value = 3;
+    return !refuseReset;
+  }
+
+  public: int value = 3;
+};
+
+/// \brief Number of PlainPlugin instances that were destroyed
+static std::atomic<int> plainDestroyed{0};
+
+/// \brief A plugin that cannot be reused
+class PlainPlugin : public util::DummyIntBase
+{
+  public: ~PlainPlugin() override
+  {
+    ++plainDestroyed;
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return 17;
+  }
+};
+}
+}
+
+GZ_ADD_STATIC_PLUGIN(
+    test::pool::PooledPlugin,
+    test::util::DummyIntBase,
+    test::util::DummySetterBase,
+    gz::plugin::Resettable)
+GZ_ADD_STATIC_PLUGIN(test::pool::PlainPlugin, test::util::DummyIntBase)
+
+using test::pool::constructed;
+using test::pool::destroyed;
+using test::pool::resets;
+
+/////////////////////////////////////////////////
+TEST(InstancePool, WarmHitMissAndRecycle)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+
+  EXPECT_EQ(0u, pl.WarmPool("not a plugin", 4));
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).capacity);
+
+  const int constructedBefore = constructed;
+  const int destroyedBefore = destroyed;
+  EXPECT_EQ(2u, pl.WarmPool(name, 2));
+  EXPECT_EQ(constructedBefore + 2, constructed);
+
+  gz::plugin::Loader::PoolStats stats = pl.PoolStatsOf(name);
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(2u, stats.idle);
+  EXPECT_EQ(2u, stats.capacity);
+
+  {
+    gz::plugin::PluginPtr first = pl.Instantiate(name);
+    gz::plugin::PluginPtr second = pl.Instantiate(name);
+    gz::plugin::PluginPtr third = pl.Instantiate(name);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    ASSERT_TRUE(third);
+    EXPECT_NE(first, second);
+    EXPECT_NE(second, third);
+
+    // Only the third instance had to be constructed
+    EXPECT_EQ(constructedBefore + 3, constructed);
+
+    stats = pl.PoolStatsOf(name);
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(0u, stats.idle);
+
+    first->QueryInterface<test::util::DummySetterBase>()->SetIntegerValue(42);
+    EXPECT_EQ(42,
+      first->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+  }
+
+  // Two of the released instances were reset and taken back, and the pool
+  // had no room for the last one.
+  stats = pl.PoolStatsOf(name);
+  EXPECT_EQ(2u, stats.recycled);
+  EXPECT_EQ(2u, stats.idle);
+  EXPECT_EQ(destroyedBefore + 1, destroyed);
+
+  // A recycled instance starts out in its reset state
+  const int constructedAfter = constructed;
+  gz::plugin::PluginPtr reused = pl.Instantiate(name);
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(3,
+    reused->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+  EXPECT_EQ(constructedAfter, constructed);
+  EXPECT_EQ(3u, pl.PoolStatsOf(name).hits);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, InterfacesKeepInstanceLeased)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(1u, pl.WarmPool(name, 1));
+
+  std::shared_ptr<test::util::DummyIntBase> interface;
+  {
+    gz::plugin::PluginPtr plugin = pl.Instantiate(name);
+    interface = plugin->QueryInterfaceSharedPtr<test::util::DummyIntBase>();
+    ASSERT_NE(nullptr, interface);
+  }
+
+  // The instance is still in use through its interface
+  const int resetsBefore = resets;
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).idle);
+  EXPECT_EQ(3, interface->MyIntegerValueIs());
+
+  interface.reset();
+  EXPECT_EQ(resetsBefore + 1, resets);
+  EXPECT_EQ(1u, pl.PoolStatsOf(name).idle);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, RefusedResetDeletesInstance)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(1u, pl.WarmPool(name, 1));
+
+  const int destroyedBefore = destroyed;
+  test::pool::refuseReset = true;
+  pl.Instantiate(name);
+  test::pool::refuseReset = false;
+
+  EXPECT_EQ(destroyedBefore + 1, destroyed);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).idle);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).recycled);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, ThrowingResetDeletesInstance)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(1u, pl.WarmPool(name, 1));
+
+  const int destroyedBefore = destroyed;
+  test::pool::throwInReset = true;
+  EXPECT_NO_THROW(pl.Instantiate(name));
+  test::pool::throwInReset = false;
+
+  EXPECT_EQ(destroyedBefore + 1, destroyed);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).idle);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).recycled);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, NotResettable)
+{
+  const std::string name = "test::pool::PlainPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(3u, pl.WarmPool(name, 3));
+
+  const int destroyedBefore = test::pool::plainDestroyed;
+  {
+    gz::plugin::PluginPtr plugin = pl.Instantiate(name);
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(17,
+      plugin->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+  }
+
+  // Instances that cannot be reset are never taken back
+  EXPECT_EQ(destroyedBefore + 1, test::pool::plainDestroyed);
+
+  const gz::plugin::Loader::PoolStats stats = pl.PoolStatsOf(name);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(0u, stats.recycled);
+  EXPECT_EQ(2u, stats.idle);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, Trim)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(5u, pl.WarmPool(name, 5));
+  ASSERT_EQ(2u, pl.WarmPool("test::pool::PlainPlugin", 2));
+
+  const int destroyedBefore = destroyed;
+  EXPECT_EQ(3u, pl.TrimPool(name, 2));
+  EXPECT_EQ(destroyedBefore + 3, destroyed);
+  EXPECT_EQ(0u, pl.TrimPool(name, 2));
+
+  // Trimming does not change the capacity
+  gz::plugin::Loader::PoolStats stats = pl.PoolStatsOf(name);
+  EXPECT_EQ(2u, stats.idle);
+  EXPECT_EQ(5u, stats.capacity);
+
+  EXPECT_EQ(4u, pl.TrimPools());
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).idle);
+  EXPECT_EQ(0u, pl.PoolStatsOf("test::pool::PlainPlugin").idle);
+
+  // Shrinking the capacity deletes the instances that no longer fit
+  ASSERT_EQ(5u, pl.WarmPool(name, 5));
+  EXPECT_EQ(1u, pl.WarmPool(name, 1));
+
+  // A capacity of zero removes the pool
+  const int destroyedBeforeRemoval = destroyed;
+  EXPECT_EQ(0u, pl.WarmPool(name, 0));
+  EXPECT_EQ(destroyedBeforeRemoval + 1, destroyed);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).capacity);
+
+  const int constructedBefore = constructed;
+  pl.Instantiate(name);
+  EXPECT_EQ(constructedBefore + 1, constructed);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).misses);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, ResolvedPlugin)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+
+  // A plugin that was resolved before the pool existed does not use it
+  const gz::plugin::Loader::ResolvedPlugin early = pl.Resolve(name);
+  ASSERT_EQ(1u, pl.WarmPool(name, 1));
+  const gz::plugin::Loader::ResolvedPlugin late = pl.Resolve(name);
+
+  EXPECT_TRUE(early.Instantiate());
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).hits);
+
+  EXPECT_TRUE(late.Instantiate());
+  EXPECT_EQ(1u, pl.PoolStatsOf(name).hits);
+
+  // Instances made from a memory resource never come from the pool
+  EXPECT_TRUE(late.Instantiate(std::pmr::new_delete_resource()));
+  EXPECT_EQ(1u, pl.PoolStatsOf(name).hits);
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).misses);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, OutlivesLoader)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::PluginPtr plugin;
+  const int destroyedBefore = destroyed;
+  {
+    gz::plugin::Loader pl;
+    ASSERT_EQ(2u, pl.WarmPool(name, 2));
+    plugin = pl.Instantiate(name);
+  }
+
+  // The instance that was still ready went away with the Loader
+  EXPECT_EQ(destroyedBefore + 1, destroyed);
+
+  // The instance that was handed out gets deleted like any other instance
+  ASSERT_TRUE(plugin);
+  plugin.Clear();
+  EXPECT_EQ(destroyedBefore + 2, destroyed);
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, ForgetLibrary)
+{
+  const std::string &path = GzDummyPlugins_LIB;
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(path).empty());
+
+  // The pool of a plugin may be looked up by any of its names, and it also
+  // serves plugins that use EnablePluginFromThis.
+  ASSERT_EQ(2u, pl.WarmPool("Foo", 2));
+  EXPECT_EQ(2u, pl.PoolStatsOf("test::util::DummyMultiPlugin").idle);
+
+  gz::plugin::PluginPtr plugin = pl.Instantiate("test::util::DummyMultiPlugin");
+  ASSERT_TRUE(plugin);
+  EXPECT_EQ(1u, pl.PoolStatsOf("Foo").hits);
+
+  auto *fromThis = plugin->QueryInterface<gz::plugin::EnablePluginFromThis>();
+  ASSERT_NE(nullptr, fromThis);
+  EXPECT_EQ(plugin, fromThis->PluginFromThis());
+
+  EXPECT_TRUE(pl.ForgetLibrary(path));
+  EXPECT_EQ(0u, pl.PoolStatsOf("test::util::DummyMultiPlugin").capacity);
+
+  // The instance that was handed out keeps working after its pool is gone
+  EXPECT_EQ(5,
+    plugin->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+}
+
+/////////////////////////////////////////////////
+TEST(InstancePool, Concurrent)
+{
+  const std::string name = "test::pool::PooledPlugin";
+  gz::plugin::Loader pl;
+  ASSERT_EQ(4u, pl.WarmPool(name, 4));
+
+  const int threads = 8;
+  const int iterations = 200;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&]()
+    {
+      for (int i = 0; i < iterations; ++i)
+      {
+        gz::plugin::PluginPtr plugin = pl.Instantiate(name);
+        ASSERT_TRUE(plugin);
+        EXPECT_EQ(3, plugin->QueryInterface<test::util::DummyIntBase>()
+                  ->MyIntegerValueIs());
+        plugin->QueryInterface<test::util::DummySetterBase>()
+            ->SetIntegerValue(i);
+      }
+    });
+  }
+
+  for (std::thread &worker : workers)
+    worker.join();
+
+  const gz::plugin::Loader::PoolStats stats = pl.PoolStatsOf(name);
+  EXPECT_EQ(static_cast<std::size_t>(threads * iterations),
+            stats.hits + stats.misses);
+
+  // An instance only gets deleted while the pool is full, so the pool is
+  // full again once every instance has been released.
+  EXPECT_EQ(4u, stats.idle);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/plugin/ManifestCache.hh>
+
+#include "../plugins/DummyPlugins.hh"
+#include "utils.hh"
+
+namespace fs = std::filesystem;
+
+/////////////////////////////////////////////////
+class LazyLoading : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    this->directory = fs::temp_directory_path() /
+        ("gz_plugin_lazy_" + std::string(
+          ::testing::UnitTest::GetInstance()->current_test_info()->name()));
+    fs::remove_all(this->directory);
+    fs::create_directories(this->directory);
+
+    // Use a private copy of the library so that we can tell whether the
+    // loader is the one that has it loaded.
+    this->library = (this->directory / "libGzDummyPluginsLazy.so").string();
+    fs::copy_file(GzDummyPlugins_LIB, this->library);
+
+    this->cache = std::make_shared<gz::plugin::ManifestCache>(
+          (this->directory / "manifest.txt").string());
+
+    // Fill in the cache for the library
+    gz::plugin::Loader loader;
+    loader.SetManifestCache(this->cache);
+    EXPECT_EQ(3u, loader.LoadLib(this->library).size());
+  }
+
+  protected: void TearDown() override
+  {
+    this->cache.reset();
+    fs::remove_all(this->directory);
+  }
+
+  protected: fs::path directory;
+  protected: std::string library;
+  protected: std::shared_ptr<gz::plugin::ManifestCache> cache;
+};
+
+/////////////////////////////////////////////////
+TEST_F(LazyLoading, LoadOnFirstInstantiate)
+{
+  CHECK_FOR_LIBRARY(this->library, false);
+
+  gz::plugin::PluginPtr plugin;
+  {
+    gz::plugin::Loader loader;
+    loader.SetManifestCache(this->cache);
+
+    EXPECT_EQ(3u, loader.DiscoverLib(this->library).size());
+    CHECK_FOR_LIBRARY(this->library, false);
+
+    EXPECT_EQ(3u, loader.PluginsImplementing<test::util::DummyNameBase>()
+                    .size());
+    CHECK_FOR_LIBRARY(this->library, false);
+
+    plugin = loader.Instantiate("test::util::DummyMultiPlugin");
+    ASSERT_TRUE(plugin);
+    CHECK_FOR_LIBRARY(this->library, true);
+
+    test::util::DummyIntBase *base =
+        plugin->QueryInterface<test::util::DummyIntBase>();
+    ASSERT_NE(nullptr, base);
+    EXPECT_EQ(5, base->MyIntegerValueIs());
+
+    // The other plugins of the library use the same handle
+    EXPECT_TRUE(loader.Instantiate("test::util::DummySinglePlugin"));
+  }
+
+  // The plugin keeps the library loaded after the loader is gone
+  CHECK_FOR_LIBRARY(this->library, true);
+  plugin = nullptr;
+  CHECK_FOR_LIBRARY(this->library, false);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LazyLoading, ConcurrentFirstInstantiate)
+{
+  gz::plugin::Loader loader;
+  loader.SetManifestCache(this->cache);
+  EXPECT_EQ(3u, loader.DiscoverLib(this->library).size());
+  CHECK_FOR_LIBRARY(this->library, false);
+
+  const std::vector<std::string> names = {
+    "test::util::DummyMultiPlugin",
+    "test::util::DummySinglePlugin",
+    "Foo"
+  };
+
+  constexpr std::size_t numThreads = 8;
+  std::vector<gz::plugin::PluginPtr> plugins(numThreads);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      plugins[i] = loader.Instantiate(names[i % names.size()]);
+    });
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (const gz::plugin::PluginPtr &plugin : plugins)
+  {
+    ASSERT_TRUE(plugin);
+    EXPECT_NE(nullptr, plugin->QueryInterface<test::util::DummyNameBase>());
+  }
+
+  CHECK_FOR_LIBRARY(this->library, true);
+
+  plugins.clear();
+  EXPECT_TRUE(loader.ForgetLibrary(this->library));
+  EXPECT_TRUE(loader.AllPlugins().empty());
+  CHECK_FOR_LIBRARY(this->library, false);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LazyLoading, MissingLibrary)
+{
+  gz::plugin::Loader loader;
+  loader.SetManifestCache(this->cache);
+  EXPECT_EQ(3u, loader.DiscoverLib(this->library).size());
+
+  // Discovery trusts the manifest, so a library that disappears afterwards
+  // only gets noticed once a plugin is instantiated.
+  fs::remove(this->library);
+  EXPECT_FALSE(loader.Instantiate("test::util::DummyMultiPlugin"));
+  EXPECT_FALSE(loader.Instantiate("test::util::DummySinglePlugin"));
+
+  EXPECT_TRUE(loader.ForgetLibraryOfPlugin("test::util::DummySinglePlugin"));
+  EXPECT_TRUE(loader.AllPlugins().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LazyLoadingWithoutCache, EmbeddedMetadata)
+{
+  // The registration macros embed a description of the plugins into the
+  // library, so it does not need to be loaded to discover them.
+  gz::plugin::Loader loader;
+  EXPECT_EQ(3u, loader.DiscoverLib(GzDummyPlugins_LIB).size());
+  CHECK_FOR_LIBRARY(std::string(GzDummyPlugins_LIB), false);
+
+  EXPECT_TRUE(loader.Instantiate("Foo"));
+  CHECK_FOR_LIBRARY(std::string(GzDummyPlugins_LIB), true);
+
+  EXPECT_TRUE(loader.ForgetLibrary(GzDummyPlugins_LIB));
+  CHECK_FOR_LIBRARY(std::string(GzDummyPlugins_LIB), false);
+
+  // The aliases of factories are not string literals, so the library of a
+  // factory needs to be loaded to discover its plugins.
+  EXPECT_FALSE(loader.DiscoverLib(GzFactoryPlugins_LIB).empty());
+  CHECK_FOR_LIBRARY(std::string(GzFactoryPlugins_LIB), true);
+}
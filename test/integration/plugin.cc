@@ -21,12 +21,17 @@
 #define GZ_UNITTEST_SPECIALIZED_PLUGIN_ACCESS
 
 #include <gtest/gtest.h>
+#include <dlfcn.h>
+#include <set>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <iostream>
 #include "gz/plugin/Loader.hh"
 #include "gz/plugin/PluginPtr.hh"
 #include "gz/plugin/SpecializedPluginPtr.hh"
+#include "gz/plugin/detail/Common.hh"
+#include "gz/plugin/detail/PluginDescriptor.hh"
 
 #include "../plugins/DummyPlugins.hh"
 #include "utils.hh"
@@ -50,6 +55,133 @@ TEST(Loader, LoadBadPlugins)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Loader, LoadInfoMapLibrary)
+{
+  // Libraries that were built against version 1 of the Info API can still be
+  // loaded, except for their factories.
+  gz::plugin::Loader pl;
+  const std::unordered_set<std::string> pluginNames =
+      pl.LoadLib(GzInfoMapPlugins_LIB);
+  ASSERT_EQ(1u, pluginNames.size());
+  EXPECT_EQ(1u, pluginNames.count("test::util::InfoMapPlugin"));
+  EXPECT_EQ("test::util::InfoMapPlugin", pl.LookupPlugin("InfoMapAlias"));
+  EXPECT_EQ(1u, pl.PluginsImplementing<test::util::DummyNameBase>().size());
+
+  gz::plugin::PluginPtr plugin = pl.Instantiate("InfoMapAlias");
+  ASSERT_TRUE(plugin);
+  EXPECT_EQ(11,
+    plugin->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+  EXPECT_EQ("InfoMapPlugin",
+    plugin->QueryInterface<test::util::DummyNameBase>()->MyNameIs());
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, PluginHookVersions)
+{
+  void *dlHandle = dlopen(GzDummyPlugins_LIB, RTLD_LAZY | RTLD_LOCAL);
+  ASSERT_NE(nullptr, dlHandle);
+
+  using HookSignature = void(*)(const void *, const void ** const,
+                                int *, std::size_t *, std::size_t *);
+  const auto hook =
+      reinterpret_cast<HookSignature>(dlsym(dlHandle, "GzPluginHook"));
+  ASSERT_NE(nullptr, hook);
+
+  // A Loader that asks for a newer version is told to use the current one
+  int version = gz::plugin::INFO_API_VERSION + 1;
+  std::size_t size = 0;
+  std::size_t alignment = 0;
+  const void *output = nullptr;
+  hook(nullptr, &output, &version, &size, &alignment);
+  EXPECT_EQ(gz::plugin::INFO_API_VERSION, version);
+  EXPECT_EQ(sizeof(gz::plugin::detail::PluginDescriptor), size);
+  EXPECT_EQ(alignof(gz::plugin::detail::PluginDescriptor), alignment);
+  EXPECT_EQ(nullptr, output);
+
+  const gz::plugin::detail::PluginDescriptorTable *table = nullptr;
+  hook(nullptr, reinterpret_cast<const void**>(&table),
+       &version, &size, &alignment);
+  ASSERT_NE(nullptr, table);
+
+  // Loaders that were built against version 1 still get the InfoMap
+  version = gz::plugin::INFO_MAP_API_VERSION;
+  size = sizeof(gz::plugin::Info);
+  alignment = alignof(gz::plugin::Info);
+  const gz::plugin::InfoMap *infoMap = nullptr;
+  hook(nullptr, reinterpret_cast<const void**>(&infoMap),
+       &version, &size, &alignment);
+  EXPECT_EQ(gz::plugin::INFO_MAP_API_VERSION, version);
+  ASSERT_NE(nullptr, infoMap);
+
+  // Both describe the same plugins
+  ASSERT_EQ(infoMap->size(), table->count);
+  for (std::size_t i = 0; i < table->count; ++i)
+  {
+    const gz::plugin::detail::PluginDescriptor &plugin = table->plugins[i];
+    const auto it = infoMap->find(
+        std::string(plugin.name.data, plugin.name.size));
+    ASSERT_NE(infoMap->end(), it);
+    const gz::plugin::Info &info = it->second;
+
+    std::set<std::string> aliases;
+    for (std::size_t a = 0; a < plugin.aliasCount; ++a)
+      aliases.emplace(plugin.aliases[a].data, plugin.aliases[a].size);
+    EXPECT_EQ(info.aliases, aliases);
+
+    ASSERT_EQ(info.interfaces.size(), plugin.interfaceCount);
+    for (std::size_t n = 0; n < plugin.interfaceCount; ++n)
+    {
+      const gz::plugin::detail::InterfaceDescriptor &interface =
+          plugin.interfaces[n];
+      EXPECT_EQ(1u, info.interfaces.count(
+          std::string(interface.name.data, interface.name.size)));
+    }
+
+    EXPECT_NE(nullptr, plugin.deleter);
+    EXPECT_TRUE(plugin.describe || plugin.create);
+  }
+
+  dlclose(dlHandle);
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, DeferredRegistration)
+{
+  const std::string libraryPath = GzFactoryPlugins_LIB;
+  CHECK_FOR_LIBRARY(libraryPath, false);
+
+  void *dlHandle = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+  ASSERT_NE(nullptr, dlHandle);
+
+  using CounterSignature = int(*)();
+  const auto aliasEvaluations = reinterpret_cast<CounterSignature>(
+        dlsym(dlHandle, "GzFactoryPluginsAliasEvaluations"));
+  ASSERT_NE(nullptr, aliasEvaluations);
+
+#ifdef __ELF__
+  // Loading the library does not run its registrations
+  EXPECT_EQ(0, aliasEvaluations());
+#endif
+
+  {
+    gz::plugin::Loader pl;
+    EXPECT_FALSE(pl.LoadLib(libraryPath).empty());
+    EXPECT_EQ(1, aliasEvaluations());
+
+    EXPECT_NE(std::string::npos,
+              pl.LookupPlugin("This factory has a counted alias").find(
+                "test::util::SomeObjectForward"));
+
+    // Asking the library again does not register its plugins again
+    gz::plugin::Loader other;
+    EXPECT_FALSE(other.LoadLib(libraryPath).empty());
+    EXPECT_EQ(1, aliasEvaluations());
+  }
+
+  dlclose(dlHandle);
+}
+
 /////////////////////////////////////////////////
 TEST(Loader, LoadExistingLibrary)
 {
@@ -172,6 +304,118 @@ TEST(Loader, LoadExistingLibrary)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Check that two loaders know about exactly the same plugins
+void ExpectSameRegistry(
+    const gz::plugin::Loader &_expected,
+    const gz::plugin::Loader &_actual)
+{
+  EXPECT_EQ(_expected.AllPlugins(), _actual.AllPlugins());
+  EXPECT_EQ(_expected.InterfacesImplemented(), _actual.InterfacesImplemented());
+
+  for (const std::string &plugin : _expected.AllPlugins())
+  {
+    EXPECT_EQ(_expected.AliasesOfPlugin(plugin),
+              _actual.AliasesOfPlugin(plugin));
+
+    for (const std::string &alias : _expected.AliasesOfPlugin(plugin))
+    {
+      EXPECT_EQ(_expected.PluginsWithAlias(alias),
+                _actual.PluginsWithAlias(alias));
+    }
+  }
+
+  for (const std::string &interface : _expected.InterfacesImplemented())
+  {
+    EXPECT_EQ(_expected.PluginsImplementing(interface),
+              _actual.PluginsImplementing(interface));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, LoadLibs)
+{
+  const std::vector<std::string> libraries = {
+    GzDummyPlugins_LIB,
+    GzBadPluginAPIVersionOld_LIB,
+    "/path/to/libDoesNotExist.so",
+    GzFactoryPlugins_LIB,
+    GzTemplatedPlugins_LIB,
+    GzDummyPlugins_LIB,
+    GzInstanceCounter_LIB};
+
+  gz::plugin::Loader serial;
+  std::vector<std::unordered_set<std::string>> serialResults;
+  for (const std::string &library : libraries)
+    serialResults.push_back(serial.LoadLib(library));
+
+  gz::plugin::Loader batch;
+  const std::vector<std::unordered_set<std::string>> batchResults =
+      batch.LoadLibs(libraries);
+
+  ASSERT_EQ(libraries.size(), batchResults.size());
+  EXPECT_EQ(serialResults, batchResults);
+  EXPECT_EQ(3u, batchResults[0].size());
+  EXPECT_TRUE(batchResults[1].empty());
+  EXPECT_TRUE(batchResults[2].empty());
+  ExpectSameRegistry(serial, batch);
+
+  gz::plugin::Loader async;
+  std::future<std::vector<std::unordered_set<std::string>>> asyncResults =
+      async.LoadLibsAsync(libraries);
+  EXPECT_EQ(serialResults, asyncResults.get());
+  ExpectSameRegistry(serial, async);
+
+  gz::plugin::PluginPtr plugin =
+      batch.Instantiate("test::util::DummyMultiPlugin");
+  ASSERT_TRUE(plugin);
+  test::util::DummyIntBase *intBase =
+      plugin->QueryInterface<test::util::DummyIntBase>();
+  ASSERT_NE(nullptr, intBase);
+  EXPECT_EQ(5, intBase->MyIntegerValueIs());
+
+  // Forgetting a library that was loaded in a batch works like it does for a
+  // library that was loaded individually.
+  EXPECT_TRUE(batch.ForgetLibrary(GzFactoryPlugins_LIB));
+  EXPECT_TRUE(serial.ForgetLibrary(GzFactoryPlugins_LIB));
+  ExpectSameRegistry(serial, batch);
+
+  gz::plugin::Loader empty;
+  EXPECT_TRUE(empty.LoadLibs({}).empty());
+  EXPECT_TRUE(empty.AllPlugins().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, LoadLibsThrowing)
+{
+  const std::string throwingLib = GzBadPluginThrows_LIB;
+  const std::string templatedLib = GzTemplatedPlugins_LIB;
+  const std::string counterLib = GzInstanceCounter_LIB;
+
+  const std::vector<std::string> libraries = {
+    GzDummyPlugins_LIB,
+    "/path/to/libDoesNotExist.so",
+    throwingLib,
+    templatedLib,
+    counterLib};
+
+  gz::plugin::Loader loader;
+  EXPECT_THROW(loader.LoadLibs(libraries), std::runtime_error);
+
+  // The libraries before the one that threw are registered, while the others
+  // are neither registered nor left loaded by the workers that opened them.
+  EXPECT_EQ(3u, loader.AllPlugins().size());
+  EXPECT_TRUE(loader.InterfacesImplemented().count(
+                "test::util::DummyNameBase"));
+  CHECK_FOR_LIBRARY(throwingLib, false);
+  CHECK_FOR_LIBRARY(templatedLib, false);
+  CHECK_FOR_LIBRARY(counterLib, false);
+
+  EXPECT_THROW(loader.LoadLib(throwingLib), std::runtime_error);
+  CHECK_FOR_LIBRARY(throwingLib, false);
+}
+
+
 /////////////////////////////////////////////////
 class SomeInterface { };
 
@@ -181,6 +425,166 @@ using SomeSpecializedPluginPtr =
         test::util::DummyIntBase,
         test::util::DummySetterBase>;
 
+/////////////////////////////////////////////////
+TEST(Loader, Resolve)
+{
+  const std::string &path = GzDummyPlugins_LIB;
+
+  {
+    gz::plugin::Loader::ResolvedPlugin resolved;
+    EXPECT_FALSE(resolved);
+    EXPECT_FALSE(resolved.Instantiate());
+
+    gz::plugin::Loader pl;
+    pl.LoadLib(path);
+
+    EXPECT_FALSE(pl.Resolve("not a plugin"));
+
+    resolved = pl.Resolve("Foo");
+    ASSERT_TRUE(resolved);
+    EXPECT_EQ("test::util::DummyMultiPlugin", resolved.Name());
+
+    gz::plugin::PluginPtr first = resolved.Instantiate();
+    gz::plugin::PluginPtr second = resolved.Instantiate();
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_NE(first->QueryInterface<test::util::DummyNameBase>(),
+              second->QueryInterface<test::util::DummyNameBase>());
+
+    // EnablePluginFromThis gets set up just like with Loader::Instantiate(~)
+    auto *fromThis = first->QueryInterface<gz::plugin::EnablePluginFromThis>();
+    ASSERT_NE(nullptr, fromThis);
+    EXPECT_EQ(first, fromThis->PluginFromThis());
+
+    first.Clear();
+    second.Clear();
+
+    // The resolved plugin stays valid after its library is forgotten, and it
+    // keeps the library loaded.
+    EXPECT_TRUE(pl.ForgetLibrary(path));
+    EXPECT_FALSE(pl.Resolve("Foo"));
+    CHECK_FOR_LIBRARY(path, true);
+
+    gz::plugin::PluginPtr afterForget = resolved.Instantiate();
+    ASSERT_TRUE(afterForget);
+    EXPECT_EQ("DummyMultiPlugin", afterForget->QueryInterface<
+              test::util::DummyNameBase>()->MyNameIs());
+  }
+
+  CHECK_FOR_LIBRARY(path, false);
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateMany)
+{
+  const std::string &path = GzDummyPlugins_LIB;
+
+  {
+    gz::plugin::Loader pl;
+    pl.LoadLib(path);
+
+    EXPECT_TRUE(pl.InstantiateMany("not a plugin", 3).empty());
+    EXPECT_TRUE(pl.InstantiateMany("Foo", 0).empty());
+
+    std::vector<gz::plugin::PluginPtr> plugins = pl.InstantiateMany("Foo", 50);
+    ASSERT_EQ(50u, plugins.size());
+
+    std::vector<test::util::DummyIntBase*> instances;
+    for (const gz::plugin::PluginPtr &plugin : plugins)
+    {
+      ASSERT_TRUE(plugin);
+      instances.push_back(plugin->QueryInterface<test::util::DummyIntBase>());
+      ASSERT_NE(nullptr, instances.back());
+      EXPECT_EQ(5, instances.back()->MyIntegerValueIs());
+
+      auto *fromThis =
+          plugin->QueryInterface<gz::plugin::EnablePluginFromThis>();
+      ASSERT_NE(nullptr, fromThis);
+      EXPECT_EQ(plugin, fromThis->PluginFromThis());
+    }
+
+    // The instances are placed one after another
+    const std::ptrdiff_t stride = reinterpret_cast<char*>(instances[1])
+        - reinterpret_cast<char*>(instances[0]);
+    EXPECT_LT(0, stride);
+    for (std::size_t i = 1; i < instances.size(); ++i)
+    {
+      EXPECT_EQ(stride, reinterpret_cast<char*>(instances[i])
+                - reinterpret_cast<char*>(instances[i-1]));
+    }
+
+    // Each instance has its own state
+    plugins[3]->QueryInterface<test::util::DummySetterBase>()
+        ->SetIntegerValue(42);
+    EXPECT_EQ(42, instances[3]->MyIntegerValueIs());
+    EXPECT_EQ(5, instances[4]->MyIntegerValueIs());
+
+    std::vector<SomeSpecializedPluginPtr> specialized =
+        pl.InstantiateMany<SomeSpecializedPluginPtr>("Foo", 3);
+    ASSERT_EQ(3u, specialized.size());
+    for (const SomeSpecializedPluginPtr &plugin : specialized)
+    {
+      ASSERT_TRUE(plugin);
+      EXPECT_EQ(5, plugin->QueryInterface<test::util::DummyIntBase>()
+                ->MyIntegerValueIs());
+      EXPECT_EQ(nullptr, plugin->QueryInterface<SomeInterface>());
+    }
+    specialized.clear();
+
+    // The instances keep their library loaded until the last of them is gone
+    EXPECT_TRUE(pl.ForgetLibrary(path));
+    gz::plugin::PluginPtr last = plugins.back();
+    plugins.clear();
+    CHECK_FOR_LIBRARY(path, true);
+    EXPECT_EQ(5, last->QueryInterface<test::util::DummyIntBase>()
+              ->MyIntegerValueIs());
+  }
+
+  CHECK_FOR_LIBRARY(path, false);
+}
+
+namespace
+{
+  struct FirstBase { virtual ~FirstBase() = default; int first = 1; };
+  struct SecondBase { virtual ~SecondBase() = default; int second = 2; };
+  struct VirtualBase { virtual ~VirtualBase() = default; int shared = 3; };
+  struct LeftBase : virtual VirtualBase { };
+  struct RightBase : virtual VirtualBase { };
+
+  struct CastedPlugin : FirstBase, SecondBase, LeftBase, RightBase { };
+}
+
+/////////////////////////////////////////////////
+TEST(Info, InterfaceCasts)
+{
+  const gz::plugin::Info info = gz::plugin::detail::MakeInfo<
+      CastedPlugin, FirstBase, SecondBase, LeftBase, VirtualBase>();
+
+  CastedPlugin plugin;
+  const auto cast = [&](const std::type_info &_interface) -> void*
+  {
+    return info.interfaces.at(_interface.name())(&plugin);
+  };
+
+  EXPECT_EQ(static_cast<FirstBase*>(&plugin), cast(typeid(FirstBase)));
+  EXPECT_EQ(static_cast<SecondBase*>(&plugin), cast(typeid(SecondBase)));
+  EXPECT_EQ(static_cast<LeftBase*>(&plugin), cast(typeid(LeftBase)));
+  EXPECT_EQ(static_cast<VirtualBase*>(&plugin), cast(typeid(VirtualBase)));
+
+  // Only the virtual base needs a casting function. The other interfaces are
+  // stored as offsets.
+  const auto isOffset = [&](const std::type_info &_interface)
+  {
+    return nullptr != info.interfaces.at(_interface.name())
+        .target<gz::plugin::InterfaceOffset>();
+  };
+
+  EXPECT_TRUE(isOffset(typeid(FirstBase)));
+  EXPECT_TRUE(isOffset(typeid(SecondBase)));
+  EXPECT_TRUE(isOffset(typeid(LeftBase)));
+  EXPECT_FALSE(isOffset(typeid(VirtualBase)));
+}
+
 /////////////////////////////////////////////////
 TEST(SpecializedPluginPtr, Construction)
 {
@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/plugin/PluginPtr.hh>
+#include <gz/plugin/RegisterStatic.hh>
+#include <gz/plugin/SpecializedPluginPtr.hh>
+#include <gz/plugin/WeakPluginPtr.hh>
+
+#include "../plugins/DummyPlugins.hh"
+
+/////////////////////////////////////////////////
+/// \brief Number of calls to operator new so far
+static std::atomic<std::size_t> allocations{0};
+
+/////////////////////////////////////////////////
+/// \brief Allocate memory for the replaced operator new and new[]
+/// \param[in] _size Number of bytes to allocate
+/// \return The memory
+static void *CountedAllocate(std::size_t _size)
+{
+  ++allocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+/// \brief Free memory for the replaced operator delete and delete[]
+/// \param[in] _ptr The memory
+static void CountedFree(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  return CountedAllocate(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return CountedAllocate(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  CountedFree(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  CountedFree(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  CountedFree(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  CountedFree(_ptr);
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the allocations made by a function
+template <typename Function>
+std::size_t CountAllocations(const Function &_function)
+{
+  const std::size_t before = allocations;
+  _function();
+  return allocations - before;
+}
+
+using SomeSpecializedPluginPtr =
+    gz::plugin::SpecializedPluginPtr<
+        test::util::DummyNameBase,
+        test::util::DummyIntBase>;
+
+/////////////////////////////////////////////////
+TEST(PluginPtr, CopiesDoNotAllocate)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  const gz::plugin::PluginPtr plugin =
+      pl.Instantiate("test::util::DummyMultiPlugin");
+  ASSERT_TRUE(plugin);
+
+  // All the empty PluginPtrs share one wrapper, which gets made by the first
+  // one.
+  gz::plugin::PluginPtr assigned;
+
+  EXPECT_EQ(0u, CountAllocations([&]()
+  {
+    gz::plugin::PluginPtr copy = plugin;
+    assigned = copy;
+    const gz::plugin::ConstPluginPtr constCopy = plugin;
+    EXPECT_EQ(plugin, assigned);
+    EXPECT_TRUE(constCopy);
+  }));
+
+  // The first conversion registers the IDs of the specialized interfaces
+  const SomeSpecializedPluginPtr first = plugin;
+  ASSERT_TRUE(first);
+
+  // A specialized PluginPtr needs a wrapper of its own type, which takes one
+  // allocation for the wrapper and one for its implementation. The slots of
+  // the specialized interfaces live inside of the wrapper.
+  SomeSpecializedPluginPtr specialized;
+  EXPECT_EQ(2u, CountAllocations([&]()
+  {
+    specialized = plugin;
+  }));
+
+  ASSERT_TRUE(specialized);
+  EXPECT_EQ(plugin->QueryInterface<test::util::DummyIntBase>(),
+            specialized->QueryInterface<test::util::DummyIntBase>());
+
+  EXPECT_EQ(0u, CountAllocations([&]()
+  {
+    SomeSpecializedPluginPtr copy = specialized;
+    gz::plugin::PluginPtr generic = specialized;
+    EXPECT_EQ(plugin, generic);
+    EXPECT_NE(nullptr, generic->QueryInterface<test::util::DummyIntBase>());
+  }));
+}
+
+/////////////////////////////////////////////////
+TEST(WeakPluginPtr, LockDoesNotAllocate)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  gz::plugin::PluginPtr plugin =
+      pl.Instantiate("test::util::DummyMultiPlugin");
+  ASSERT_TRUE(plugin);
+
+  const gz::plugin::WeakPluginPtr weak = plugin;
+
+  EXPECT_EQ(0u, CountAllocations([&]()
+  {
+    const gz::plugin::PluginPtr locked = weak.Lock();
+    EXPECT_EQ(plugin, locked);
+  }));
+
+  plugin.Clear();
+  EXPECT_TRUE(weak.IsExpired());
+  EXPECT_FALSE(weak.Lock());
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateAllocations)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  const gz::plugin::Loader::ResolvedPlugin resolved =
+      pl.Resolve("test::util::DummySinglePlugin");
+  ASSERT_TRUE(resolved);
+
+  // The first instance completes the interface table
+  resolved.Instantiate();
+
+  // One allocation for the PluginPtr wrapper, one for its implementation, and
+  // one block which holds the instance together with its reference counts and
+  // library handle.
+  EXPECT_EQ(3u, CountAllocations([&]()
+  {
+    const gz::plugin::PluginPtr plugin = resolved.Instantiate();
+    EXPECT_TRUE(plugin);
+  }));
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateManyAllocations)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  const gz::plugin::Loader::ResolvedPlugin resolved =
+      pl.Resolve("test::util::DummySinglePlugin");
+  ASSERT_TRUE(resolved);
+
+  // The first instance completes the interface table
+  resolved.Instantiate();
+
+  // Each PluginPtr needs its wrapper and the implementation of the wrapper,
+  // while all of the instances share one block.
+  const std::size_t count = 100;
+  std::vector<gz::plugin::PluginPtr> plugins;
+  const std::size_t allocationsForMany = CountAllocations([&]()
+  {
+    plugins = resolved.InstantiateMany(count);
+  });
+  ASSERT_EQ(count, plugins.size());
+  EXPECT_GE(2 * count + 4, allocationsForMany);
+}
+
+namespace test
+{
+namespace allocations
+{
+/// \brief A plugin whose alignment is stricter than what operator new
+/// guarantees
+class alignas(64) OverAlignedPlugin : public util::DummyIntBase
+{
+  public: int MyIntegerValueIs() const override
+  {
+    return this->value;
+  }
+
+  public: int value = 7;
+};
+
+/// \brief Number of instances that were made by the operator new of
+/// OwnOperatorNewPlugin
+static std::size_t ownNewCount = 0;
+
+/// \brief A plugin which has its own operator new
+class OwnOperatorNewPlugin : public util::DummyIntBase
+{
+  public: static void *operator new(std::size_t _size)
+  {
+    ++ownNewCount;
+    return ::operator new(_size);
+  }
+
+  public: static void operator delete(void *_ptr)
+  {
+    ::operator delete(_ptr);
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return 11;
+  }
+};
+}
+}
+
+GZ_ADD_STATIC_PLUGIN(
+    test::allocations::OverAlignedPlugin, test::util::DummyIntBase)
+GZ_ADD_STATIC_PLUGIN(
+    test::allocations::OwnOperatorNewPlugin, test::util::DummyIntBase)
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateOverAligned)
+{
+  gz::plugin::Loader pl;
+
+  std::vector<gz::plugin::PluginPtr> plugins =
+      pl.InstantiateMany("test::allocations::OverAlignedPlugin", 4);
+  for (std::size_t i = 0; i < 4; ++i)
+    plugins.push_back(pl.Instantiate("test::allocations::OverAlignedPlugin"));
+
+  for (const gz::plugin::PluginPtr &plugin : plugins)
+  {
+    ASSERT_TRUE(plugin);
+
+    const test::util::DummyIntBase *base =
+        plugin->QueryInterface<test::util::DummyIntBase>();
+    ASSERT_NE(nullptr, base);
+    EXPECT_EQ(7, base->MyIntegerValueIs());
+
+    const auto *instance =
+        dynamic_cast<const test::allocations::OverAlignedPlugin*>(base);
+    ASSERT_NE(nullptr, instance);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(instance) % 64u);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateWithOwnOperatorNew)
+{
+  gz::plugin::Loader pl;
+
+  const std::size_t before = test::allocations::ownNewCount;
+  const gz::plugin::PluginPtr plugin =
+      pl.Instantiate("test::allocations::OwnOperatorNewPlugin");
+  ASSERT_TRUE(plugin);
+  EXPECT_EQ(before + 1, test::allocations::ownNewCount);
+  EXPECT_EQ(11, plugin->QueryInterface<test::util::DummyIntBase>()
+              ->MyIntegerValueIs());
+
+  // Those instances cannot be placed next to each other
+  const std::vector<gz::plugin::PluginPtr> plugins =
+      pl.InstantiateMany("test::allocations::OwnOperatorNewPlugin", 3);
+  EXPECT_EQ(3u, plugins.size());
+  EXPECT_EQ(before + 4, test::allocations::ownNewCount);
+}
+
+/////////////////////////////////////////////////
+/// \brief Memory resource which keeps track of what it has handed out
+class CountingResource : public std::pmr::memory_resource
+{
+  private: void *do_allocate(std::size_t _bytes, std::size_t _align) override
+  {
+    ++this->allocations;
+    this->outstanding += _bytes;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _align);
+  }
+
+  private: void do_deallocate(
+      void *_ptr, std::size_t _bytes, std::size_t _align) override
+  {
+    this->outstanding -= _bytes;
+    std::pmr::new_delete_resource()->deallocate(_ptr, _bytes, _align);
+  }
+
+  private: bool do_is_equal(
+      const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+
+  /// \brief Number of allocations so far
+  public: std::size_t allocations = 0;
+
+  /// \brief Number of bytes which have not been deallocated yet
+  public: std::size_t outstanding = 0;
+};
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateFromMemoryResource)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  const gz::plugin::Loader::ResolvedPlugin resolved =
+      pl.Resolve("test::util::DummySinglePlugin");
+  ASSERT_TRUE(resolved);
+
+  // The first instance completes the interface table
+  resolved.Instantiate();
+
+  CountingResource resource;
+  {
+    gz::plugin::PluginPtr plugin;
+
+    // Only the implementation of the Plugin wrapper comes from operator new
+    EXPECT_EQ(1u, CountAllocations([&]()
+    {
+      plugin = resolved.Instantiate(&resource);
+    }));
+
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(2u, resource.allocations);
+    EXPECT_LT(0u, resource.outstanding);
+  }
+  EXPECT_EQ(0u, resource.outstanding);
+
+  {
+    gz::plugin::PluginPtr plugin =
+        pl.Instantiate("test::util::DummyMultiPlugin", &resource);
+    ASSERT_TRUE(plugin);
+
+    test::util::DummyIntBase *base =
+        plugin->QueryInterface<test::util::DummyIntBase>();
+    ASSERT_NE(nullptr, base);
+    EXPECT_EQ(5, base->MyIntegerValueIs());
+
+    // The instance stays in the resource for as long as something refers to
+    // one of its interfaces.
+    std::shared_ptr<test::util::DummyIntBase> shared =
+        plugin->QueryInterfaceSharedPtr<test::util::DummyIntBase>();
+    plugin.Clear();
+    EXPECT_LT(0u, resource.outstanding);
+    EXPECT_EQ(5, shared->MyIntegerValueIs());
+  }
+
+  EXPECT_EQ(0u, resource.outstanding);
+
+  // Plugins with their own operator new still get their bookkeeping from the
+  // resource.
+  const std::size_t ownNewBefore = test::allocations::ownNewCount;
+  {
+    const gz::plugin::PluginPtr plugin =
+        pl.Instantiate("test::allocations::OwnOperatorNewPlugin", &resource);
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(ownNewBefore + 1, test::allocations::ownNewCount);
+    EXPECT_LT(0u, resource.outstanding);
+  }
+  EXPECT_EQ(0u, resource.outstanding);
+}
+
+/////////////////////////////////////////////////
+TEST(Loader, InstantiateFromArena)
+{
+  gz::plugin::Loader pl;
+  ASSERT_FALSE(pl.LoadLib(GzDummyPlugins_LIB).empty());
+
+  const gz::plugin::Loader::ResolvedPlugin resolved =
+      pl.Resolve("test::util::DummyMultiPlugin");
+  ASSERT_TRUE(resolved);
+
+  std::pmr::monotonic_buffer_resource arena;
+  for (std::size_t episode = 0; episode < 3; ++episode)
+  {
+    std::vector<gz::plugin::PluginPtr> plugins;
+    for (std::size_t i = 0; i < 100; ++i)
+      plugins.push_back(resolved.Instantiate(&arena));
+
+    for (const gz::plugin::PluginPtr &plugin : plugins)
+    {
+      ASSERT_TRUE(plugin);
+      EXPECT_EQ(5, plugin->QueryInterface<test::util::DummyIntBase>()
+                ->MyIntegerValueIs());
+    }
+
+    plugins.clear();
+    arena.release();
+  }
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/EnablePluginFromThis.hh>
+#include <gz/plugin/Loader.hh>
+#include <gz/plugin/PluginPtr.hh>
+#include <gz/plugin/RegisterStatic.hh>
+
+#include "../plugins/DummyPlugins.hh"
+
+namespace test
+{
+namespace shared
+{
+/// \brief Number of StatelessPlugin instances that were constructed
+static std::atomic<int> constructed{0};
+
+/// \brief Number of StatelessPlugin instances that were destroyed
+static std::atomic<int> destroyed{0};
+
+/// \brief A plugin without any state, which is registered as shared
+class StatelessPlugin
+    : public util::DummyIntBase,
+      public util::DummySetterBase
+{
+  public: StatelessPlugin()
+  {
+    ++constructed;
+  }
+
+  public: ~StatelessPlugin() override
+  {
+    ++destroyed;
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return 23;
+  }
+
+  public: void SetName(const std::string &) override
+  {
+    // Do nothing
+  }
+
+  public: void SetDoubleValue(const double) override
+  {
+    // Do nothing
+  }
+
+  public: void SetIntegerValue(const int) override
+  {
+    // Do nothing
+  }
+};
+
+/// \brief Number of RacedPlugin instances that were constructed
+static std::atomic<int> racedConstructed{0};
+
+/// \brief A shared plugin which is first instantiated by many threads at once
+class RacedPlugin : public util::DummyIntBase
+{
+  public: RacedPlugin()
+  {
+    ++racedConstructed;
+
+    // Give the other threads time to arrive while this one is constructing
+    std::this_thread::yield();
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return 29;
+  }
+};
+
+/// \brief A shared plugin that refers to itself
+class SelfAwarePlugin
+    : public util::DummyIntBase,
+      public gz::plugin::EnablePluginFromThis
+{
+  public: int MyIntegerValueIs() const override
+  {
+    return 31;
+  }
+};
+}
+}
+
+// Only one of the registrations of a plugin needs to mark it as shared
+GZ_ADD_STATIC_PLUGIN_SHARED(
+    test::shared::StatelessPlugin, test::util::DummyIntBase)
+GZ_ADD_STATIC_PLUGIN(
+    test::shared::StatelessPlugin, test::util::DummySetterBase)
+
+GZ_ADD_STATIC_PLUGIN_SHARED(
+    test::shared::RacedPlugin, test::util::DummyIntBase)
+
+GZ_ADD_STATIC_PLUGIN_SHARED(
+    test::shared::SelfAwarePlugin, test::util::DummyIntBase)
+
+using test::shared::constructed;
+using test::shared::destroyed;
+
+/////////////////////////////////////////////////
+TEST(SharedInstance, OneInstance)
+{
+  const std::string name = "test::shared::StatelessPlugin";
+  gz::plugin::Loader pl;
+
+  EXPECT_TRUE(pl.Resolve(name).IsShared());
+  EXPECT_FALSE(gz::plugin::Loader::ResolvedPlugin().IsShared());
+
+  // The marker of a shared plugin is not one of its interfaces
+  EXPECT_TRUE(pl.PluginsImplementing<gz::plugin::SharedInstance>().empty());
+  EXPECT_EQ(0u, pl.InterfacesImplemented().count(
+              "gz::plugin::SharedInstance"));
+
+  gz::plugin::PluginPtr first = pl.Instantiate(name);
+  ASSERT_TRUE(first);
+  EXPECT_FALSE(first->HasInterface<gz::plugin::SharedInstance>());
+  EXPECT_FALSE(first->HasInterface("gz::plugin::SharedInstance"));
+  EXPECT_EQ(nullptr, first->QueryInterface<gz::plugin::SharedInstance>());
+  EXPECT_TRUE(first->HasInterface<test::util::DummySetterBase>());
+  EXPECT_EQ(23,
+    first->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+
+  const int constructedAfterFirst = constructed;
+  EXPECT_EQ(1, constructedAfterFirst);
+
+  gz::plugin::PluginPtr second = pl.Instantiate(name);
+  EXPECT_EQ(first, second);
+
+  // Neither a memory resource nor a pool is used for a shared plugin
+  EXPECT_EQ(first, pl.Instantiate(name, std::pmr::new_delete_resource()));
+  EXPECT_EQ(0u, pl.WarmPool(name, 4));
+  EXPECT_EQ(0u, pl.PoolStatsOf(name).capacity);
+
+  const std::vector<gz::plugin::PluginPtr> many =
+      pl.InstantiateMany(name, 3);
+  ASSERT_EQ(3u, many.size());
+  for (const gz::plugin::PluginPtr &plugin : many)
+    EXPECT_EQ(first, plugin);
+
+  // Static plugins are shared by every Loader
+  gz::plugin::Loader other;
+  EXPECT_EQ(first, other.Resolve(name).Instantiate());
+
+  // Releasing every PluginPtr does not destroy the instance
+  first.Clear();
+  second.Clear();
+  EXPECT_EQ(0, destroyed);
+  EXPECT_EQ(23, pl.Instantiate(name)
+            ->QueryInterface<test::util::DummyIntBase>()->MyIntegerValueIs());
+  EXPECT_EQ(constructedAfterFirst, constructed);
+}
+
+/////////////////////////////////////////////////
+TEST(SharedInstance, ConcurrentFirstUse)
+{
+  const std::string name = "test::shared::RacedPlugin";
+  gz::plugin::Loader pl;
+  const gz::plugin::Loader::ResolvedPlugin resolved = pl.Resolve(name);
+  ASSERT_TRUE(resolved);
+
+  const int threads = 8;
+  std::atomic<int> waiting{threads};
+  std::vector<gz::plugin::PluginPtr> plugins(threads);
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&, t]()
+    {
+      --waiting;
+      while (waiting > 0)
+        std::this_thread::yield();
+
+      plugins[t] = resolved.Instantiate();
+    });
+  }
+
+  for (std::thread &worker : workers)
+    worker.join();
+
+  EXPECT_EQ(1, test::shared::racedConstructed);
+  for (const gz::plugin::PluginPtr &plugin : plugins)
+  {
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(plugins.front(), plugin);
+    EXPECT_EQ(29, plugin->QueryInterface<test::util::DummyIntBase>()
+              ->MyIntegerValueIs());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SharedInstance, EnablePluginFromThis)
+{
+  const std::string name = "test::shared::SelfAwarePlugin";
+  gz::plugin::Loader pl;
+
+  gz::plugin::PluginPtr first = pl.Instantiate(name);
+  ASSERT_TRUE(first);
+  first.Clear();
+
+  // The instance can still find itself after the PluginPtr that was made
+  // along with it is gone.
+  gz::plugin::PluginPtr second = pl.Instantiate(name);
+  ASSERT_TRUE(second);
+  auto *fromThis = second->QueryInterface<gz::plugin::EnablePluginFromThis>();
+  ASSERT_NE(nullptr, fromThis);
+  EXPECT_EQ(second, fromThis->PluginFromThis());
+}
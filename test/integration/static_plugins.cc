@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <gz/plugin/Loader.hh>
+#include <gz/plugin/detail/StaticRegistry.hh>
 
 #include "../plugins/DummyPlugins.hh"
 
@@ -54,3 +55,18 @@ TEST(StaticPlugins, Instantiate)
       pluginInstance->QueryInterface<test::util::DummyNameBase>();
   EXPECT_EQ(dummySinglePluginInterface->MyNameIs(), "DummySinglePlugin");
 }
+
+TEST(StaticPlugins, SharedInfo)
+{
+  gz::plugin::StaticRegistry &registry =
+      gz::plugin::StaticRegistry::GetInstance();
+
+  // Each lookup hands out the same Info instead of a new copy
+  gz::plugin::ConstInfoPtr info =
+      registry.GetInfo("test::util::DummySinglePlugin");
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(info, registry.GetInfo("test::util::DummySinglePlugin"));
+
+  // The Info that was merged from several registration macros is complete
+  EXPECT_EQ(3u, info->aliases.size());
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+
+/////////////////////////////////////////////////
+/// \brief Instantiate a plugin on several threads at once and return the
+/// number of instantiations per millisecond.
+/// \param[in] _loader The loader to instantiate from
+/// \param[in] _numThreads The number of threads to use
+/// \param[in] _globalMutex If not a nullptr, every instantiation is done while
+/// holding this mutex, like an application would need to do if the Loader were
+/// not thread-safe.
+double Throughput(const gz::plugin::Loader &_loader,
+                  const std::size_t _numThreads,
+                  std::mutex *_globalMutex)
+{
+  const std::size_t perThread = 20000;
+
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < _numThreads; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      for (std::size_t j = 0; j < perThread; ++j)
+      {
+        gz::plugin::PluginPtr plugin;
+        if (_globalMutex)
+        {
+          std::lock_guard<std::mutex> lock(*_globalMutex);
+          plugin = _loader.Instantiate("test::util::DummySinglePlugin");
+        }
+        else
+        {
+          plugin = _loader.Instantiate("test::util::DummySinglePlugin");
+        }
+        EXPECT_TRUE(plugin);
+      }
+    });
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+  const auto finish = std::chrono::steady_clock::now();
+
+  return static_cast<double>(_numThreads * perThread)
+      / std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentInstantiate, ThroughputVersusThreads)
+{
+  gz::plugin::Loader loader;
+  ASSERT_FALSE(loader.LoadLib(GzDummyPlugin_LIB).empty());
+
+  const std::size_t maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- Instantiate throughput (instances per ms) ---\n"
+            << std::setw(8) << "threads"
+            << std::setw(16) << "global mutex"
+            << std::setw(16) << "concurrent" << "\n";
+
+  std::mutex globalMutex;
+  for (std::size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    const double serialized = Throughput(loader, numThreads, &globalMutex);
+    const double concurrent = Throughput(loader, numThreads, nullptr);
+
+    std::cout << std::setw(8) << numThreads
+              << std::setw(16) << serialized
+              << std::setw(16) << concurrent << "\n";
+  }
+
+  std::cout << std::endl;
+}
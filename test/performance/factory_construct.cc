@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+
+#include "../plugins/FactoryPlugins.hh"
+
+using namespace test::util;
+
+/////////////////////////////////////////////////
+/// \brief Construct and destroy products of a factory on several threads at
+/// once and return the number of products per millisecond.
+/// \param[in] _factory The factory to construct the products with
+/// \param[in] _numThreads The number of threads to use
+double Throughput(const gz::plugin::PluginPtr &_factory,
+                  const std::size_t _numThreads)
+{
+  const std::size_t perThread = 100000;
+
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < _numThreads; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      IntFactory *factory = _factory->QueryInterface<IntFactory>();
+      std::size_t failures = 0;
+      for (std::size_t j = 0; j < perThread; ++j)
+      {
+        const int value = static_cast<int>(j);
+        auto product = factory->Construct(static_cast<int>(j));
+        if (!product || product->MyIntegerValueIs() != value)
+          ++failures;
+      }
+      EXPECT_EQ(0u, failures);
+    });
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+  const auto finish = std::chrono::steady_clock::now();
+
+  return static_cast<double>(_numThreads * perThread)
+      / std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+/////////////////////////////////////////////////
+TEST(FactoryConstruct, ThroughputVersusThreads)
+{
+  gz::plugin::Loader loader;
+  ASSERT_FALSE(loader.LoadLib(GzFactoryPlugins_LIB).empty());
+
+  // Every thread constructs from the same factory, so they all share the
+  // lifetime token of that factory.
+  gz::plugin::PluginPtr factory =
+      loader.Instantiate("test::util::DummyIntForward");
+  ASSERT_TRUE(factory);
+  ASSERT_TRUE(factory->HasInterface<IntFactory>());
+
+  const std::size_t maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- Factory::Construct throughput (products per ms) ---\n"
+            << std::setw(8) << "threads"
+            << std::setw(16) << "products" << "\n";
+
+  for (std::size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    std::cout << std::setw(8) << numThreads
+              << std::setw(16) << Throughput(factory, numThreads) << "\n";
+  }
+
+  std::cout << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(FactoryConstruct, LookUpFactoryPerProduct)
+{
+  gz::plugin::Loader loader;
+  ASSERT_FALSE(loader.LoadLib(GzFactoryPlugins_LIB).empty());
+
+  // This is the pattern that the documentation of Loader::Factory suggests,
+  // which looks up the factory again for every product.
+  const std::size_t count = 100000;
+  std::size_t failures = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto product = loader.Factory<IntFactory>("test::util::DummyIntForward")
+        ->Construct(static_cast<int>(i));
+    if (!product)
+      ++failures;
+  }
+  const auto finish = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(0u, failures);
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- Loader::Factory + Construct (products per ms) ---\n"
+            << std::setw(16)
+            << static_cast<double>(count)
+               / std::chrono::duration<double, std::milli>(
+                   finish - start).count()
+            << "\n" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(FactoryConstruct, LostProductsVersusThreads)
+{
+  gz::plugin::Loader loader;
+  ASSERT_FALSE(loader.LoadLib(GzFactoryPlugins_LIB).empty());
+
+  gz::plugin::PluginPtr factory =
+      loader.Instantiate("test::util::DummyIntForward");
+  ASSERT_TRUE(factory);
+
+  const std::size_t maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t perThread = 50000;
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- Lost products with a reaper (products per ms) ---\n"
+            << std::setw(8) << "threads"
+            << std::setw(16) << "products"
+            << std::setw(20) << "max latency (us)" << "\n";
+
+  // Products which are not deleted by a ProductDeleter hand their factory
+  // reference off to the lost product queue, while the reaper drains it.
+  gz::plugin::StartLostProductReaper(std::chrono::microseconds(100), {});
+
+  for (std::size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numThreads; ++i)
+    {
+      threads.emplace_back([&]()
+      {
+        IntFactory *intFactory = factory->QueryInterface<IntFactory>();
+        for (std::size_t j = 0; j < perThread; ++j)
+          delete intFactory->Construct(static_cast<int>(j)).release();
+      });
+    }
+
+    for (std::thread &thread : threads)
+      thread.join();
+    const auto finish = std::chrono::steady_clock::now();
+
+    std::cout << std::setw(8) << numThreads
+              << std::setw(16)
+              << static_cast<double>(numThreads * perThread)
+                 / std::chrono::duration<double, std::milli>(
+                     finish - start).count()
+              << std::setw(20)
+              << std::chrono::duration<double, std::micro>(
+                   gz::plugin::LostProductStatistics().maxReclaimLatency)
+                 .count()
+              << "\n";
+  }
+
+  gz::plugin::StopLostProductReaper();
+  gz::plugin::CleanupLostProducts();
+  EXPECT_EQ(0u, gz::plugin::LostProductCount());
+
+  std::cout << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(FactoryConstruct, BatchesAndRecycling)
+{
+  gz::plugin::Loader loader;
+  ASSERT_FALSE(loader.LoadLib(GzFactoryPlugins_LIB).empty());
+
+  gz::plugin::PluginPtr plugin =
+      loader.Instantiate("test::util::DummyIntForward");
+  ASSERT_TRUE(plugin);
+  IntFactory *factory = plugin->QueryInterface<IntFactory>();
+  ASSERT_NE(nullptr, factory);
+
+  // Products are made and destroyed in batches, like a spawner would
+  const std::size_t batches = 1000;
+  const std::size_t batchSize = 100;
+
+  const auto measure = [&](const bool _many)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < batches; ++i)
+    {
+      std::vector<IntFactory::ProductPtrType> products;
+      if (_many)
+      {
+        products = factory->ConstructMany(batchSize, static_cast<int>(i));
+      }
+      else
+      {
+        products.reserve(batchSize);
+        for (std::size_t j = 0; j < batchSize; ++j)
+          products.push_back(factory->Construct(static_cast<int>(i)));
+      }
+      EXPECT_EQ(batchSize, products.size());
+    }
+    const auto finish = std::chrono::steady_clock::now();
+
+    return static_cast<double>(batches * batchSize)
+        / std::chrono::duration<double, std::milli>(finish - start).count();
+  };
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- Batches of " << batchSize << " products (products per ms)"
+            << " ---\n"
+            << std::setw(12) << "recycling"
+            << std::setw(16) << "Construct"
+            << std::setw(16) << "ConstructMany" << "\n";
+
+  for (const bool recycling : {false, true})
+  {
+    factory->RecycleProducts(recycling ? batchSize : 0);
+    const double single = measure(false);
+    const double many = measure(true);
+
+    std::cout << std::setw(12) << (recycling ? "on" : "off")
+              << std::setw(16) << single
+              << std::setw(16) << many << "\n";
+  }
+
+  factory->RecycleProducts(0);
+  std::cout << std::endl;
+}
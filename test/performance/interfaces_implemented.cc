@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/Registry.hh>
+
+using gz::plugin::ConstInfoPtr;
+using gz::plugin::Info;
+using gz::plugin::Registry;
+
+/////////////////////////////////////////////////
+/// \brief Compute the result of InterfacesImplemented() by walking every
+/// plugin of the registry, which is how it used to be done.
+std::unordered_set<std::string> WalkPlugins(const Registry &_registry)
+{
+  std::unordered_set<std::string> interfaces;
+  for (const std::string &name : _registry.AllPlugins())
+  {
+    const ConstInfoPtr plugin = _registry.GetInfo(name);
+    for (const std::string &interface : plugin->demangledInterfaces)
+      interfaces.insert(interface);
+  }
+  return interfaces;
+}
+
+/////////////////////////////////////////////////
+TEST(InterfacesImplemented, IndexVersusWalkingPlugins)
+{
+  const std::size_t NumPlugins = 10000;
+  const std::size_t NumInterfaces = 50;
+  const std::size_t InterfacesPerPlugin = 4;
+
+  // The plugins are added in a single update, because every separate
+  // AddInfo(~) would make a new copy of the registry.
+  Registry registry;
+  registry.Update([&](Registry::Snapshot &_plugins)
+  {
+    for (std::size_t i = 0; i < NumPlugins; ++i)
+    {
+      auto info = std::make_shared<Info>();
+      info->name = "test::performance::Plugin" + std::to_string(i);
+      for (std::size_t j = 0; j < InterfacesPerPlugin; ++j)
+      {
+        const std::string interface = "test::performance::Interface"
+            + std::to_string((i + j * 7) % NumInterfaces);
+        info->interfaces.insert({interface, [](void *_ptr) { return _ptr; }});
+        info->demangledInterfaces.insert(interface);
+      }
+      EXPECT_TRUE(_plugins.AddInfo(std::move(info)));
+    }
+  });
+
+  ASSERT_EQ(WalkPlugins(registry), registry.InterfacesImplemented());
+  ASSERT_EQ(NumInterfaces, registry.InterfacesImplemented().size());
+
+  const std::size_t NumTrials = 20;
+
+  double walkTotal = 0.0;
+  double indexTotal = 0.0;
+  std::size_t sink = 0;
+  for (std::size_t trial = 0; trial < NumTrials; ++trial)
+  {
+    const auto walkStart = std::chrono::steady_clock::now();
+    sink += WalkPlugins(registry).size();
+    const auto walkFinish = std::chrono::steady_clock::now();
+
+    const auto indexStart = std::chrono::steady_clock::now();
+    sink += registry.InterfacesImplemented().size();
+    const auto indexFinish = std::chrono::steady_clock::now();
+
+    walkTotal += std::chrono::duration<double, std::micro>(
+          walkFinish - walkStart).count();
+    indexTotal += std::chrono::duration<double, std::micro>(
+          indexFinish - indexStart).count();
+  }
+
+  EXPECT_EQ(2 * NumTrials * NumInterfaces, sink);
+
+  std::cout << std::fixed << std::setprecision(1)
+            << " --- InterfacesImplemented() with " << NumPlugins
+            << " plugins (average of " << NumTrials << " trials) ---\n"
+            << std::setw(24) << "Walking every plugin: "
+            << walkTotal / NumTrials << " us\n"
+            << std::setw(24) << "Interface index: "
+            << indexTotal / NumTrials << " us\n"
+            << std::endl;
+
+  EXPECT_LT(indexTotal, walkTotal);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+
+namespace fs = std::filesystem;
+
+/////////////////////////////////////////////////
+/// \brief Make a batch of distinct library files by copying the test plugin
+/// libraries. The dynamic linker treats each copy as a separate library, so
+/// every copy has to be mapped, relocated and initialized on its own.
+std::vector<std::string> MakeLibraryCopies(
+    const fs::path &_directory, const std::size_t _copiesPerLibrary)
+{
+  const std::vector<fs::path> originals = {
+    GzDummyPlugin_LIB,
+    GzFactoryPlugins_LIB,
+    GzTemplatedPlugins_LIB};
+
+  std::vector<std::string> copies;
+  for (std::size_t i = 0; i < _copiesPerLibrary; ++i)
+  {
+    for (const fs::path &original : originals)
+    {
+      const fs::path copy = _directory /
+          (original.stem().string() + "_" + std::to_string(i)
+           + original.extension().string());
+      fs::copy_file(original, copy, fs::copy_options::overwrite_existing);
+      copies.push_back(copy.string());
+    }
+  }
+
+  return copies;
+}
+
+/////////////////////////////////////////////////
+TEST(LoadLibs, BatchVersusSerial)
+{
+  const fs::path directory =
+      fs::temp_directory_path() / "gz_plugin_load_libs_performance";
+  fs::create_directories(directory);
+
+  const std::vector<std::string> libraries =
+      MakeLibraryCopies(directory, 100);
+
+  struct TestData
+  {
+    std::string label;
+    double total;
+
+    explicit TestData(const std::string &_label)
+      : label(_label), total(0.0) { }
+  };
+
+  TestData serial("Serial LoadLib loop");
+  TestData batch("LoadLibs batch");
+
+  const std::size_t NumTrials = 5;
+  const std::size_t Warmup = 1;
+
+  for (std::size_t i = 0; i < Warmup + NumTrials; ++i)
+  {
+    std::set<std::string> serialPlugins;
+    std::set<std::string> batchPlugins;
+
+    // Each loader goes out of scope at the end of its block, which unloads
+    // all of the libraries again before the next measurement.
+    {
+      gz::plugin::Loader loader;
+      const auto start = std::chrono::steady_clock::now();
+      for (const std::string &library : libraries)
+        loader.LoadLib(library);
+      const auto finish = std::chrono::steady_clock::now();
+
+      if (i >= Warmup)
+      {
+        serial.total += std::chrono::duration<double, std::milli>(
+              finish - start).count();
+      }
+      serialPlugins = loader.AllPlugins();
+    }
+
+    {
+      gz::plugin::Loader loader;
+      const auto start = std::chrono::steady_clock::now();
+      loader.LoadLibs(libraries);
+      const auto finish = std::chrono::steady_clock::now();
+
+      if (i >= Warmup)
+      {
+        batch.total += std::chrono::duration<double, std::milli>(
+              finish - start).count();
+      }
+      batchPlugins = loader.AllPlugins();
+    }
+
+    EXPECT_FALSE(serialPlugins.empty());
+    EXPECT_EQ(serialPlugins, batchPlugins);
+  }
+
+  for (const TestData *test : {&serial, &batch})
+  {
+    std::cout << std::fixed;
+    std::cout << std::setprecision(3);
+    std::cout << std::right;
+
+    std::cout << " --- " << test->label << " (" << libraries.size()
+              << " libraries) result ---\n"
+              << "Avg time: " << std::setw(11) << std::right
+              << test->total/static_cast<double>(NumTrials)
+              << "ms\n" << std::endl;
+  }
+
+  fs::remove_all(directory);
+}
@@ -105,14 +105,15 @@ using Specialize20Types_Trailing =
         test::util::DummySetterBase>;
 
 
-template <typename PluginType>
+template <typename Interface = test::util::DummySetterBase,
+          typename PluginType>
 double RunPerformanceTest(const PluginType &plugin)
 {
   const std::size_t NumTests = 10000;
   const auto start = std::chrono::high_resolution_clock::now();
   for (std::size_t i = 0; i < NumTests; ++i)
   {
-    plugin->template QueryInterface<test::util::DummySetterBase>();
+    plugin->template QueryInterface<Interface>();
   }
   const auto finish = std::chrono::high_resolution_clock::now();
 
@@ -160,6 +161,7 @@ TEST(PluginSpecialization, AccessTime)
   tests.push_back(TestData("10 specializations (trailing)"));
   tests.push_back(TestData("20 specializations (leading)"));
   tests.push_back(TestData("20 specializations (trailing)"));
+  tests.push_back(TestData("No specialization (missing interface)"));
   tests.push_back(TestData("No specialization"));
 
   const std::size_t NumTrials = 1000;
@@ -175,6 +177,7 @@ TEST(PluginSpecialization, AccessTime)
     tests[t++].avg += RunPerformanceTest(spec_10_trailing);
     tests[t++].avg += RunPerformanceTest(spec_20_leading);
     tests[t++].avg += RunPerformanceTest(spec_20_trailing);
+    tests[t++].avg += RunPerformanceTest<Interface1>(plugin);
     tests[t++].avg += RunPerformanceTest(plugin);
 
     // Note that whichever test is listed first in the for-loop will have the
@@ -217,6 +220,8 @@ TEST(PluginSpecialization, AccessTime)
     std::cout << " --- " << test.label << " result ---\n"
               << "Avg time: " << std::setw(11) << std::right
               << test.avg/static_cast<double>(NumTrials)
-              << "ns\n" << std::endl;
+              << "ns\n"
+              << "Relative to 1 specialization: " << std::setprecision(2)
+              << test.avg/tests[0].avg << "x\n" << std::endl;
   }
 }
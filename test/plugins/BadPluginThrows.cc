@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <stdexcept>
+
+#include <gz/plugin/Info.hh>
+
+#include "GenericExport.hh"
+
+extern "C" void EXPORT GzPluginHook(
+    const void *,
+    const void ** const,
+    int *,
+    std::size_t *,
+    std::size_t *)
+{
+  throw std::runtime_error("GzBadPluginThrows cannot be queried");
+}
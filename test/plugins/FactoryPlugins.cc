@@ -15,9 +15,32 @@
  *
 */
 
+#include <string>
+
 #include <gz/plugin/Register.hh>
 
 #include "FactoryPlugins.hh"
+#include "GenericExport.hh"
+
+namespace
+{
+/// \brief Number of times that CountedAlias() has been called
+int aliasEvaluations = 0;
+
+/// \brief Pass on an alias while counting how often the aliases of this
+/// library get evaluated.
+std::string CountedAlias(const std::string &_alias)
+{
+  ++aliasEvaluations;
+  return _alias;
+}
+}
+
+/// \brief Lets the tests check when the registrations of this library run
+extern "C" int EXPORT GzFactoryPluginsAliasEvaluations()
+{
+  return aliasEvaluations;
+}
 
 namespace test
 {
@@ -172,5 +195,9 @@ GZ_ADD_FACTORY_ALIAS(
     SomeObjectAddTwo, SomeObjectFactory,
     "This factory has an alias", "and also a second alias")
 
+GZ_ADD_PLUGIN_ALIAS(
+    SomeObjectFactory::Producing<SomeObjectForward>,
+    CountedAlias("This factory has a counted alias"))
+
 }
 }
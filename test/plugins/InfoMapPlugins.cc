@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <utility>
+
+#include <gz/plugin/Info.hh>
+#include <gz/plugin/detail/Common.hh>
+
+#include "DummyPlugins.hh"
+#include "FactoryPlugins.hh"
+#include "GenericExport.hh"
+
+namespace test
+{
+namespace util
+{
+/// \brief A plugin of a library that only provides version 1 of the Info
+/// API, like the libraries that were built before version 2.
+class InfoMapPlugin : public DummyIntBase, public DummyNameBase
+{
+  public: int MyIntegerValueIs() const override
+  {
+    return 11;
+  }
+
+  public: std::string MyNameIs() const override
+  {
+    return "InfoMapPlugin";
+  }
+};
+
+/// \brief A product of a factory of a library that only provides version 1
+/// of the Info API
+class InfoMapProduct : public DummyIntBase
+{
+  public: explicit InfoMapProduct(const int _value)
+    : value(_value)
+  {
+    // Do nothing
+  }
+
+  public: int MyIntegerValueIs() const override
+  {
+    return this->value;
+  }
+
+  private: int value;
+};
+}
+}
+
+// This is what GzPluginHook looked like in version 1 of the Info API.
+extern "C" void EXPORT GzPluginHook(
+    const void *,
+    const void ** const _outputAllInfo,
+    int *_inputAndOutputAPIVersion,
+    std::size_t *_inputAndOutputInfoSize,
+    std::size_t *_inputAndOutputInfoAlign)
+{
+  static const gz::plugin::InfoMap pluginMap = []()
+  {
+    gz::plugin::Info info = gz::plugin::detail::MakeInfo<
+        test::util::InfoMapPlugin,
+        test::util::DummyIntBase,
+        test::util::DummyNameBase>();
+    info.aliases.insert("InfoMapAlias");
+
+    gz::plugin::Info factory = gz::plugin::detail::MakeInfo<
+        test::util::IntFactory::Producing<test::util::InfoMapProduct>,
+        test::util::IntFactory>();
+
+    gz::plugin::InfoMap map;
+    map.insert(std::make_pair(info.name, std::move(info)));
+    map.insert(std::make_pair(factory.name, std::move(factory)));
+    return map;
+  }();
+
+  const bool agreement =
+      gz::plugin::INFO_MAP_API_VERSION == *_inputAndOutputAPIVersion &&
+      sizeof(gz::plugin::Info) == *_inputAndOutputInfoSize &&
+      alignof(gz::plugin::Info) == *_inputAndOutputInfoAlign;
+
+  *_inputAndOutputAPIVersion = gz::plugin::INFO_MAP_API_VERSION;
+  *_inputAndOutputInfoSize = sizeof(gz::plugin::Info);
+  *_inputAndOutputInfoAlign = alignof(gz::plugin::Info);
+
+  if (agreement)
+    *_outputAllInfo = &pluginMap;
+}